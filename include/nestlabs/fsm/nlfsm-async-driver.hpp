@@ -0,0 +1,206 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an event handler/driver for a finite state
+ *      machine (FSM) whose delegate methods may complete
+ *      asynchronously.
+ *
+ */
+
+#ifndef NLFSM_ASYNC_DRIVER_HPP
+#define NLFSM_ASYNC_DRIVER_HPP
+
+#include <stddef.h>
+
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-state-delegate-async.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicAsyncDriver
+         *
+         *  @brief
+         *    This class defines an object for handling/driving input
+         *    excitation events for a finite state machine (FSM) whose
+         *    delegate methods may complete asynchronously.
+         *
+         *  Events are handled as by BasicDriver, except that any
+         *  delegate method may return Delegate::kResultPending, for
+         *  example to wait on I/O, whereupon the in-flight event is
+         *  suspended at that point and #HandleEvent returns without
+         *  blocking. Once the delegate method's result is known, the
+         *  event is resumed with #Resume, which carries on from where
+         *  it left off.
+         *
+         *  The progress of the in-flight event is kept in the driver
+         *  as an explicit step, so a suspended event holds no thread
+         *  or stack, and any number of machines, each with its own
+         *  driver, may have events suspended at once.
+         *
+         *  Events arriving while an event is in flight are queued, in
+         *  caller-provided storage, behind it and handled, in order,
+         *  once it completes.
+         *
+         *  An event deferred in the state it is handled in is pushed
+         *  onto the machine's deferral queue, as by BasicDriver, and
+         *  the queue is recalled once an event completes with a
+         *  change of state, ahead of any events still queued behind
+         *  it. Recalled events are handled like any other, so may
+         *  themselves suspend, with the rest of the recall resuming
+         *  once they complete.
+         *
+         *  The output event of each transition taken, if the machine
+         *  has outputs, is passed to the driver's output sink, if
+         *  any, once the event completes; a sink not accepting it
+         *  fails the event.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicAsyncDriver
+        {
+        public:
+            typedef StateType                                   State;
+            typedef EventType                                   Event;
+            typedef BasicTransition<StateType, EventType>       Transition;
+            typedef BasicMachine<StateType, EventType>          Machine;
+            typedef Delegate::BasicAsync<StateType, EventType>  Async;
+
+            /**
+             *  A function called with the output event of each
+             *  transition taken and the context of the output sink,
+             *  returning false if the output could not be accepted.
+             */
+            typedef bool (*OutputFunction)(const Event &inOutput,
+                                           void *inContext);
+
+            /**
+             *  The outcome of handling or resuming an event.
+             */
+            enum Status
+            {
+                kStatusFailed    = 0,   //!< The event was not handled
+                                        //!< or was vetoed.
+                kStatusHandled   = 1,   //!< The event was handled.
+                kStatusSuspended = 2,   //!< The event is in flight,
+                                        //!< awaiting #Resume.
+                kStatusQueued    = 3    //!< The event is queued behind
+                                        //!< the in-flight event or
+                                        //!< deferred.
+            };
+
+            // Con/destructor(s)
+            BasicAsyncDriver(Machine &inMachine,
+                             Async *inDelegate);
+
+            bool SetQueue(Event ioQueue[], size_t inSize);
+            size_t GetQueuedCount(void) const;
+            bool IsSuspended(void) const;
+
+            void SetOutputSink(OutputFunction inFunction,
+                               void *inContext);
+
+            Status HandleEvent(const Event &inEvent);
+            Status Resume(Delegate::Result inResult);
+
+        private:
+            /**
+             *  The steps of handling an event, each a delegate method
+             *  preceded by any machine handler or action, and then
+             *  passing on the transition's output.
+             */
+            enum Step
+            {
+                kStepWillHandleEvent,
+                kStepWillExitState,
+                kStepDidExitState,
+                kStepWillTransition,
+                kStepDidTransition,
+                kStepWillEnterState,
+                kStepDidEnterState,
+                kStepDidHandleEvent,
+                kStepEmit,
+                kStepDone
+            };
+
+            Status Begin(const Event &inEvent);
+            Status Run(void);
+            Delegate::Result Perform(Step inStep);
+            void Drain(void);
+
+        private:
+            Machine *                  mMachine;          //!< The machine to
+                                                          //!< drive.
+            Async *                    mDelegate;         //!< The delegate.
+            const Transition *         mTransition;       //!< The in-flight
+                                                          //!< transition, if
+                                                          //!< any.
+            Event                      mEvent;            //!< The in-flight
+                                                          //!< event.
+            State                      mState;            //!< The state in
+                                                          //!< which the
+                                                          //!< in-flight event
+                                                          //!< arrived.
+            bool                       mInternal;         //!< Whether the
+                                                          //!< in-flight
+                                                          //!< transition is
+                                                          //!< internal.
+            Step                       mStep;             //!< The next step of
+                                                          //!< the in-flight
+                                                          //!< event.
+            Event *                    mQueue;            //!< The queue of
+                                                          //!< events behind
+                                                          //!< the in-flight
+                                                          //!< event, if any.
+            size_t                     mQueueSize;        //!< The number of
+                                                          //!< entries in the
+                                                          //!< queue.
+            size_t                     mQueueHead;        //!< The oldest
+                                                          //!< queued event.
+            size_t                     mQueueCount;       //!< The number of
+                                                          //!< queued events.
+            size_t                     mRecallCount;      //!< The number of
+                                                          //!< deferred events
+                                                          //!< left to recall.
+            OutputFunction             mOutputFunction;   //!< The output
+                                                          //!< sink function,
+                                                          //!< if any.
+            void *                     mOutputContext;    //!< The output
+                                                          //!< sink context.
+        };
+
+        /**
+         *  An asynchronous finite state machine (FSM) driver with the
+         *  default, eight-bit state and event identifiers.
+         */
+        typedef BasicAsyncDriver<State, Event> AsyncDriver;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_ASYNC_DRIVER_HPP
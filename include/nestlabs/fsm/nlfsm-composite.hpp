@@ -0,0 +1,115 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for dispatching each event to
+ *      several concurrent, orthogonal finite state machine (FSM)
+ *      regions.
+ *
+ */
+
+#ifndef NLFSM_COMPOSITE_HPP
+#define NLFSM_COMPOSITE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicComposite
+         *
+         *  @brief
+         *    This class defines an object for dispatching each event
+         *    to every one of several orthogonal regions, each a
+         *    finite state machine (FSM) with its own current state,
+         *    through a single, shared driver.
+         *
+         *  The composite may be given caller-allocated storage for a
+         *  per-region bitmap of the events with a transition out of
+         *  any state of that region. When present, regions that never
+         *  handle an event are skipped with a single bit test, before
+         *  the driver is even pointed at them.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicComposite
+        {
+        public:
+            typedef StateType                                 State;
+            typedef EventType                                 Event;
+            typedef BasicMachine<StateType, EventType>        Machine;
+            typedef BasicDriver<StateType, EventType>         Driver;
+            typedef typename Machine::Mask                    Mask;
+
+            // Con/destructor(s)
+            BasicComposite(Machine *inRegions[],
+                           size_t inCount,
+                           Driver &inDriver);
+
+            size_t GetRegionCount(void) const;
+            Machine *GetRegion(size_t inRegion) const;
+
+            size_t GetAcceptedEventsSize(void) const;
+            bool SetAcceptedEvents(Mask inBitmap[], size_t inSize);
+            void ClearAcceptedEvents(void);
+            bool IsEventAccepted(size_t inRegion,
+                                 const Event &inEvent) const;
+
+            bool HandleEvent(const Event &inEvent);
+            bool HandleEvent(const Event &inEvent,
+                             size_t &outHandled);
+
+        private:
+            Machine **                 mRegions;          //!< The regions.
+            size_t                     mCount;            //!< The number of
+                                                          //!< regions.
+            Driver *                   mDriver;           //!< The driver
+                                                          //!< shared by the
+                                                          //!< regions.
+            const Mask *               mAcceptedEvents;   //!< The per-region
+                                                          //!< accepted-event
+                                                          //!< bitmap, if any.
+            size_t                     mAcceptedWords;    //!< The number of
+                                                          //!< words per
+                                                          //!< region (i.e.,
+                                                          //!< row) in the
+                                                          //!< bitmap.
+        };
+
+        /**
+         *  A finite state machine (FSM) composite with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicComposite<State, Event> Composite;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_COMPOSITE_HPP
@@ -79,6 +79,7 @@
 #define NLFSM_DRIVER_HPP
 
 #include <nestlabs/fsm/nlfsm-state-delegate-base.hpp>
+#include <nestlabs/fsm/nlfsm-state-delegate-constant.hpp>
 #include <nestlabs/fsm/nlfsm-event.hpp>
 #include <nestlabs/fsm/nlfsm-machine.hpp>
 #include <nestlabs/fsm/nlfsm-transition.hpp>
@@ -89,26 +90,60 @@ namespace nl {
 
         /**
          *
-         *  @class Driver
+         *  @class BasicDriver
          *
          *  @brief
          *    This class defines an object for handling/driving input
          *    excitation events for a finite state machine (FSM).
          *
+         *  An event deferred in the current state by the machine is
+         *  queued in the machine's deferral queue rather than handled
+         *  and, after each change of state, the queued events are
+         *  recalled, oldest first, and handled in the new state.
+         *
+         *  The output event of each transition taken, if the machine
+         *  has outputs, is passed to the driver's output sink, if
+         *  any, such as the input queue of the next machine in a
+         *  pipeline.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
          */
-        class Driver
+        template <typename StateType, typename EventType>
+        class BasicDriver
         {
         public:
+            typedef StateType                                   State;
+            typedef EventType                                   Event;
+            typedef BasicTransition<StateType, EventType>       Transition;
+            typedef BasicMachine<StateType, EventType>          Machine;
+            typedef Delegate::BasicBase<StateType, EventType>   Base;
+
+            /**
+             *  A function called with the output event of each
+             *  transition taken and the context of the output sink,
+             *  returning false if the output could not be accepted.
+             */
+            typedef bool (*OutputFunction)(const Event &inOutput,
+                                           void *inContext);
+
             // Con/destructor(s)
-            Driver(void);
-            Driver(Machine &inMachine,
-                   Delegate::Base *inDelegate);
+            BasicDriver(void);
+            BasicDriver(Machine &inMachine,
+                        Base *inDelegate);
+            BasicDriver(Machine &inMachine,
+                        Delegate::Constant inConstant);
 
             void SetMachine(Machine &inMachine);
             Machine *GetMachine();
 
-            void SetDelegate(Delegate::Base *inDelegate);
-            Delegate::Base *GetDelegate();
+            void SetDelegate(Base *inDelegate);
+            void SetDelegate(Delegate::Constant inConstant);
+            Base *GetDelegate();
+
+            void SetOutputSink(OutputFunction inFunction,
+                               void *inContext);
 
             bool HandleEvent(const Event &inEvent);
             bool HandleEvent(const Event &inEvent,
@@ -116,12 +151,38 @@ namespace nl {
             bool HandleEvent(const Event &inEvent,
                              const State &inCurrentState,
                              const Transition &inTransition);
+            size_t HandleEvents(const Event inEvents[],
+                                size_t inCount);
 
         private:
+            void Recall(void);
+            bool Emit(const Transition &inTransition);
+
+        private:
+            /**
+             *  How delegate methods are dispatched for handled events.
+             */
+            enum Dispatch
+            {
+                kDispatchDelegate,  //!< Call the delegate object.
+                kDispatchAlways,    //!< Elide calls; all return true.
+                kDispatchNever      //!< Elide calls; all return false.
+            };
+
             Machine *mMachine;
-            Delegate::Base *mDelegate;
+            Base *mDelegate;
+            Dispatch mDispatch;
+            bool mRecalling;
+            OutputFunction mOutputFunction;
+            void *mOutputContext;
         };
 
+        /**
+         *  A finite state machine (FSM) driver with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicDriver<State, Event> Driver;
+
     }; // namespace Fsm
 
 }; // namespace nl
@@ -0,0 +1,189 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for feeding finite state machines
+ *      (FSMs) events read from file descriptors by a Linux epoll event
+ *      loop.
+ *
+ */
+
+#ifndef NLFSM_EVENT_LOOP_HPP
+#define NLFSM_EVENT_LOOP_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+
+#if defined(__linux__)
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicEventLoop
+         *
+         *  @brief
+         *    This class defines an object for feeding any number of
+         *    finite state machines (FSMs), through a single, shared
+         *    driver, events read from file descriptors by a single
+         *    Linux epoll event loop.
+         *
+         *  A stream source, such as a pipe or socket, carries events
+         *  verbatim, so each read fills the caller-provided buffer
+         *  with events that are handled in place as a batch, without
+         *  any parsing or copying; with the default, eight-bit
+         *  events, every byte is an event. With wider events, the
+         *  bytes of an event split across reads are carried over to
+         *  complete it with the next read, and those of an event left
+         *  incomplete at the end of the stream are discarded.
+         *
+         *  A counter source, such as an eventfd or timerfd, carries a
+         *  count of occurrences of a single event, which is handled
+         *  that many times.
+         *
+         *  Descriptors are made non-blocking and registered
+         *  edge-triggered, so each is drained once per readiness
+         *  notification, stopping at the first short read, which
+         *  keeps system calls to a minimum.
+         *
+         *  Available only on Linux.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicEventLoop
+        {
+        public:
+            typedef StateType                                 State;
+            typedef EventType                                 Event;
+            typedef BasicMachine<StateType, EventType>        Machine;
+            typedef BasicDriver<StateType, EventType>         Driver;
+
+            /**
+             *  A file descriptor fed to a machine, allocated from
+             *  caller-provided storage.
+             */
+            struct Source
+            {
+                int        mDescriptor; //!< The descriptor, or -1 once
+                                        //!< removed.
+                Machine *  mMachine;    //!< The machine to feed.
+                bool       mCounter;    //!< Whether the descriptor
+                                        //!< carries a count of events
+                                        //!< rather than the events.
+                Event      mEvent;      //!< The event counted, for a
+                                        //!< counter source.
+                uint8_t    mPartial[sizeof (Event)];
+                                        //!< The bytes read of a
+                                        //!< partial event, for a
+                                        //!< stream source.
+                size_t     mPartialBytes;
+                                        //!< The number of bytes read
+                                        //!< of a partial event.
+            };
+
+            // Con/destructor(s)
+            BasicEventLoop(Driver &inDriver);
+            ~BasicEventLoop(void);
+
+            bool Open(void);
+            void Close(void);
+
+            bool SetSources(Source ioSources[], size_t inCount);
+            bool SetBuffer(Event ioBuffer[], size_t inSize);
+            size_t GetSourceCount(void) const;
+
+            bool AddStream(int inDescriptor,
+                           Machine &inMachine,
+                           size_t &outSource);
+            bool AddCounter(int inDescriptor,
+                            Machine &inMachine,
+                            const Event &inEvent,
+                            size_t &outSource);
+            bool Remove(size_t inSource);
+
+            bool Poll(int inTimeout,
+                      size_t &outHandled);
+
+        private:
+            // Copying would close the epoll descriptor twice.
+
+            BasicEventLoop(const BasicEventLoop &inLoop);
+            BasicEventLoop & operator =(const BasicEventLoop &inLoop);
+
+            bool Add(int inDescriptor,
+                     Machine &inMachine,
+                     bool inCounter,
+                     const Event &inEvent,
+                     size_t &outSource);
+            void DrainStream(size_t inSource,
+                             bool inHangUp,
+                             size_t &ioHandled);
+            void DrainCounter(size_t inSource,
+                              size_t &ioHandled);
+
+        private:
+            Driver *                   mDriver;           //!< The driver
+                                                          //!< shared by the
+                                                          //!< machines.
+            int                        mPoll;             //!< The epoll
+                                                          //!< descriptor, or
+                                                          //!< -1 if closed.
+            Source *                   mSources;          //!< The source
+                                                          //!< storage, if
+                                                          //!< any.
+            size_t                     mSize;             //!< The number of
+                                                          //!< sources
+                                                          //!< available in
+                                                          //!< the storage.
+            size_t                     mCount;            //!< The number of
+                                                          //!< sources in the
+                                                          //!< storage ever
+                                                          //!< used.
+            size_t                     mActive;           //!< The number of
+                                                          //!< sources added
+                                                          //!< and not yet
+                                                          //!< removed.
+            Event *                    mBuffer;           //!< The read
+                                                          //!< buffer, if any.
+            size_t                     mBufferSize;       //!< The number of
+                                                          //!< events in the
+                                                          //!< read buffer.
+        };
+
+        /**
+         *  A finite state machine (FSM) event loop with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicEventLoop<State, Event> EventLoop;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // defined(__linux__)
+
+#endif // NLFSM_EVENT_LOOP_HPP
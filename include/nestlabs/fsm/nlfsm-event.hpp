@@ -86,6 +86,11 @@ namespace nl {
         /**
          *  An identifier for a finite state machine (FSM) excitation
          *  (i.e., input) event.
+         *
+         *  This is the default, eight-bit event identifier. Machines
+         *  with more than 256 events may use the BasicTransition,
+         *  BasicMachine and BasicDriver templates with a wider
+         *  identifier type.
          */
         typedef uint8_t Event;
 
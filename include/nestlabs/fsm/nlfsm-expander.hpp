@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for expanding the wildcard
+ *      transitions of a finite state machine (FSM) transition table
+ *      into explicit ones.
+ *
+ */
+
+#ifndef NLFSM_EXPANDER_HPP
+#define NLFSM_EXPANDER_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicExpander
+         *
+         *  @brief
+         *    This class defines an object for expanding a finite
+         *    state machine (FSM) transition table with wildcard
+         *    starting states and events (see
+         *    BasicTransition::kAnyState and
+         *    BasicTransition::kAnyEvent) into an equivalent table of
+         *    explicit transitions only.
+         *
+         *  Behavior common to every state, such as handling an error
+         *  event, may then be written once in the source table while
+         *  the machine, and every lookup strategy, sees only explicit
+         *  transitions and pays nothing at run time for wildcards.
+         *
+         *  A wildcard matches each state or event appearing
+         *  explicitly anywhere in the table. Where several
+         *  transitions match a state and event, the most specific
+         *  wins: an explicit state and event; then an explicit state
+         *  with any event; then any state with an explicit event;
+         *  and finally any state and event. Among wildcard
+         *  transitions of equal specificity, the first in the table
+         *  wins.
+         *
+         *  Explicit transitions are kept, in order, and each winning
+         *  wildcard transition is replaced, in place, by its
+         *  expansion, in order of state and then event.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicExpander
+        {
+        public:
+            typedef StateType                               State;
+            typedef EventType                               Event;
+            typedef BasicTransition<StateType, EventType>   Transition;
+
+            /**
+             *  A word of expander workspace.
+             */
+            typedef uint32_t                                Word;
+
+            // Con/destructor(s)
+            BasicExpander(void);
+            BasicExpander(Word inWorkspace[], size_t inSize);
+            void SetWorkspace(Word inWorkspace[], size_t inSize);
+
+            static size_t GetWorkspaceSize(size_t inCount);
+            static bool IsWildcard(const Transition &inTransition);
+
+            bool GetExpandedCount(const Transition inTransitions[],
+                                  size_t inCount,
+                                  size_t &outCount) const;
+            bool Expand(const Transition inTransitions[],
+                        size_t inCount,
+                        Transition outTransitions[],
+                        size_t &ioCount) const;
+
+        private:
+            bool Run(const Transition inTransitions[],
+                     size_t inCount,
+                     Transition outTransitions[],
+                     size_t inSize,
+                     size_t &outCount) const;
+
+        private:
+            Word *                     mWorkspace;        //!< The caller-
+                                                          //!< provided
+                                                          //!< workspace.
+            size_t                     mSize;             //!< The number of
+                                                          //!< words in the
+                                                          //!< workspace.
+        };
+
+        /**
+         *  A finite state machine (FSM) transition table expander
+         *  with the default, eight-bit state and event identifiers.
+         */
+        typedef BasicExpander<State, Event> Expander;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_EXPANDER_HPP
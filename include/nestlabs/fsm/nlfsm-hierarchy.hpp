@@ -0,0 +1,193 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for driving a finite state machine
+ *      (FSM) as a hierarchical state machine (HSM), in which states
+ *      have parents and inherit their transitions.
+ *
+ */
+
+#ifndef NLFSM_HIERARCHY_HPP
+#define NLFSM_HIERARCHY_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-state-delegate-base.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicHierarchy
+         *
+         *  @brief
+         *    This class defines an object for driving a finite state
+         *    machine (FSM) as a hierarchical state machine (HSM), in
+         *    which each state has a parent and an event without a
+         *    transition out of the current state is handled by the
+         *    nearest ancestor with one.
+         *
+         *  Behavior common to a group of states is therefore a single
+         *  transition out of their parent, rather than one duplicated
+         *  for each state as in the equivalent flat table, which keeps
+         *  the table, and every lookup in it, small.
+         *
+         *  Taking a transition exits the current state and each of
+         *  its ancestors up to, but not including, the nearest
+         *  ancestor properly containing both the transition's starting
+         *  and ending states, then enters each state down from there
+         *  to the ending state, calling the machine's state exit and
+         *  entry handlers along the way. Those paths are computed once
+         *  for each transition, in caller-provided workspace, so
+         *  handling an event never searches the hierarchy; exiting is
+         *  a walk up a known number of parents and entering a walk
+         *  along a stored path.
+         *
+         *  Guards, actions and internal transitions of the machine
+         *  apply as they do with a driver. With a delegate set, its
+         *  hooks are called in the same order as a driver calls them,
+         *  the exit and entry hooks once around each whole walk rather
+         *  than once for each state walked; without one, every hook is
+         *  taken to succeed, as with a constant true driver.
+         *
+         *  The output event of each transition taken, if the machine
+         *  has outputs, is passed to the hierarchy's output sink, if
+         *  any, as by a driver.
+         *
+         *  An event deferred in the current state or in an ancestor
+         *  nearer than the one with its transition is pushed onto the
+         *  machine's deferral queue, and the queue is recalled after
+         *  each change of state, as a driver does.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicHierarchy
+        {
+        public:
+            typedef StateType                                 State;
+            typedef EventType                                 Event;
+            typedef BasicTransition<StateType, EventType>     Transition;
+            typedef BasicMachine<StateType, EventType>        Machine;
+            typedef Delegate::BasicBase<StateType, EventType> Base;
+
+            /**
+             *  A function called with the output event of each
+             *  transition taken and the context of the output sink,
+             *  returning false if the output could not be accepted.
+             */
+            typedef bool (*OutputFunction)(const Event &inOutput,
+                                           void *inContext);
+
+            /**
+             *  A word of hierarchy workspace.
+             */
+            typedef uint32_t                                  Word;
+
+            // Con/destructor(s)
+            BasicHierarchy(Machine &inMachine,
+                           const State inParents[],
+                           size_t inStates);
+
+            void SetDelegate(Base *inDelegate);
+            Base *GetDelegate();
+
+            void SetOutputSink(OutputFunction inFunction,
+                               void *inContext);
+
+            size_t GetWorkspaceSize(void) const;
+            bool SetWorkspace(Word ioWorkspace[], size_t inSize);
+
+            size_t GetDepth(const State &inState) const;
+            bool IsAncestor(const State &inAncestor,
+                            const State &inState) const;
+
+            const Transition * FindTransition(const State &inState,
+                                              const Event &inEvent) const;
+            bool HandleEvent(const Event &inEvent);
+
+        private:
+            const Transition * Resolve(const State &inState,
+                                       const Event &inEvent,
+                                       bool &outDeferred) const;
+            bool Take(const Event &inEvent,
+                      const State &inState,
+                      const Transition &inTransition);
+            void Recall(void);
+            size_t Walk(const State &inState) const;
+            size_t GetExitDepth(const Transition &inTransition) const;
+
+        private:
+            Machine *                  mMachine;          //!< The machine to
+                                                          //!< drive.
+            Base *                     mDelegate;         //!< The delegate,
+                                                          //!< if any.
+            OutputFunction             mOutputFunction;   //!< The output
+                                                          //!< sink function,
+                                                          //!< if any.
+            void *                     mOutputContext;    //!< The output
+                                                          //!< sink context.
+            const State *              mParents;          //!< The parent of
+                                                          //!< each state, or
+                                                          //!< the state
+                                                          //!< itself for a
+                                                          //!< top-level
+                                                          //!< state.
+            size_t                     mStates;           //!< The number of
+                                                          //!< states in the
+                                                          //!< hierarchy.
+            const Word *               mDepths;           //!< The depth of
+                                                          //!< each state, if
+                                                          //!< built.
+            const Word *               mArcs;             //!< The exit depth
+                                                          //!< and entry path
+                                                          //!< offset of each
+                                                          //!< transition, if
+                                                          //!< built.
+            const Word *               mPaths;            //!< The entry
+                                                          //!< paths, if
+                                                          //!< built.
+            size_t                     mCount;            //!< The number of
+                                                          //!< transitions
+                                                          //!< built for.
+            bool                       mRecalling;        //!< Whether the
+                                                          //!< deferral queue
+                                                          //!< is being
+                                                          //!< recalled.
+        };
+
+        /**
+         *  A hierarchical state machine (HSM) driver with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicHierarchy<State, Event> Hierarchy;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_HIERARCHY_HPP
@@ -80,6 +80,7 @@
 #define NLFSM_MACHINE_HPP
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <nestlabs/fsm/nlfsm-transition.hpp>
 
@@ -89,7 +90,7 @@ namespace nl {
 
         /**
          *
-         *  @class Machine
+         *  @class BasicMachine
          *
          *  @brief
          *    This class defines an object for managing a finite state
@@ -98,29 +99,352 @@ namespace nl {
          *    of current state, excitation input event, and next
          *    state.
          *
+         *  By default, transitions are found with a linear scan of
+         *  the transition table, returning the first match. For
+         *  larger tables, the machine may instead be given
+         *  caller-allocated storage in which to build either a dense
+         *  state-by-event index, with constant-time lookups, or a
+         *  sorted index, with logarithmic-time lookups and storage
+         *  proportional to the table size independent of the state
+         *  and event widths. The sorted index may be searched either
+         *  with a branch-free binary search or, laid out in
+         *  Eytzinger (i.e., breadth-first binary tree) order, with a
+         *  cache-friendlier descent; both have a fixed number of
+         *  iterations for a given table size and so bound the
+         *  worst-case lookup latency. For tables too large or too
+         *  sparse for either, a perfect hash over the distinct
+         *  state and event keys finds a transition with a single
+         *  probe and one verifying key comparison. Every
+         *  lookup strategy returns the same, first-matching
+         *  transition in the table.
+         *
+         *  Independent of the lookup strategy, the machine may also
+         *  be given caller-allocated storage for a per-state bitmap
+         *  of the events with a transition out of that state. When
+         *  present, events not accepted in a state are rejected with
+         *  a single bit test, before any lookup, and producers may
+         *  consult the bitmap to filter events before queuing them.
+         *
+         *  Likewise, the machine may be given caller-allocated
+         *  storage for a per-state bitmap of the events deferred in
+         *  that state and for a bounded queue of deferred events,
+         *  which a driver fills with events deferred in the current
+         *  state and recalls after each transition.
+         *
+         *  Where only the next state, rather than the transition
+         *  itself, is needed, the machine may further compress the
+         *  events into equivalence classes, events with the same
+         *  next state in every state, and keep a constant-time,
+         *  state-by-class next-state index that is smaller than the
+         *  dense index by the ratio of events to classes.
+         *
+         *  Transitions that loop back to their starting state may be
+         *  marked internal, either all at once by policy or
+         *  individually with a per-transition bitmap, in which case
+         *  a driver takes them without exiting and re-entering the
+         *  state.
+         *
+         *  Each transition may also have an action, a function and
+         *  context in an array parallel to the table, which a driver
+         *  calls directly while taking the transition, sparing the
+         *  delegate from finding the transition again to act on it.
+         *  Likewise, each state may have entry and exit handlers, in
+         *  arrays indexed by state, which a driver calls directly
+         *  while entering and exiting the state, sparing the
+         *  delegate from switching on the state.
+         *
+         *  Several adjacent transitions in the table may share a
+         *  starting state and event when each but the last has a
+         *  guard, a predicate in an array parallel to the table. The
+         *  lookup finds the first of these candidates and the guards
+         *  are then evaluated in table order, before any delegate
+         *  method or handler, taking the first candidate whose guard,
+         *  if any, holds.
+         *
+         *  The machine may also be given caller-allocated storage
+         *  for a small cache of the most recently found transitions,
+         *  checked before any lookup, such that repeated events in
+         *  the same state (e.g., bursts of self-loops) skip the
+         *  lookup entirely.
+         *
+         *  Finally, the machine may be given caller-allocated storage
+         *  in which to count the hits on each transition, a profile
+         *  from which the table may be reordered hottest first (see
+         *  BasicReorderer) to shorten linear scans.
+         *
+         *  Because the cache and profile are updated by every lookup,
+         *  including those through the const FindTransition,
+         *  FindEnabledTransition and FindNextState, a machine with
+         *  either is not safe for concurrent lookups from several
+         *  threads; give each thread its own machine over the shared,
+         *  read-only transition table instead.
+         *
+         *  As with the library's other class templates, only matching
+         *  eight-, 16- and 32-bit state and event types are
+         *  instantiated.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
          */
-        class Machine
+        template <typename StateType, typename EventType>
+        class BasicMachine
         {
         public:
+            typedef StateType                               State;
+            typedef EventType                               Event;
+            typedef BasicTransition<StateType, EventType>   Transition;
+            typedef typename Transition::Key                Key;
+
+            /**
+             *  The offset of a transition from the start of the
+             *  transition table, as stored in the lookup indices.
+             */
+            typedef uint32_t                                Offset;
+
+            /**
+             *  A word of the per-state accepted-event bitmap, in
+             *  which bit (event % 32) of word (event / 32) of a
+             *  state's row is set if the event is accepted.
+             */
+            typedef uint32_t                                Mask;
+
+            /**
+             *  The number of times a transition was found, as
+             *  counted while profiling, saturating at its maximum.
+             */
+            typedef uint32_t                                Count;
+
+            /**
+             *  The number of times the current state has been set,
+             *  wrapping at its maximum, which identifies each stay
+             *  in a state.
+             */
+            typedef uint32_t                                Epoch;
+
+            /**
+             *  The strategy used to find transitions.
+             */
+            enum Lookup
+            {
+                kLookupLinear,      //!< Linear scan of the table.
+                kLookupDense,       //!< Dense state-by-event index.
+                kLookupSorted,      //!< Index sorted by packed key.
+                kLookupEytzinger,   //!< Index sorted by packed key,
+                                    //!< in Eytzinger order.
+                kLookupHash         //!< Minimal perfect hash of
+                                    //!< packed keys.
+            };
+
+            /**
+             *  Whether transitions from a state back to itself are
+             *  taken without exiting and re-entering the state.
+             */
+            enum SelfLoop
+            {
+                kSelfLoopExternal,  //!< Self-loops exit and re-enter
+                                    //!< the state, unless flagged
+                                    //!< internal.
+                kSelfLoopInternal   //!< All self-loops are internal.
+            };
+
+            /**
+             *  A function called while taking a transition, with the
+             *  event handled, the transition and the context of its
+             *  action, returning false to abort the event as a
+             *  delegate method would.
+             */
+            typedef bool (*ActionFunction)(const Event &inEvent,
+                                           const Transition &inTransition,
+                                           void *inContext);
+
+            /**
+             *  The action of a transition.
+             */
+            struct Action
+            {
+                ActionFunction  mFunction;  //!< The function to call,
+                                            //!< or NULL for none.
+                void *          mContext;   //!< The context to call it
+                                            //!< with.
+            };
+
+            /**
+             *  A function called while finding a transition, with the
+             *  event handled, a candidate transition and the context
+             *  of its guard, returning whether the candidate may be
+             *  taken.
+             */
+            typedef bool (*GuardFunction)(const Event &inEvent,
+                                          const Transition &inTransition,
+                                          void *inContext);
+
+            /**
+             *  The guard of a transition.
+             */
+            struct Guard
+            {
+                GuardFunction   mFunction;  //!< The function to call,
+                                            //!< or NULL for none.
+                void *          mContext;   //!< The context to call it
+                                            //!< with.
+            };
+
+            /**
+             *  An entry in the sorted lookup index.
+             */
+            struct SortedEntry
+            {
+                Key     mKey;       //!< The packed starting state and
+                                    //!< event key of the transition.
+                Offset  mOffset;    //!< The offset of the transition
+                                    //!< in the transition table.
+            };
+
             // Con/destructor(s)
-            Machine(void);
-            Machine(const Transition inTransitions[],
-                    size_t inCount,
-                    const State &inCurrentState);
+            BasicMachine(void);
+            BasicMachine(const Transition inTransitions[],
+                         size_t inCount,
+                         const State &inCurrentState);
             void SetTransitions(const Transition inTransitions[],
                                 size_t inCount,
                                 const State &inCurrentState);
+            const Transition * GetTransitions(size_t &outCount) const;
 
             const State & GetCurrentState(void) const;
             void SetCurrentState(const State & inState);
+            Epoch GetStateEpoch(void) const;
             const Transition * FindTransition(const State &inState,
                                               const Event &inEvent) const;
+            const Transition * FindEnabledTransition(const State &inState,
+                                                     const Event &inEvent) const;
+
+            Lookup GetLookup(void) const;
+            void SetLinearLookup(void);
+            size_t GetDenseIndexSize(void) const;
+            bool SetDenseLookup(Offset inIndex[], size_t inSize);
+            size_t GetSortedIndexSize(void) const;
+            bool SetSortedLookup(SortedEntry inIndex[], size_t inSize);
+            size_t GetEytzingerIndexSize(void) const;
+            bool SetEytzingerLookup(SortedEntry inIndex[],
+                                    size_t inSize,
+                                    SortedEntry inScratch[],
+                                    size_t inScratchSize);
+            size_t GetHashIndexSize(void) const;
+            bool SetHashLookup(Offset inIndex[],
+                               size_t inSize,
+                               SortedEntry inScratch[],
+                               size_t inScratchSize);
+
+            size_t GetAcceptedEventsSize(void) const;
+            bool SetAcceptedEvents(Mask inBitmap[], size_t inSize);
+            void ClearAcceptedEvents(void);
+            const Mask * GetAcceptedEvents(const State &inState,
+                                           size_t &outWords) const;
+            bool IsEventAccepted(const State &inState,
+                                 const Event &inEvent) const;
+
+            size_t GetDeferredEventsSize(void) const;
+            bool SetDeferredEvents(Mask ioBitmap[], size_t inSize);
+            void ClearDeferredEvents(void);
+            bool SetEventDeferred(const State &inState,
+                                  const Event &inEvent);
+            bool IsEventDeferred(const State &inState,
+                                 const Event &inEvent) const;
+
+            bool SetDeferralQueue(Event ioQueue[], size_t inSize);
+            void ClearDeferralQueue(void);
+            bool PushDeferredEvent(const Event &inEvent);
+            bool PopDeferredEvent(Event &outEvent);
+            size_t GetDeferredEventCount(void) const;
+            bool HasDeferral(void) const;
+
+            size_t GetEventClassMapSize(void) const;
+            bool SetEventClasses(Event outClassMap[],
+                                 size_t inClassMapSize,
+                                 Offset ioIndex[],
+                                 size_t inIndexSize);
+            void ClearEventClasses(void);
+            size_t GetEventClassCount(void) const;
+            size_t GetNextStateIndexSize(void) const;
+            bool FindNextState(const State &inState,
+                               const Event &inEvent,
+                               State &outState) const;
+
+            SelfLoop GetSelfLoopPolicy(void) const;
+            void SetSelfLoopPolicy(SelfLoop inPolicy);
+            size_t GetInternalTransitionsSize(void) const;
+            bool SetInternalTransitions(const Mask inFlags[], size_t inSize);
+            void ClearInternalTransitions(void);
+            bool HasInternalTransitions(void) const;
+            bool IsInternalTransition(const Transition &inTransition) const;
+
+            bool SetActions(const Action inActions[], size_t inSize);
+            void ClearActions(void);
+            bool HasActions(void) const;
+            const Action * GetAction(const Transition &inTransition) const;
+
+            size_t GetStateHandlersSize(void) const;
+            bool SetStateHandlers(const Action inOnEnter[],
+                                  const Action inOnExit[],
+                                  size_t inSize);
+            void ClearStateHandlers(void);
+            bool HasStateHandlers(void) const;
+            const Action * GetEnterHandler(const State &inState) const;
+            const Action * GetExitHandler(const State &inState) const;
+
+            bool SetOutputs(const Event inOutputs[], size_t inSize);
+            void ClearOutputs(void);
+            bool HasOutputs(void) const;
+            bool GetOutput(const Transition &inTransition,
+                           Event &outOutput) const;
+
+            bool SetGuards(const Guard inGuards[], size_t inSize);
+            void ClearGuards(void);
+            bool HasGuards(void) const;
+
+            bool SetTransitionCache(SortedEntry ioCache[], size_t inSize);
+            void ClearTransitionCache(void);
+            size_t GetTransitionCacheSize(void) const;
+
+            bool SetProfile(Count ioCounts[], size_t inSize);
+            void ClearProfile(void);
+            Count * GetProfile(void) const;
 
         private:
+            const Transition * FindUncached(const State &inState,
+                                            const Event &inEvent) const;
+            const Transition * FindLinear(const State &inState,
+                                          const Event &inEvent) const;
+            const Transition * FindDense(const State &inState,
+                                         const Event &inEvent) const;
+            const Transition * FindSorted(const State &inState,
+                                          const Event &inEvent) const;
+            const Transition * FindEytzinger(const State &inState,
+                                             const Event &inEvent) const;
+            const Transition * FindHash(const State &inState,
+                                        const Event &inEvent) const;
+            bool BuildSortedIndex(SortedEntry outIndex[],
+                                  size_t inSize) const;
+            size_t GetHashBuckets(void) const;
+            size_t GetHashSlots(void) const;
+            bool GetDenseDimensions(size_t &outStates,
+                                    size_t &outEvents) const;
+            bool IsSameNextState(Offset inFirst, Offset inSecond) const;
+            bool FindCached(const Key &inKey,
+                            const Transition *&outTransition) const;
+            void Remember(const Key &inKey,
+                          const Transition *inTransition) const;
+            void Hit(Offset inOffset) const;
+
             State                      mCurrentState;     //!< The current
                                                           //!< state of the
                                                           //!< finite state
                                                           //!< machine.
+            Epoch                      mStateEpoch;       //!< The number of
+                                                          //!< times the
+                                                          //!< current state
+                                                          //!< has been set.
             size_t                     mCount;            //!< The number of
                                                           //!< transitions in
                                                           //!< the finite state
@@ -133,8 +457,141 @@ namespace nl {
                                                           //!< machine's state
                                                           //!< transition
                                                           //!< table.
+            Lookup                     mLookup;           //!< The strategy
+                                                          //!< used to find
+                                                          //!< transitions.
+            const Offset *             mDenseIndex;       //!< The dense
+                                                          //!< index, if any.
+            size_t                     mDenseEvents;      //!< The number of
+                                                          //!< events (i.e.,
+                                                          //!< columns) in
+                                                          //!< the dense
+                                                          //!< index.
+            size_t                     mDenseStates;      //!< The number of
+                                                          //!< states (i.e.,
+                                                          //!< rows) in the
+                                                          //!< dense index.
+            const SortedEntry *        mSortedIndex;      //!< The sorted
+                                                          //!< or Eytzinger
+                                                          //!< index, if any.
+            const Offset *             mHashIndex;        //!< The perfect
+                                                          //!< hash bucket
+                                                          //!< displacements
+                                                          //!< followed by
+                                                          //!< its slots, if
+                                                          //!< any.
+            size_t                     mHashBuckets;      //!< The number of
+                                                          //!< buckets in the
+                                                          //!< perfect hash
+                                                          //!< index.
+            size_t                     mHashSlots;        //!< The number of
+                                                          //!< slots in the
+                                                          //!< perfect hash
+                                                          //!< index.
+            const Mask *               mAcceptedEvents;   //!< The per-state
+                                                          //!< accepted-event
+                                                          //!< bitmap, if any.
+            size_t                     mAcceptedWords;    //!< The number of
+                                                          //!< words per state
+                                                          //!< (i.e., row) in
+                                                          //!< the bitmap.
+            size_t                     mAcceptedStates;   //!< The number of
+                                                          //!< states (i.e.,
+                                                          //!< rows) in the
+                                                          //!< bitmap.
+            Mask *                     mDeferredEvents;   //!< The per-state
+                                                          //!< deferred-event
+                                                          //!< bitmap, if any.
+            size_t                     mDeferredWords;    //!< The number of
+                                                          //!< words per state
+                                                          //!< (i.e., row) in
+                                                          //!< the bitmap.
+            size_t                     mDeferredStates;   //!< The number of
+                                                          //!< states (i.e.,
+                                                          //!< rows) in the
+                                                          //!< bitmap.
+            Event *                    mQueue;            //!< The deferred
+                                                          //!< event queue,
+                                                          //!< if any.
+            size_t                     mQueueSize;        //!< The number of
+                                                          //!< entries in the
+                                                          //!< queue.
+            size_t                     mQueueHead;        //!< The oldest
+                                                          //!< deferred event
+                                                          //!< in the queue.
+            size_t                     mQueueCount;       //!< The number of
+                                                          //!< deferred events
+                                                          //!< in the queue.
+            const Event *              mClassMap;         //!< The event
+                                                          //!< class of each
+                                                          //!< event, if any.
+            const Offset *             mClassIndex;       //!< The state-by-
+                                                          //!< class next-
+                                                          //!< state index,
+                                                          //!< if any.
+            size_t                     mClassEvents;      //!< The number of
+                                                          //!< events in the
+                                                          //!< class map.
+            size_t                     mClasses;          //!< The number of
+                                                          //!< classes (i.e.,
+                                                          //!< columns) in the
+                                                          //!< index.
+            size_t                     mClassStates;      //!< The number of
+                                                          //!< states (i.e.,
+                                                          //!< rows) in the
+                                                          //!< index.
+            SelfLoop                   mSelfLoopPolicy;   //!< Whether all
+                                                          //!< self-loops
+                                                          //!< are internal.
+            const Mask *               mInternal;         //!< The per-
+                                                          //!< transition
+                                                          //!< internal
+                                                          //!< flags, if any.
+            const Action *             mActions;          //!< The per-
+                                                          //!< transition
+                                                          //!< actions, if
+                                                          //!< any.
+            const Event *              mOutputs;          //!< The per-
+                                                          //!< transition
+                                                          //!< output events,
+                                                          //!< if any.
+            const Action *             mEnterHandlers;    //!< The per-
+                                                          //!< state entry
+                                                          //!< handlers, if
+                                                          //!< any.
+            const Action *             mExitHandlers;     //!< The per-
+                                                          //!< state exit
+                                                          //!< handlers, if
+                                                          //!< any.
+            size_t                     mHandlerStates;    //!< The number of
+                                                          //!< states with
+                                                          //!< handlers.
+            const Guard *              mGuards;           //!< The per-
+                                                          //!< transition
+                                                          //!< guards, if
+                                                          //!< any.
+            SortedEntry *              mCache;            //!< The recently
+                                                          //!< found
+                                                          //!< transitions,
+                                                          //!< if caching.
+            size_t                     mCacheSize;        //!< The number of
+                                                          //!< entries in the
+                                                          //!< cache.
+            mutable size_t             mCacheNext;        //!< The cache
+                                                          //!< entry to
+                                                          //!< replace next.
+            Count *                    mProfile;          //!< The per-
+                                                          //!< transition
+                                                          //!< hit counts,
+                                                          //!< if profiling.
         };
 
+        /**
+         *  A finite state machine (FSM) with the default, eight-bit
+         *  state and event identifiers.
+         */
+        typedef BasicMachine<State, Event> Machine;
+
     }; // namespace Fsm
 
 }; // namespace nl
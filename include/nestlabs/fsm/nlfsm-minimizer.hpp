@@ -0,0 +1,126 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for minimizing a finite state
+ *      machine (FSM) transition table by merging equivalent states.
+ *
+ */
+
+#ifndef NLFSM_MINIMIZER_HPP
+#define NLFSM_MINIMIZER_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicMinimizer
+         *
+         *  @brief
+         *    This class defines an object for minimizing a finite
+         *    state machine (FSM) transition table, producing an
+         *    equivalent table in which no two states are equivalent
+         *    along with a map from each original state to the state
+         *    that replaces it.
+         *
+         *  Two states are equivalent if every event either has no
+         *  transition out of either or leads from both to equivalent
+         *  states and, optionally, if the caller's initial partition
+         *  places them in the same class (e.g., because delegates
+         *  treat them differently). Only the first of several
+         *  transitions for the same state and event is considered,
+         *  as in lookups.
+         *
+         *  Equivalent states are merged with the refinement algorithm
+         *  of Hopcroft, in the form by Valmari and Lehtinen for
+         *  partial transition functions, in O(m log n) time for m
+         *  transitions and n states, entirely within caller-provided
+         *  workspace.
+         *
+         *  Each merged state is represented by the lowest of the
+         *  original states it replaces, such that states that are
+         *  not merged keep their numbering and delegates and stored
+         *  states continue to work once mapped through the state map.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicMinimizer
+        {
+        public:
+            typedef StateType                               State;
+            typedef EventType                               Event;
+            typedef BasicTransition<StateType, EventType>   Transition;
+
+            /**
+             *  A word of minimizer workspace or an initial partition
+             *  class.
+             */
+            typedef uint32_t                                Word;
+
+            // Con/destructor(s)
+            BasicMinimizer(void);
+            BasicMinimizer(Word inWorkspace[], size_t inSize);
+            void SetWorkspace(Word inWorkspace[], size_t inSize);
+
+            static size_t GetStateCount(const Transition inTransitions[],
+                                        size_t inCount,
+                                        const State &inInitialState);
+            static size_t GetWorkspaceSize(const Transition inTransitions[],
+                                           size_t inCount,
+                                           const State &inInitialState);
+
+            bool Minimize(const Transition inTransitions[],
+                          size_t inCount,
+                          const State &inInitialState,
+                          const Word inPartition[],
+                          Transition outTransitions[],
+                          size_t &ioCount,
+                          State outStateMap[],
+                          size_t inStateMapSize) const;
+
+        private:
+            Word *                     mWorkspace;        //!< The caller-
+                                                          //!< provided
+                                                          //!< workspace.
+            size_t                     mSize;             //!< The number of
+                                                          //!< words in the
+                                                          //!< workspace.
+        };
+
+        /**
+         *  A finite state machine (FSM) minimizer with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicMinimizer<State, Event> Minimizer;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_MINIMIZER_HPP
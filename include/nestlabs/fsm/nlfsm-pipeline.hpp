@@ -0,0 +1,164 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for chaining finite state machines
+ *      (FSMs) into a pipeline, each feeding its output events to the
+ *      next through a single-producer, single-consumer queue.
+ *
+ */
+
+#ifndef NLFSM_PIPELINE_HPP
+#define NLFSM_PIPELINE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicPipeline
+         *
+         *  @brief
+         *    This class defines an object for chaining finite state
+         *    machines (FSMs), each with its own driver, into a
+         *    pipeline, in which the output events of each stage's
+         *    machine are the input events of the next.
+         *
+         *  Each stage reads its input events from one queue and writes
+         *  its output events to the next, so there are one more queues
+         *  than stages: events are pushed into the first queue with
+         *  #Push and the final output events popped from the last with
+         *  #Pop.
+         *
+         *  Each queue is a lock-free, bounded ring with a single
+         *  producer and a single consumer, so #Push, #Pop and #RunStage
+         *  for each stage may each be called from its own thread, for
+         *  example one pinned to its own core, without further locking.
+         *  Each may also be called in turn from a single thread.
+         *
+         *  A stage only takes an input event while its output queue
+         *  has room for every output handling it might emit: one for
+         *  the event itself and one for each event its machine has
+         *  deferred, any of which it may recall. A slow stage thereby
+         *  holds back those before it rather than losing events. A
+         *  stage whose machine defers events therefore needs an
+         *  output queue holding at least one more event than its
+         *  deferral queue, or it stalls once that queue fills.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicPipeline
+        {
+        public:
+            typedef StateType                                 State;
+            typedef EventType                                 Event;
+            typedef BasicDriver<StateType, EventType>         Driver;
+            typedef BasicMachine<StateType, EventType>        Machine;
+
+            /**
+             *  The assumed size, in bytes, of a cache line.
+             */
+            enum { kCacheLineSize = 64 };
+
+            /**
+             *  A single-producer, single-consumer queue of events
+             *  between stages, in caller-provided storage.
+             *
+             *  The head and tail are each padded out to a cache line,
+             *  so the consumer advancing the one and the producer
+             *  advancing the other never contend for the same line.
+             */
+            struct Queue
+            {
+                Event *            mEvents;     //!< The queue storage.
+                size_t             mSize;       //!< The number of
+                                                //!< entries in the
+                                                //!< storage, one more
+                                                //!< than the queue
+                                                //!< holds.
+                uint8_t            mPad0[kCacheLineSize -
+                                         sizeof (Event *) -
+                                         sizeof (size_t)];
+                size_t             mHead;       //!< The oldest event,
+                                                //!< advanced by the
+                                                //!< consumer.
+                uint8_t            mPad1[kCacheLineSize -
+                                         sizeof (size_t)];
+                size_t             mTail;       //!< The next free entry,
+                                                //!< advanced by the
+                                                //!< producer.
+                uint8_t            mPad2[kCacheLineSize -
+                                         sizeof (size_t)];
+            };
+
+            // Con/destructor(s)
+            BasicPipeline(Driver * const inStages[],
+                          size_t inCount);
+
+            bool SetQueues(Queue ioQueues[],
+                           size_t inQueues,
+                           Event ioEvents[],
+                           size_t inEvents);
+            size_t GetStageCount(void) const;
+
+            bool Push(const Event &inEvent);
+            bool Pop(Event &outEvent);
+            size_t RunStage(size_t inStage,
+                            size_t inMax);
+
+        private:
+            static size_t GetRoom(const Queue &inQueue);
+            static bool Enqueue(Queue &ioQueue,
+                                const Event &inEvent);
+            static bool Dequeue(Queue &ioQueue,
+                                Event &outEvent);
+            static bool Output(const Event &inOutput,
+                               void *inContext);
+
+        private:
+            Driver * const *           mStages;           //!< The driver of
+                                                          //!< each stage.
+            size_t                     mCount;            //!< The number of
+                                                          //!< stages.
+            Queue *                    mQueues;           //!< The queues,
+                                                          //!< one more than
+                                                          //!< the stages, if
+                                                          //!< set.
+        };
+
+        /**
+         *  A finite state machine (FSM) pipeline with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicPipeline<State, Event> Pipeline;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_PIPELINE_HPP
@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for reordering a finite state
+ *      machine (FSM) transition table, hottest transitions first,
+ *      from a profile of per-transition hit counts.
+ *
+ */
+
+#ifndef NLFSM_REORDERER_HPP
+#define NLFSM_REORDERER_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicReorderer
+         *
+         *  @brief
+         *    This class defines an object for reordering a finite
+         *    state machine (FSM) transition table by descending hit
+         *    count, as collected by a profiling machine, such that a
+         *    linear scan finds the most frequently taken transitions
+         *    soonest.
+         *
+         *  Since lookups return the first transition for a state and
+         *  event, every transition is ordered by the count of the
+         *  first transition for its state and event, and transitions
+         *  with equal counts keep their relative order; duplicates
+         *  therefore never overtake the transition shadowing them and
+         *  the reordered table finds the same transitions as the
+         *  original.
+         *
+         *  A reordered table may either be installed in a running
+         *  machine or formatted as C initializers to be compiled into
+         *  the next build.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicReorderer
+        {
+        public:
+            typedef StateType                                 State;
+            typedef EventType                                 Event;
+            typedef BasicTransition<StateType, EventType>     Transition;
+            typedef BasicMachine<StateType, EventType>        Machine;
+            typedef typename Machine::Count                   Count;
+
+            /**
+             *  A word of reorderer workspace.
+             */
+            typedef uint32_t                                  Word;
+
+            // Con/destructor(s)
+            BasicReorderer(void);
+            BasicReorderer(Word inWorkspace[], size_t inSize);
+            void SetWorkspace(Word inWorkspace[], size_t inSize);
+
+            static size_t GetWorkspaceSize(size_t inCount);
+
+            bool Reorder(const Transition inTransitions[],
+                         size_t inCount,
+                         const Count inCounts[],
+                         Transition outTransitions[],
+                         Count outCounts[]) const;
+            bool Reorder(Machine &ioMachine,
+                         Transition outTransitions[],
+                         size_t inSize) const;
+
+            static size_t Format(const Transition inTransitions[],
+                                 size_t inCount,
+                                 const Count inCounts[],
+                                 char outBuffer[],
+                                 size_t inSize);
+
+        private:
+            bool Order(const Transition inTransitions[],
+                       size_t inCount,
+                       const Count inCounts[]) const;
+
+        private:
+            Word *                     mWorkspace;        //!< The caller-
+                                                          //!< provided
+                                                          //!< workspace.
+            size_t                     mSize;             //!< The number of
+                                                          //!< words in the
+                                                          //!< workspace.
+        };
+
+        /**
+         *  A finite state machine (FSM) transition table reorderer
+         *  with the default, eight-bit state and event identifiers.
+         */
+        typedef BasicReorderer<State, Event> Reorderer;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_REORDERER_HPP
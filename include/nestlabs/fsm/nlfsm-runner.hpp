@@ -0,0 +1,190 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for running a finite state machine
+ *      (FSM) over a buffer of events, such as a memory-mapped file,
+ *      without a driver.
+ *
+ */
+
+#ifndef NLFSM_RUNNER_HPP
+#define NLFSM_RUNNER_HPP
+
+#include <stddef.h>
+
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicRunner
+         *
+         *  @brief
+         *    This class defines an object for running a finite state
+         *    machine (FSM) over a buffer of events as a deterministic
+         *    finite automaton, for example to scan logs or wire
+         *    formats byte by byte.
+         *
+         *  The machine's transition table is first compiled into a
+         *  dense next-state table, in caller-provided storage, with a
+         *  row for every state and a column for every event, so each
+         *  event costs a single table load, without any transition
+         *  lookup, driver or delegate method. As with the driver, an
+         *  event without a transition leaves the state unchanged.
+         *  Actions, state handlers and outputs are not called or
+         *  emitted, and machines with guards, which must be evaluated
+         *  per event, cannot be compiled.
+         *
+         *  The runner keeps its own current state, initially the
+         *  machine's, and position, so a stream may be run in chunks.
+         *  A run may report only the final state, the positions at
+         *  which a set of accepting states is entered or the number
+         *  of events after which each state was current.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicRunner
+        {
+        public:
+            typedef StateType                                 State;
+            typedef EventType                                 Event;
+            typedef BasicTransition<StateType, EventType>     Transition;
+            typedef BasicMachine<StateType, EventType>        Machine;
+            typedef typename Machine::Mask                    Mask;
+            typedef typename Machine::Count                   Count;
+
+            // Con/destructor(s)
+            BasicRunner(const Machine &inMachine);
+
+            size_t GetTableSize(void) const;
+            bool Compile(State ioTable[], size_t inSize);
+            size_t GetStateCount(void) const;
+
+            size_t GetAcceptingSize(void) const;
+            bool SetAccepting(const Mask inStates[], size_t inSize);
+            void ClearAccepting(void);
+
+            const State & GetState(void) const;
+            void SetState(const State &inState);
+            size_t GetPosition(void) const;
+            void Reset(void);
+
+            const State & Run(const Event inEvents[],
+                              size_t inCount);
+            size_t Scan(const Event inEvents[],
+                        size_t inCount,
+                        size_t outPositions[],
+                        size_t inMax,
+                        size_t &outScanned);
+            bool Tally(const Event inEvents[],
+                       size_t inCount,
+                       Count ioCounts[],
+                       size_t inSize);
+
+        private:
+            bool GetDimensions(size_t &outStates,
+                               size_t &outEvents) const;
+            bool IsAccepting(const State &inState) const;
+
+        private:
+            const Machine *            mMachine;          //!< The machine to
+                                                          //!< run.
+            const State *              mTable;            //!< The compiled
+                                                          //!< next-state
+                                                          //!< table, if any.
+            size_t                     mStates;           //!< The number of
+                                                          //!< rows (i.e.,
+                                                          //!< states) in the
+                                                          //!< table.
+            size_t                     mEvents;           //!< The number of
+                                                          //!< columns (i.e.,
+                                                          //!< events) in the
+                                                          //!< table.
+            const Mask *               mAccepting;        //!< The accepting
+                                                          //!< state bitmap,
+                                                          //!< if any.
+            State                      mState;            //!< The current
+                                                          //!< state.
+            size_t                     mPosition;         //!< The number of
+                                                          //!< events run
+                                                          //!< since the last
+                                                          //!< reset.
+        };
+
+        /**
+         *  A finite state machine (FSM) runner with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicRunner<State, Event> Runner;
+
+#if defined(__linux__)
+
+        /**
+         *
+         *  @class MappedFile
+         *
+         *  @brief
+         *    This class defines an object for mapping a file read-only
+         *    into memory, advised for sequential access, to be run
+         *    over in place by a runner.
+         *
+         *  Available only on Linux.
+         *
+         */
+        class MappedFile
+        {
+        public:
+            // Con/destructor(s)
+            MappedFile(void);
+            ~MappedFile(void);
+
+            bool Open(const char *inPath);
+            void Close(void);
+
+            const void * GetData(void) const;
+            size_t GetSize(void) const;
+
+        private:
+            // Copying would unmap the file twice.
+
+            MappedFile(const MappedFile &inFile);
+            MappedFile & operator =(const MappedFile &inFile);
+
+        private:
+            void *                     mData;             //!< The mapping,
+                                                          //!< if any.
+            size_t                     mSize;             //!< The size of
+                                                          //!< the mapping,
+                                                          //!< in bytes.
+        };
+
+#endif // defined(__linux__)
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_RUNNER_HPP
@@ -92,7 +92,7 @@ namespace nl {
         namespace Delegate {
 
             /**
-             *  @class Always
+             *  @class BasicAlways
              *
              *  @brief
              *    This class defines a derived class following the
@@ -107,14 +107,24 @@ namespace nl {
              *  derived delegates that only want to override a select
              *  subset of the superclass delegate methods.
              *
+             *  @tparam  StateType  The integer type identifying states.
+             *  @tparam  EventType  The integer type identifying events.
+             *
              */
-            class Always : public Boolean
+            template <typename StateType, typename EventType>
+            class BasicAlways : public BasicBoolean<StateType, EventType>
             {
             public:
                 // Con/destructor(s)
-                Always(void);
+                BasicAlways(void);
             };
 
+            /**
+             *  The Always delegate for machines with the default,
+             *  eight-bit state and event identifiers.
+             */
+            typedef BasicAlways<State, Event> Always;
+
         }; // namespace Delegate
 
     }; // namespace Fsm
@@ -0,0 +1,126 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines a base class following the delegate pattern
+ *      for observing and handling various finite state machine (FSM)
+ *      management events, any of which may complete asynchronously.
+ *
+ */
+
+#ifndef NLFSM_DELEGATE_ASYNC_HPP
+#define NLFSM_DELEGATE_ASYNC_HPP
+
+#include <nestlabs/fsm/nlfsm-event.hpp>
+#include <nestlabs/fsm/nlfsm-state.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        namespace Delegate {
+
+            /**
+             *  The result of an asynchronous delegate method.
+             */
+            enum Result
+            {
+                kResultVeto     = 0,    //!< Stop processing the event
+                                        //!< and hold at the current
+                                        //!< state.
+                kResultContinue = 1,    //!< Continue processing the
+                                        //!< event.
+                kResultPending  = 2     //!< Suspend processing the
+                                        //!< event until the result is
+                                        //!< known.
+            };
+
+            /**
+             *  @class BasicAsync
+             *
+             *  @brief
+             *    This class defines a base class following the
+             *    delegate pattern for observing and handling various
+             *    finite state machine (FSM) management events, any of
+             *    which may complete asynchronously.
+             *
+             *  The delegate methods are those of BasicBase, called in
+             *  the same order, but each may return #kResultPending,
+             *  for example to persist state before it is entered, in
+             *  which case the driver suspends the in-flight event at
+             *  that point, without blocking, until told the eventual
+             *  result with BasicAsyncDriver::Resume.
+             *
+             *  Each delegate method returns #kResultContinue unless
+             *  overridden.
+             *
+             *  @tparam  StateType  The integer type identifying states.
+             *  @tparam  EventType  The integer type identifying events.
+             *
+             */
+            template <typename StateType, typename EventType>
+            class BasicAsync
+            {
+            public:
+                typedef StateType                               State;
+                typedef EventType                               Event;
+                typedef BasicTransition<StateType, EventType>   Transition;
+
+                virtual Result WillHandleEvent(const Event &inEvent,
+                                               const State &inState);
+                virtual Result DidHandleEvent(const Event &inEvent,
+                                              const State &inState);
+
+                virtual Result WillExitState(const Event &inEvent,
+                                             const Transition &inTransition);
+                virtual Result DidExitState(const Event &inEvent,
+                                            const Transition &inTransition);
+
+                virtual Result WillTransition(const Event &inEvent,
+                                              const Transition &inTransition);
+                virtual Result DidTransition(const Event &inEvent,
+                                             const Transition &inTransition);
+
+                virtual Result WillEnterState(const Event &inEvent,
+                                              const Transition &inTransition);
+                virtual Result DidEnterState(const Event &inEvent,
+                                             const Transition &inTransition);
+
+            protected:
+                // Constructor - Protected to ensure that no
+                // instances of this object can be directly
+                // instantiated outside of derived classes.
+
+                BasicAsync(void);
+            };
+
+            /**
+             *  The asynchronous delegate base class for machines with
+             *  the default, eight-bit state and event identifiers.
+             */
+            typedef BasicAsync<State, Event> Async;
+
+        }; // namespace Delegate
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_DELEGATE_ASYNC_HPP
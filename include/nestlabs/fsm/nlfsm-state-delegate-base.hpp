@@ -93,7 +93,7 @@ namespace nl {
         namespace Delegate {
 
             /**
-             *  @class Base
+             *  @class BasicBase
              *
              *  @brief
              *    This class defines an abstract base class following the
@@ -106,10 +106,18 @@ namespace nl {
              *  "in flight" event and holds at the current
              *  state. Otherwise, the FSM continues event processing.
              *
+             *  @tparam  StateType  The integer type identifying states.
+             *  @tparam  EventType  The integer type identifying events.
+             *
              */
-            class Base
+            template <typename StateType, typename EventType>
+            class BasicBase
             {
             public:
+                typedef StateType                               State;
+                typedef EventType                               Event;
+                typedef BasicTransition<StateType, EventType>   Transition;
+
                 /**
                  *  @name Event Reception
                  *
@@ -328,9 +336,15 @@ namespace nl {
                 // instances of this object can be directly
                 // instantiated outside of derived classes.
 
-                Base(void);
+                BasicBase(void);
             };
 
+            /**
+             *  The abstract delegate base class for machines with the
+             *  default, eight-bit state and event identifiers.
+             */
+            typedef BasicBase<State, Event> Base;
+
         }; // namespace Delegate
 
     }; // namespace Fsm
@@ -86,7 +86,7 @@ namespace nl {
         namespace Delegate {
 
             /**
-             *  @class Boolean
+             *  @class BasicBoolean
              *
              *  @brief
              *    This class defines a derived class following the
@@ -97,10 +97,18 @@ namespace nl {
              *  return true or false, depending on the intialization
              *  parameter passed to the constructor.
              *
+             *  @tparam  StateType  The integer type identifying states.
+             *  @tparam  EventType  The integer type identifying events.
+             *
              */
-            class Boolean : public Base
+            template <typename StateType, typename EventType>
+            class BasicBoolean : public BasicBase<StateType, EventType>
             {
             public:
+                typedef StateType                               State;
+                typedef EventType                               Event;
+                typedef BasicTransition<StateType, EventType>   Transition;
+
                 virtual bool WillHandleEvent(const Event &inEvent,
                                              const State &inState);
                 virtual bool DidHandleEvent(const Event &inEvent,
@@ -126,13 +134,19 @@ namespace nl {
                 // instances of this object can be directly
                 // instantiated outside of derived classes.
 
-                Boolean(bool inBoolean);
+                BasicBoolean(bool inBoolean);
 
             private:
                 const bool mBoolean; //!< Value returned by all Will*/Did*
                                      //!< delegate methods
             };
 
+            /**
+             *  The constant Boolean delegate for machines with the
+             *  default, eight-bit state and event identifiers.
+             */
+            typedef BasicBoolean<State, Event> Boolean;
+
         }; // namespace Delegate
 
     }; // namespace Fsm
@@ -0,0 +1,63 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines a tag identifying a constant-result delegate,
+ *      one whose methods unconditionally return either true or false.
+ *
+ *      A driver given such a tag in place of a delegate object knows
+ *      the outcome of every delegate method in advance and elides the
+ *      delegate method calls entirely.
+ *
+ */
+
+#ifndef NLFSM_DELEGATE_CONSTANT_HPP
+#define NLFSM_DELEGATE_CONSTANT_HPP
+
+namespace nl {
+
+    namespace Fsm {
+
+        namespace Delegate {
+
+            /**
+             *  A tag identifying a constant-result delegate.
+             *
+             *  Passing #kConstantAlways to a driver is behaviorally
+             *  equivalent to passing an instance of Delegate::Always
+             *  and passing #kConstantNever is behaviorally equivalent
+             *  to passing an instance of Delegate::Never, except that
+             *  no delegate methods are called.
+             *
+             */
+            enum Constant
+            {
+                kConstantNever  = 0,    //!< All delegate methods
+                                        //!< return false.
+                kConstantAlways = 1     //!< All delegate methods
+                                        //!< return true.
+            };
+
+        }; // namespace Delegate
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_DELEGATE_CONSTANT_HPP
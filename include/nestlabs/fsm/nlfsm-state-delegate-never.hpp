@@ -90,7 +90,7 @@ namespace nl {
         namespace Delegate {
 
             /**
-             *  @class Never
+             *  @class BasicNever
              *
              *  @brief
              *    This class defines a derived class following the
@@ -103,14 +103,24 @@ namespace nl {
              *  The primary intended use of this delegate derivation
              *  is to support testing.
              *
+             *  @tparam  StateType  The integer type identifying states.
+             *  @tparam  EventType  The integer type identifying events.
+             *
              */
-            class Never : public Boolean
+            template <typename StateType, typename EventType>
+            class BasicNever : public BasicBoolean<StateType, EventType>
             {
             public:
                 // Con/destructor(s)
-                Never(void);
+                BasicNever(void);
             };
 
+            /**
+             *  The Never delegate for machines with the default,
+             *  eight-bit state and event identifiers.
+             */
+            typedef BasicNever<State, Event> Never;
+
         }; // namespace Delegate
 
     }; // namespace Fsm
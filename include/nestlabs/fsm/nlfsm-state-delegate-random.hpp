@@ -82,6 +82,8 @@
 #ifndef NLFSM_DELEGATE_RANDOM_HPP
 #define NLFSM_DELEGATE_RANDOM_HPP
 
+#include <stdint.h>
+
 #include <nestlabs/fsm/nlfsm-state-delegate-base.hpp>
 
 namespace nl {
@@ -91,7 +93,7 @@ namespace nl {
         namespace Delegate {
 
             /**
-             *  @class Random
+             *  @class BasicRandom
              *
              *  @brief
              *    This class defines a derived class following the
@@ -102,16 +104,56 @@ namespace nl {
              *  false status for any of the delegate methods in a
              *  pseudo-random distribution.
              *
+             *  Each instance owns its own pseudo-random number
+             *  generator (PRNG) state, such that instances seeded
+             *  identically produce identical status sequences,
+             *  independent of one another and of the thread they are
+             *  used on. The probability with which each delegate
+             *  method vetoes (i.e., returns false) may be set
+             *  independently and defaults to one half.
+             *
              *  The primary intended use of this delegate derivation
              *  is to support testing.
              *
+             *  @tparam  StateType  The integer type identifying states.
+             *  @tparam  EventType  The integer type identifying events.
+             *
              */
-            class Random : public Base
+            template <typename StateType, typename EventType>
+            class BasicRandom : public BasicBase<StateType, EventType>
             {
             public:
+                typedef StateType                               State;
+                typedef EventType                               Event;
+                typedef BasicTransition<StateType, EventType>   Transition;
+
+                /**
+                 *  Identifiers for each of the delegate methods for
+                 *  which a veto probability may be set.
+                 */
+                enum Hook
+                {
+                    kHookWillHandleEvent = 0,
+                    kHookDidHandleEvent,
+                    kHookWillExitState,
+                    kHookDidExitState,
+                    kHookWillTransition,
+                    kHookDidTransition,
+                    kHookWillEnterState,
+                    kHookDidEnterState,
+
+                    kHookMax
+                };
+
                 // Con/destructor(s)
-                Random(void);
-                Random(unsigned int inSeed);
+                BasicRandom(void);
+                BasicRandom(unsigned int inSeed);
+
+                void Seed(unsigned int inSeed);
+
+                void SetVetoProbability(double inProbability);
+                void SetVetoProbability(Hook inHook, double inProbability);
+                double GetVetoProbability(Hook inHook) const;
 
                 virtual bool WillHandleEvent(const Event &inEvent,
                                              const State &inState);
@@ -134,9 +176,22 @@ namespace nl {
                                            const Transition &inTransition);
 
             private:
-                bool GetStatus(void);
+                bool GetStatus(Hook inHook);
+                uint32_t GetNext(void);
+
+                uint32_t  mState[4];               //!< The xoshiro128**
+                                                   //!< PRNG state.
+                uint64_t  mThresholds[kHookMax];   //!< Per-method veto
+                                                   //!< thresholds, scaled
+                                                   //!< to 2^32.
             };
 
+            /**
+             *  The pseudo-random delegate for machines with the
+             *  default, eight-bit state and event identifiers.
+             */
+            typedef BasicRandom<State, Event> Random;
+
         }; // namespace Delegate
 
     }; // namespace Fsm
@@ -86,6 +86,11 @@ namespace nl {
 
         /**
          *  An identifier for a finite state machine (FSM) state.
+         *
+         *  This is the default, eight-bit state identifier. Machines
+         *  with more than 256 states may use the BasicTransition,
+         *  BasicMachine and BasicDriver templates with a wider
+         *  identifier type.
          */
         typedef uint8_t State;
 
@@ -0,0 +1,193 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for delivering timeout events to
+ *      many finite state machines (FSMs) from a single, hierarchical
+ *      timer wheel.
+ *
+ */
+
+#ifndef NLFSM_TIMER_WHEEL_HPP
+#define NLFSM_TIMER_WHEEL_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicTimerWheel
+         *
+         *  @brief
+         *    This class defines an object for delivering timeout
+         *    events to any number of finite state machines (FSMs),
+         *    through a single, shared driver, from a hierarchical
+         *    timer wheel.
+         *
+         *  A timer fires a specified event at a specified machine
+         *  after a specified number of ticks of the wheel, which the
+         *  caller advances from a single clock source, in place of
+         *  one operating system timer per machine.
+         *
+         *  The wheel has four levels of 256 slots, each level's slot
+         *  spanning all of the slots of the level below, covering
+         *  every delay of the 32-bit tick. Arming a timer links it
+         *  into a slot in constant time. Each tick expires the timers
+         *  of one slot of the lowest level, after first cascading
+         *  those of a higher-level slot due into the levels below
+         *  whenever a lower level wraps.
+         *
+         *  A timer belongs to the stay in the state its machine was
+         *  in when it was armed, identified by the machine's state
+         *  epoch, and is cancelled once the machine leaves that
+         *  state. Cancellation is lazy: the timer keeps its storage
+         *  until it expires, when it is discarded rather than fired,
+         *  so arming and cancelling never search the wheel.
+         *
+         *  A timer armed during a transition, from its action, the
+         *  starting state's exit handler or a delegate method up to
+         *  and including WillEnterState, must be armed with the
+         *  transition, so it belongs to the stay in the ending state
+         *  about to be entered rather than the state being left.
+         *  From the ending state's entry handler on, the machine is
+         *  already in that state and the timer is armed without the
+         *  transition.
+         *
+         *  Timers are allocated from caller-provided storage, which
+         *  must be large enough for every timer armed and not yet
+         *  expired, including those cancelled.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicTimerWheel
+        {
+        public:
+            typedef StateType                                 State;
+            typedef EventType                                 Event;
+            typedef BasicTransition<StateType, EventType>     Transition;
+            typedef BasicMachine<StateType, EventType>        Machine;
+            typedef BasicDriver<StateType, EventType>         Driver;
+            typedef typename Machine::Epoch                   Epoch;
+
+            /**
+             *  A number of ticks of the wheel or, for the time of the
+             *  wheel, the number of ticks since it started, wrapping
+             *  at its maximum.
+             */
+            typedef uint32_t                                  Tick;
+
+            /**
+             *  The offset of a timer in the timer storage.
+             */
+            typedef uint32_t                                  Index;
+
+            /**
+             *  A timer, allocated from caller-provided storage.
+             */
+            struct Timer
+            {
+                Machine *  mMachine;    //!< The machine to fire at.
+                Epoch      mEpoch;      //!< The machine's state epoch
+                                        //!< of the stay armed for.
+                State      mState;      //!< The state armed for.
+                Tick       mExpiry;     //!< The time at which to fire.
+                Index      mNext;       //!< The next timer in the same
+                                        //!< slot or free list.
+                Event      mEvent;      //!< The event to fire.
+            };
+
+            enum
+            {
+                kLevels    = 4,         //!< The number of levels.
+                kSlotBits  = 8,         //!< The number of tick bits
+                                        //!< spanned by each level.
+                kSlots     = 1 << kSlotBits  //!< The number of slots
+                                             //!< per level.
+            };
+
+            // Con/destructor(s)
+            BasicTimerWheel(Driver &inDriver);
+
+            bool SetTimers(Timer ioTimers[], size_t inCount);
+
+            Tick GetNow(void) const;
+            size_t GetPendingCount(void) const;
+
+            bool Arm(Machine &inMachine,
+                     const Event &inEvent,
+                     Tick inDelay);
+            bool Arm(Machine &inMachine,
+                     const Transition &inTransition,
+                     const Event &inEvent,
+                     Tick inDelay);
+            size_t Advance(Tick inTicks);
+
+        private:
+            bool Add(Machine &inMachine,
+                     const Epoch &inEpoch,
+                     const State &inState,
+                     const Event &inEvent,
+                     Tick inDelay);
+            void Insert(Index inTimer);
+            void Cascade(size_t inLevel);
+            size_t Expire(void);
+
+        private:
+            Driver *                   mDriver;           //!< The driver
+                                                          //!< shared by the
+                                                          //!< machines.
+            Timer *                    mTimers;           //!< The timer
+                                                          //!< storage, if
+                                                          //!< any.
+            Index                      mFree;             //!< The first free
+                                                          //!< timer.
+            size_t                     mPending;          //!< The number of
+                                                          //!< timers armed
+                                                          //!< and not yet
+                                                          //!< expired.
+            Tick                       mNow;              //!< The time of
+                                                          //!< the wheel.
+            Index                      mSlots[kLevels * kSlots];
+                                                          //!< The first timer
+                                                          //!< of each slot of
+                                                          //!< each level.
+        };
+
+        /**
+         *  A finite state machine (FSM) timer wheel with the default,
+         *  eight-bit state and event identifiers.
+         */
+        typedef BasicTimerWheel<State, Event> TimerWheel;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_TIMER_WHEEL_HPP
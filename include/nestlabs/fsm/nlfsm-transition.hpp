@@ -77,6 +77,9 @@
 #ifndef NLFSM_TRANSITION_HPP
 #define NLFSM_TRANSITION_HPP
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <nestlabs/fsm/nlfsm-event.hpp>
 #include <nestlabs/fsm/nlfsm-state.hpp>
 
@@ -84,22 +87,113 @@ namespace nl {
 
     namespace Fsm {
 
+        namespace Detail {
+
+            /**
+             *  The narrowest unsigned integer type at least \c inBytes
+             *  bytes wide, up to eight bytes.
+             *
+             *  @tparam  inBytes  The minimum width, in bytes.
+             *
+             */
+            template <size_t inBytes>
+            struct Unsigned
+            {
+                typedef typename Unsigned<inBytes + 1>::Type Type;
+            };
+
+            template <> struct Unsigned<1> { typedef uint8_t  Type; };
+            template <> struct Unsigned<2> { typedef uint16_t Type; };
+            template <> struct Unsigned<4> { typedef uint32_t Type; };
+            template <> struct Unsigned<8> { typedef uint64_t Type; };
+
+        }; // namespace Detail
+
         /**
          *  A finite state machine (FSM) transition arc, consisting of
          *  a starting state, an excitation event, and an ending
          *  state.
          *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
          */
-        struct Transition
+        template <typename StateType, typename EventType>
+        struct BasicTransition
         {
+            typedef StateType State;
+            typedef EventType Event;
+
+            /**
+             *  An unsigned integer type wide enough to hold a
+             *  starting state and event pair packed together, with
+             *  the state in the most significant bits such that keys
+             *  order first by state and then by event.
+             */
+            typedef typename Detail::Unsigned<sizeof(State) + sizeof(Event)>::Type Key;
+
+            /**
+             *  Wildcard starting state and event markers, the largest
+             *  identifier of each type, matching any state or event
+             *  when a table is expanded (see BasicExpander). The
+             *  wildcard event doubles as the marker for no event, such
+             *  as a transition without an output.
+             */
+            enum
+            {
+                kAnyState = static_cast<State>(~static_cast<State>(0)),  //!< Any
+                                                                        //!< state.
+                kAnyEvent = static_cast<Event>(~static_cast<Event>(0)),  //!< Any
+                                                                        //!< event.
+                kNoEvent  = kAnyEvent                                   //!< No
+                                                                        //!< event.
+            };
+
             State mStart;   //!< Starting or initial state of the
                             //!< transition arc.
             Event mEvent;   //!< Excitation input or event for the
                             //!< transition arc.
             State mEnd;     //!< Ending or final state of the transition arc.
+
+            /**
+             *  @brief
+             *    Pack the specified starting state and event into a
+             *    single key.
+             *
+             *  @param[in]  inState  A reference to the starting state.
+             *  @param[in]  inEvent  A reference to the event.
+             *
+             *  @return  The packed key.
+             *
+             */
+            static Key MakeKey(const State &inState, const Event &inEvent)
+            {
+                return static_cast<Key>((static_cast<Key>(inState) << (sizeof(Event) * 8)) | inEvent);
+            }
+
+            /**
+             *  @brief
+             *    Get the packed starting state and event key of this
+             *    transition arc.
+             *
+             *  @return  The packed key.
+             *
+             */
+            Key GetKey(void) const
+            {
+                return MakeKey(mStart, mEvent);
+            }
         };
 
-        bool operator ==(const Transition &lhs, const Transition &rhs);
+        template <typename StateType, typename EventType>
+        bool operator ==(const BasicTransition<StateType, EventType> &lhs,
+                         const BasicTransition<StateType, EventType> &rhs);
+
+        /**
+         *  A finite state machine (FSM) transition arc with the
+         *  default, eight-bit state and event identifiers.
+         */
+        typedef BasicTransition<State, Event> Transition;
 
     }; // namespace Fsm
 
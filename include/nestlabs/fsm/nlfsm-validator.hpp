@@ -0,0 +1,224 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines an object for validating a finite state
+ *      machine (FSM) transition table and pruning its dead
+ *      transitions.
+ *
+ */
+
+#ifndef NLFSM_VALIDATOR_HPP
+#define NLFSM_VALIDATOR_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class BasicValidator
+         *
+         *  @brief
+         *    This class defines an object for validating a finite
+         *    state machine (FSM) transition table, reporting
+         *    transitions shadowed by an earlier one for the same state
+         *    and event, states unreachable from the initial state and
+         *    states without a transition to any other state, and for
+         *    pruning the table of transitions that can never be taken.
+         *
+         *  Since lookups return the first transition for a state and
+         *  event, a later duplicate is never taken, and neither is a
+         *  transition out of a state that no sequence of events leads
+         *  to from the initial state. Removing both leaves a table
+         *  that behaves identically from the initial state and that
+         *  is smaller to scan and to index with any lookup strategy.
+         *
+         *  Pruning moves transitions, so any arrays parallel to the
+         *  table, such as a machine's actions, guards, outputs and
+         *  internal-transition flags or the validator's own guarded
+         *  flags, must be compacted to match; pruning reports the
+         *  original offset of each kept transition for that purpose.
+         *
+         *  Where the machine has guards, the validator may be told
+         *  which transitions are guarded, in which case a transition
+         *  immediately following a live, guarded transition for the
+         *  same state and event is a live candidate rather than a
+         *  duplicate.
+         *
+         *  Validation runs in O(m log m + n) time for m transitions
+         *  and n states, entirely within caller-provided workspace.
+         *
+         *  @tparam  StateType  The integer type identifying states.
+         *  @tparam  EventType  The integer type identifying events.
+         *
+         */
+        template <typename StateType, typename EventType>
+        class BasicValidator
+        {
+        public:
+            typedef StateType                               State;
+            typedef EventType                               Event;
+            typedef BasicTransition<StateType, EventType>   Transition;
+
+            /**
+             *  A word of validator workspace.
+             */
+            typedef uint32_t                                Word;
+
+            /**
+             *
+             *  @class Observer
+             *
+             *  @brief
+             *    This class defines an abstract base class for
+             *    observing each problem found while validating a
+             *    transition table.
+             *
+             */
+            class Observer
+            {
+            public:
+                virtual ~Observer(void) { return; }
+
+                /**
+                 *  @brief
+                 *    This routine is called by a validator for each
+                 *    transition shadowed by an earlier transition for
+                 *    the same state and event.
+                 *
+                 *  @param[in]  inFirst      A reference to the earlier,
+                 *                           shadowing transition.
+                 *  @param[in]  inDuplicate  A reference to the shadowed
+                 *                           transition.
+                 *
+                 */
+                virtual void DuplicateTransition(const Transition &inFirst,
+                                                 const Transition &inDuplicate) = 0;
+
+                /**
+                 *  @brief
+                 *    This routine is called by a validator for each
+                 *    state in the table that no sequence of events
+                 *    leads to from the initial state.
+                 *
+                 *  @param[in]  inState  A reference to the unreachable
+                 *                       state.
+                 *
+                 */
+                virtual void UnreachableState(const State &inState) = 0;
+
+                /**
+                 *  @brief
+                 *    This routine is called by a validator for each
+                 *    reachable state without a transition to any other
+                 *    state.
+                 *
+                 *  @param[in]  inState  A reference to the sink state.
+                 *
+                 */
+                virtual void SinkState(const State &inState) = 0;
+
+            protected:
+                Observer(void) { return; }
+            };
+
+            /**
+             *
+             *  @struct Report
+             *
+             *  @brief
+             *    The numbers of each problem found while validating a
+             *    transition table.
+             *
+             */
+            struct Report
+            {
+                size_t mDuplicates;     //!< The number of shadowed,
+                                        //!< duplicate transitions.
+                size_t mUnreachable;    //!< The number of states
+                                        //!< unreachable from the
+                                        //!< initial state.
+                size_t mSinks;          //!< The number of reachable
+                                        //!< sink states.
+                size_t mDead;           //!< The number of transitions
+                                        //!< that pruning removes.
+            };
+
+            // Con/destructor(s)
+            BasicValidator(void);
+            BasicValidator(Word inWorkspace[], size_t inSize);
+            void SetWorkspace(Word inWorkspace[], size_t inSize);
+            bool SetGuardedTransitions(const Word inFlags[], size_t inSize);
+            void ClearGuardedTransitions(void);
+
+            static size_t GetStateCount(const Transition inTransitions[],
+                                        size_t inCount,
+                                        const State &inInitialState);
+            static size_t GetWorkspaceSize(const Transition inTransitions[],
+                                           size_t inCount,
+                                           const State &inInitialState);
+
+            bool Validate(const Transition inTransitions[],
+                          size_t inCount,
+                          const State &inInitialState,
+                          Observer *inObserver,
+                          Report &outReport) const;
+            bool Prune(const Transition inTransitions[],
+                       size_t inCount,
+                       const State &inInitialState,
+                       Transition outTransitions[],
+                       size_t outOffsets[],
+                       size_t &ioCount) const;
+
+        private:
+            bool IsGuarded(size_t inOffset) const;
+
+        private:
+            Word *                     mWorkspace;        //!< The caller-
+                                                          //!< provided
+                                                          //!< workspace.
+            size_t                     mSize;             //!< The number of
+                                                          //!< words in the
+                                                          //!< workspace.
+            const Word *               mGuarded;          //!< The per-
+                                                          //!< transition
+                                                          //!< guarded
+                                                          //!< flags, if any.
+            size_t                     mGuardedSize;      //!< The number of
+                                                          //!< words of
+                                                          //!< guarded flags.
+        };
+
+        /**
+         *  A finite state machine (FSM) transition table validator with
+         *  the default, eight-bit state and event identifiers.
+         */
+        typedef BasicValidator<State, Event> Validator;
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_VALIDATOR_HPP
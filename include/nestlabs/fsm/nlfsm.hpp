@@ -21,20 +21,39 @@
  *      This file is an umbrella header for a finite state machine
  *      library.
  *
+ *      The library's class templates are explicitly instantiated
+ *      only for matching state and event widths: <uint8_t, uint8_t>,
+ *      <uint16_t, uint16_t> and <uint32_t, uint32_t>. A mixed pair,
+ *      such as <uint8_t, uint16_t>, compiles against these headers
+ *      but fails to link; use the wider type for both instead.
+ *
  */
 
 #ifndef NLFSM_NLFSM_HPP
 #define NLFSM_NLFSM_HPP
 
+#include <nestlabs/fsm/nlfsm-async-driver.hpp>
+#include <nestlabs/fsm/nlfsm-composite.hpp>
 #include <nestlabs/fsm/nlfsm-driver.hpp>
 #include <nestlabs/fsm/nlfsm-event.hpp>
+#include <nestlabs/fsm/nlfsm-event-loop.hpp>
+#include <nestlabs/fsm/nlfsm-expander.hpp>
+#include <nestlabs/fsm/nlfsm-hierarchy.hpp>
 #include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-minimizer.hpp>
+#include <nestlabs/fsm/nlfsm-pipeline.hpp>
+#include <nestlabs/fsm/nlfsm-reorderer.hpp>
+#include <nestlabs/fsm/nlfsm-runner.hpp>
 #include <nestlabs/fsm/nlfsm-state-delegate-always.hpp>
+#include <nestlabs/fsm/nlfsm-state-delegate-async.hpp>
 #include <nestlabs/fsm/nlfsm-state-delegate-base.hpp>
 #include <nestlabs/fsm/nlfsm-state-delegate-boolean.hpp>
+#include <nestlabs/fsm/nlfsm-state-delegate-constant.hpp>
 #include <nestlabs/fsm/nlfsm-state-delegate-never.hpp>
 #include <nestlabs/fsm/nlfsm-state-delegate-random.hpp>
 #include <nestlabs/fsm/nlfsm-state.hpp>
+#include <nestlabs/fsm/nlfsm-timer-wheel.hpp>
 #include <nestlabs/fsm/nlfsm-transition.hpp>
+#include <nestlabs/fsm/nlfsm-validator.hpp>
 
 #endif // NLFSM_NLFSM_HPP
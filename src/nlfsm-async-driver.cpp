@@ -0,0 +1,484 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an event handler/driver for a finite state
+ *      machine (FSM) whose delegate methods may complete
+ *      asynchronously.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-async-driver.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-state-delegate-async.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+namespace Fsm {
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the driver
+ *    with the specified state machine and asynchronous delegate, and
+ *    without a queue.
+ *
+ *  @param[in]  inMachine   A reference to the state machine to instantiate
+ *                          with.
+ *  @param[in]  inDelegate  A pointer to the asynchronous delegate to
+ *                          instantiate with.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicAsyncDriver<StateType, EventType>::BasicAsyncDriver(Machine &inMachine, Async *inDelegate) :
+    mMachine(&inMachine),
+    mDelegate(inDelegate),
+    mTransition(NULL),
+    mEvent(0),
+    mState(0),
+    mInternal(false),
+    mStep(kStepDone),
+    mQueue(NULL),
+    mQueueSize(0),
+    mQueueHead(0),
+    mQueueCount(0),
+    mRecallCount(0),
+    mOutputFunction(NULL),
+    mOutputContext(NULL)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine starts queuing events arriving while an event is in
+ *    flight in the specified storage, initially empty.
+ *
+ *  Without a queue, such events fail. The storage must remain valid
+ *  until it is next set.
+ *
+ *  @param[in,out]  ioQueue  Storage for the queue.
+ *  @param[in]      inSize   The number of events available in the
+ *                           storage.
+ *
+ *  @return  \c true if queuing started; otherwise, \c false, if the
+ *           storage is empty or events are already queued.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicAsyncDriver<StateType, EventType>::SetQueue(Event ioQueue[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(ioQueue != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize > 0, done, retval = false);
+    nlREQUIRE_ACTION(mQueueCount == 0, done, retval = false);
+
+    mQueue      = ioQueue;
+    mQueueSize  = inSize;
+    mQueueHead  = 0;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of events queued behind the
+ *    in-flight event.
+ *
+ *  @return  The number of queued events.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicAsyncDriver<StateType, EventType>::GetQueuedCount(void) const
+{
+    return (mQueueCount);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether an event is in flight, suspended
+ *    awaiting the result of a delegate method.
+ *
+ *  @return  \c true if an event is suspended; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicAsyncDriver<StateType, EventType>::IsSuspended(void) const
+{
+    return (mTransition != NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the output sink, to which the output event of
+ *    each transition taken is passed.
+ *
+ *  @param[in]  inFunction  The function to pass outputs to, or NULL
+ *                          to discard them.
+ *  @param[in]  inContext   The context to call it with.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicAsyncDriver<StateType, EventType>::SetOutputSink(OutputFunction inFunction, void *inContext)
+{
+    mOutputFunction = inFunction;
+    mOutputContext  = inContext;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine handles the specified state machine excitation
+ *    event or, if an event is in flight, queues it behind that event.
+ *
+ *  Once the event, and any queued behind it, completes or suspends,
+ *  the driver returns.
+ *
+ *  @param[in]  inEvent  A reference to the state machine excitation event
+ *                       to handle.
+ *
+ *  @return  #kStatusHandled if the event was handled; #kStatusSuspended
+ *           if it is in flight, awaiting #Resume; #kStatusQueued if it
+ *           was queued or deferred; otherwise, #kStatusFailed, if it
+ *           was not handled, was vetoed or could not be queued or
+ *           deferred.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicAsyncDriver<StateType, EventType>::Status
+BasicAsyncDriver<StateType, EventType>::HandleEvent(const Event &inEvent)
+{
+    size_t theTail;
+    Status status;
+
+    nlPRECONDITION_VALUE(mMachine != NULL, kStatusFailed);
+    nlPRECONDITION_VALUE(mDelegate != NULL, kStatusFailed);
+
+    if (IsSuspended()) {
+        if (mQueueCount >= mQueueSize)
+            return (kStatusFailed);
+
+        theTail = mQueueHead + mQueueCount;
+
+        if (theTail >= mQueueSize)
+            theTail -= mQueueSize;
+
+        mQueue[theTail] = inEvent;
+        mQueueCount++;
+
+        return (kStatusQueued);
+    }
+
+    status = Begin(inEvent);
+
+    if (status != kStatusSuspended)
+        Drain();
+
+    return (status);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine resumes the in-flight event with the eventual result
+ *    of the delegate method that suspended it.
+ *
+ *  The event carries on from the step after that delegate method,
+ *  perhaps to suspend again. Once it completes, any deferred events
+ *  to recall and then events queued behind it are handled, in order,
+ *  until one suspends or none remain.
+ *
+ *  The delegate must not resume the event from within the delegate
+ *  method that suspends it.
+ *
+ *  @param[in]  inResult  The result of the delegate method.
+ *
+ *  @return  #kStatusHandled if the in-flight event was handled;
+ *           #kStatusSuspended if it is still in flight; otherwise,
+ *           #kStatusFailed, if it was vetoed or no event is in flight.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicAsyncDriver<StateType, EventType>::Status
+BasicAsyncDriver<StateType, EventType>::Resume(Delegate::Result inResult)
+{
+    Status status;
+
+    nlPRECONDITION_VALUE(IsSuspended(), kStatusFailed);
+
+    if (inResult == Delegate::kResultPending)
+        return (kStatusSuspended);
+
+    if (inResult == Delegate::kResultContinue) {
+        status = Run();
+
+    } else {
+        mTransition = NULL;
+        status = kStatusFailed;
+
+    }
+
+    if (status != kStatusSuspended)
+        Drain();
+
+    return (status);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine starts the specified event in flight, in the current
+ *    state, and runs it until it completes or suspends, or defers it
+ *    if the current state defers it.
+ *
+ *  @param[in]  inEvent  A reference to the event to start.
+ *
+ *  @return  The outcome of the event.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicAsyncDriver<StateType, EventType>::Status
+BasicAsyncDriver<StateType, EventType>::Begin(const Event &inEvent)
+{
+    const Transition * theTransition;
+
+    // A deferred event is only queued, to be recalled once the
+    // machine has left the state deferring it.
+
+    if (mMachine->IsEventDeferred(mMachine->GetCurrentState(), inEvent))
+        return (mMachine->PushDeferredEvent(inEvent) ? kStatusQueued : kStatusFailed);
+
+    theTransition = mMachine->FindEnabledTransition(mMachine->GetCurrentState(), inEvent);
+
+    if (theTransition == NULL)
+        return (kStatusFailed);
+
+    mTransition = theTransition;
+    mEvent      = inEvent;
+    mState      = mMachine->GetCurrentState();
+    mInternal   = mMachine->IsInternalTransition(*theTransition);
+    mStep       = kStepWillHandleEvent;
+
+    return (Run());
+}
+
+/**
+ *
+ *  @brief
+ *    This routine performs the remaining steps of the in-flight event
+ *    until it completes, is vetoed or suspends.
+ *
+ *  An event completing with a change of state starts a recall of
+ *  the deferral queue, superseding any recall already under way, so
+ *  the events remaining in it are retried in the new state.
+ *
+ *  @return  The outcome of the event.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicAsyncDriver<StateType, EventType>::Status
+BasicAsyncDriver<StateType, EventType>::Run(void)
+{
+    Delegate::Result theResult;
+    Step             theStep;
+
+    while (mStep != kStepDone) {
+        theStep = mStep;
+        mStep   = static_cast<Step>(mStep + 1);
+
+        theResult = Perform(theStep);
+
+        if (theResult == Delegate::kResultPending)
+            return (kStatusSuspended);
+
+        if (theResult == Delegate::kResultVeto) {
+            mTransition = NULL;
+            return (kStatusFailed);
+        }
+    }
+
+    mTransition = NULL;
+
+    if (mMachine->GetCurrentState() != mState)
+        mRecallCount = mMachine->GetDeferredEventCount();
+
+    return (kStatusHandled);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine performs the specified step of the in-flight event.
+ *
+ *  The steps, and the machine handlers and actions within them, are
+ *  those of BasicDriver::HandleEvent, including passing the output
+ *  on last; an internal transition skips exiting and entering its
+ *  state.
+ *
+ *  @param[in]  inStep  The step to perform.
+ *
+ *  @return  The result of the step's delegate method or
+ *           Delegate::kResultVeto if a machine handler or action
+ *           failed or the output sink did not accept the output.
+ *
+ */
+template <typename StateType, typename EventType>
+Delegate::Result
+BasicAsyncDriver<StateType, EventType>::Perform(Step inStep)
+{
+    const Transition &               theTransition = *mTransition;
+    const typename Machine::Action * theAction;
+    Event                            theOutput;
+
+    switch (inStep) {
+
+    case kStepWillHandleEvent:
+        return (mDelegate->WillHandleEvent(mEvent, mState));
+
+    case kStepWillExitState:
+        if (mInternal)
+            break;
+
+        return (mDelegate->WillExitState(mEvent, theTransition));
+
+    case kStepDidExitState:
+        if (mInternal)
+            break;
+
+        theAction = mMachine->GetExitHandler(theTransition.mStart);
+
+        if ((theAction != NULL) && !theAction->mFunction(mEvent, theTransition, theAction->mContext))
+            return (Delegate::kResultVeto);
+
+        return (mDelegate->DidExitState(mEvent, theTransition));
+
+    case kStepWillTransition:
+        return (mDelegate->WillTransition(mEvent, theTransition));
+
+    case kStepDidTransition:
+        theAction = mMachine->GetAction(theTransition);
+
+        if ((theAction != NULL) && !theAction->mFunction(mEvent, theTransition, theAction->mContext))
+            return (Delegate::kResultVeto);
+
+        return (mDelegate->DidTransition(mEvent, theTransition));
+
+    case kStepWillEnterState:
+        if (mInternal)
+            break;
+
+        return (mDelegate->WillEnterState(mEvent, theTransition));
+
+    case kStepDidEnterState:
+        if (mInternal)
+            break;
+
+        mMachine->SetCurrentState(theTransition.mEnd);
+
+        theAction = mMachine->GetEnterHandler(theTransition.mEnd);
+
+        if ((theAction != NULL) && !theAction->mFunction(mEvent, theTransition, theAction->mContext))
+            return (Delegate::kResultVeto);
+
+        return (mDelegate->DidEnterState(mEvent, theTransition));
+
+    case kStepDidHandleEvent:
+        return (mDelegate->DidHandleEvent(mEvent, mState));
+
+    case kStepEmit:
+        if ((mOutputFunction == NULL) || !mMachine->GetOutput(theTransition, theOutput))
+            break;
+
+        if (!mOutputFunction(theOutput, mOutputContext))
+            return (Delegate::kResultVeto);
+
+        break;
+
+    case kStepDone:
+        break;
+
+    }
+
+    return (Delegate::kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine handles the deferred events to recall and then the
+ *    queued events, in order, until one suspends or none remain.
+ *
+ *  A recalled event still deferred is pushed again, in the slot just
+ *  freed, so is retried only by a later recall.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicAsyncDriver<StateType, EventType>::Drain(void)
+{
+    Event theEvent;
+
+    while (!IsSuspended()) {
+        if (mRecallCount > 0) {
+            mRecallCount--;
+
+            if (!mMachine->PopDeferredEvent(theEvent))
+                continue;
+
+        } else if (mQueueCount > 0) {
+            theEvent = mQueue[mQueueHead];
+
+            if (++mQueueHead == mQueueSize)
+                mQueueHead = 0;
+
+            mQueueCount--;
+
+        } else {
+            break;
+
+        }
+
+        Begin(theEvent);
+    }
+}
+
+// Explicit Instantiations
+
+template class BasicAsyncDriver<uint8_t, uint8_t>;
+template class BasicAsyncDriver<uint16_t, uint16_t>;
+template class BasicAsyncDriver<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
@@ -0,0 +1,343 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for dispatching each event to
+ *      several concurrent, orthogonal finite state machine (FSM)
+ *      regions.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-composite.hpp>
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+namespace nl {
+
+namespace Fsm {
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the
+ *    composite with the specified regions, driven by the specified
+ *    driver.
+ *
+ *  The driver is pointed at each region in turn as events are
+ *  dispatched, so is left pointing at one of the regions.
+ *
+ *  @param[in]  inRegions  An array of pointers to the regions.
+ *  @param[in]  inCount    The number of regions.
+ *  @param[in]  inDriver   A reference to the driver to share.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicComposite<StateType, EventType>::BasicComposite(Machine *inRegions[],
+                                                     size_t inCount,
+                                                     Driver &inDriver) :
+    mRegions(inRegions),
+    mCount(inCount),
+    mDriver(&inDriver),
+    mAcceptedEvents(NULL),
+    mAcceptedWords(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of regions.
+ *
+ *  @return  The number of regions.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicComposite<StateType, EventType>::GetRegionCount(void) const
+{
+    return (mCount);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the specified region.
+ *
+ *  @param[in]  inRegion  The index of the region.
+ *
+ *  @return  A pointer to the region, or NULL if there is no such
+ *           region.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicComposite<StateType, EventType>::Machine *
+BasicComposite<StateType, EventType>::GetRegion(size_t inRegion) const
+{
+    return ((inRegion < mCount) ? mRegions[inRegion] : NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of storage required for
+ *    the per-region accepted-event bitmap of the regions' current
+ *    transition tables.
+ *
+ *  @return  The number of words required, or zero if there are no
+ *           regions or the events are too large to be mapped.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicComposite<StateType, EventType>::GetAcceptedEventsSize(void) const
+{
+    uint64_t theMaxEvent = 0;
+    size_t   theWords;
+    size_t   theCount;
+    size_t   i, j;
+
+    if ((mRegions == NULL) || (mCount == 0))
+        return (0);
+
+    for (i = 0; i < mCount; i++) {
+        const typename Machine::Transition * theTransitions = mRegions[i]->GetTransitions(theCount);
+
+        for (j = 0; j < theCount; j++) {
+            if (theTransitions[j].mEvent > theMaxEvent)
+                theMaxEvent = theTransitions[j].mEvent;
+        }
+    }
+
+    if (theMaxEvent >= (SIZE_MAX / sizeof (Mask) / mCount))
+        return (0);
+
+    theWords = (static_cast<size_t>(theMaxEvent) / kMaskBits) + 1;
+
+    return (mCount * theWords);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine builds a per-region bitmap of the events with a
+ *    transition out of any state of each region's current transition
+ *    table in the specified storage, after which regions are skipped
+ *    for events they never handle.
+ *
+ *  The storage must remain valid until any region's transition table
+ *  is next set or the bitmap is cleared.
+ *
+ *  @param[in]  inBitmap  Storage for the bitmap.
+ *  @param[in]  inSize    The number of words available in the
+ *                        storage, at least that returned by
+ *                        #GetAcceptedEventsSize.
+ *
+ *  @return  \c true if the bitmap was built; otherwise, \c false, in
+ *           which case any existing bitmap is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicComposite<StateType, EventType>::SetAcceptedEvents(Mask inBitmap[], size_t inSize)
+{
+    const size_t theSize = GetAcceptedEventsSize();
+    size_t       theWords;
+    size_t       theCount;
+    size_t       i, j;
+    bool         retval = true;
+
+    nlREQUIRE_ACTION(inBitmap != NULL, done, retval = false);
+    nlREQUIRE_ACTION(theSize > 0, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= theSize, done, retval = false);
+
+    theWords = theSize / mCount;
+
+    for (i = 0; i < theSize; i++)
+        inBitmap[i] = 0;
+
+    for (i = 0; i < mCount; i++) {
+        const typename Machine::Transition * theTransitions = mRegions[i]->GetTransitions(theCount);
+
+        for (j = 0; j < theCount; j++) {
+            const Event &theEvent = theTransitions[j].mEvent;
+
+            inBitmap[(i * theWords) + (theEvent / kMaskBits)] |= static_cast<Mask>(1) << (theEvent % kMaskBits);
+        }
+    }
+
+    mAcceptedEvents = inBitmap;
+    mAcceptedWords  = theWords;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine discards the per-region accepted-event bitmap,
+ *    after which every event is dispatched to every region.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicComposite<StateType, EventType>::ClearAcceptedEvents(void)
+{
+    mAcceptedEvents = NULL;
+    mAcceptedWords  = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the specified region may handle
+ *    the specified event in some state.
+ *
+ *  Without a bitmap, every event is accepted.
+ *
+ *  @param[in]  inRegion  The index of the region.
+ *  @param[in]  inEvent   A reference to the event.
+ *
+ *  @return  \c true if the event may be handled by the region;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicComposite<StateType, EventType>::IsEventAccepted(size_t inRegion, const Event &inEvent) const
+{
+    size_t theWord;
+
+    if (inRegion >= mCount)
+        return (false);
+
+    if (mAcceptedEvents == NULL)
+        return (true);
+
+    theWord = static_cast<size_t>(inEvent / kMaskBits);
+
+    if (theWord >= mAcceptedWords)
+        return (false);
+
+    return ((mAcceptedEvents[(inRegion * mAcceptedWords) + theWord] & (static_cast<Mask>(1) << (inEvent % kMaskBits))) != 0);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine dispatches the specified event to every region that
+ *    may handle it.
+ *
+ *  @param[in]  inEvent  A reference to the event to dispatch.
+ *
+ *  @return  \c true if any region handled the event successfully;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicComposite<StateType, EventType>::HandleEvent(const Event &inEvent)
+{
+    size_t theHandled;
+
+    return (HandleEvent(inEvent, theHandled));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine dispatches the specified event to every region that
+ *    may handle it, in region order, counting the regions that
+ *    handled it successfully.
+ *
+ *  @param[in]   inEvent     A reference to the event to dispatch.
+ *  @param[out]  outHandled  The number of regions that handled the
+ *                           event successfully.
+ *
+ *  @return  \c true if any region handled the event successfully;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicComposite<StateType, EventType>::HandleEvent(const Event &inEvent, size_t &outHandled)
+{
+    const Mask * theRow;
+    Mask         theBit;
+    size_t       theWord;
+    size_t       i;
+
+    outHandled = 0;
+
+    nlPRECONDITION_VALUE(mDriver != NULL, false);
+
+    if (mAcceptedEvents == NULL) {
+        for (i = 0; i < mCount; i++) {
+            Machine &theRegion = *mRegions[i];
+
+            mDriver->SetMachine(theRegion);
+
+            if (mDriver->HandleEvent(inEvent, theRegion.GetCurrentState()))
+                outHandled++;
+        }
+
+    } else {
+        // An event beyond every region's largest is never handled.
+
+        theWord = static_cast<size_t>(inEvent / kMaskBits);
+
+        if (theWord >= mAcceptedWords)
+            return (false);
+
+        theRow = mAcceptedEvents + theWord;
+        theBit = static_cast<Mask>(1) << (inEvent % kMaskBits);
+
+        for (i = 0; i < mCount; i++, theRow += mAcceptedWords) {
+            if ((*theRow & theBit) == 0)
+                continue;
+
+            Machine &theRegion = *mRegions[i];
+
+            mDriver->SetMachine(theRegion);
+
+            if (mDriver->HandleEvent(inEvent, theRegion.GetCurrentState()))
+                outHandled++;
+        }
+
+    }
+
+    return (outHandled > 0);
+}
+
+// Explicit Instantiations
+
+template class BasicComposite<uint8_t, uint8_t>;
+template class BasicComposite<uint16_t, uint16_t>;
+template class BasicComposite<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
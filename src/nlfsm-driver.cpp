@@ -75,6 +75,8 @@
  *
  */
 
+#include <stdint.h>
+
 #include <nlassert.h>
 
 #include <nestlabs/fsm/nlfsm-state-delegate-base.hpp>
@@ -93,9 +95,14 @@ namespace Fsm {
  *    instantiates the driver no state machine or event delegate
  *
  */
-Driver::Driver(void) :
+template <typename StateType, typename EventType>
+BasicDriver<StateType, EventType>::BasicDriver(void) :
     mMachine(NULL),
-    mDelegate(NULL)
+    mDelegate(NULL),
+    mDispatch(kDispatchDelegate),
+    mRecalling(false),
+    mOutputFunction(NULL),
+    mOutputContext(NULL)
 {
     return;
 }
@@ -112,14 +119,45 @@ Driver::Driver(void) :
  *                          with.
  *
  */
-Driver::Driver(Machine &inMachine, Delegate::Base *inDelegate) :
+template <typename StateType, typename EventType>
+BasicDriver<StateType, EventType>::BasicDriver(Machine &inMachine, Base *inDelegate) :
     mMachine(NULL),
-    mDelegate(NULL)
+    mDelegate(NULL),
+    mDispatch(kDispatchDelegate),
+    mRecalling(false),
+    mOutputFunction(NULL),
+    mOutputContext(NULL)
 {
     SetMachine(inMachine);
     SetDelegate(inDelegate);
 }
 
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the driver
+ *    with the specified state machine and constant-result delegate
+ *    tag.
+ *
+ *  @param[in]  inMachine   A reference to the state machine to instantiate
+ *                          with.
+ *  @param[in]  inConstant  The constant-result delegate tag to instantiate
+ *                          with.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicDriver<StateType, EventType>::BasicDriver(Machine &inMachine, Delegate::Constant inConstant) :
+    mMachine(NULL),
+    mDelegate(NULL),
+    mDispatch(kDispatchDelegate),
+    mRecalling(false),
+    mOutputFunction(NULL),
+    mOutputContext(NULL)
+{
+    SetMachine(inMachine);
+    SetDelegate(inConstant);
+}
+
 /**
  *
  *  @brief
@@ -129,11 +167,10 @@ Driver::Driver(Machine &inMachine, Delegate::Base *inDelegate) :
  *                         with.
  *
  */
+template <typename StateType, typename EventType>
 void
-Driver::SetMachine(Machine &inMachine)
+BasicDriver<StateType, EventType>::SetMachine(Machine &inMachine)
 {
-    nlCHECK(&inMachine != NULL);
-
     mMachine = &inMachine;
 }
 
@@ -145,8 +182,9 @@ Driver::SetMachine(Machine &inMachine)
  *  @return  The currently set state machine
  *
  */
-Machine *
-Driver::GetMachine()
+template <typename StateType, typename EventType>
+BasicMachine<StateType, EventType> *
+BasicDriver<StateType, EventType>::GetMachine()
 {
     return mMachine;
 }
@@ -160,10 +198,36 @@ Driver::GetMachine()
  *                          with.
  *
  */
+template <typename StateType, typename EventType>
 void
-Driver::SetDelegate(Delegate::Base *inDelegate)
+BasicDriver<StateType, EventType>::SetDelegate(Base *inDelegate)
 {
     mDelegate = inDelegate;
+    mDispatch = kDispatchDelegate;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is the setter for a constant-result delegate.
+ *
+ *  Rather than calling delegate methods whose results are known in
+ *  advance, the driver handles each event with a transition lookup
+ *  followed by either a state change (#Delegate::kConstantAlways) or
+ *  immediate failure (#Delegate::kConstantNever). Any previously-set
+ *  delegate object is cleared.
+ *
+ *  @param[in]  inConstant  The constant-result delegate tag to set.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicDriver<StateType, EventType>::SetDelegate(Delegate::Constant inConstant)
+{
+    mDelegate = NULL;
+    mDispatch = ((inConstant == Delegate::kConstantAlways) ?
+                 kDispatchAlways :
+                 kDispatchNever);
 }
 
 /**
@@ -171,15 +235,36 @@ Driver::SetDelegate(Delegate::Base *inDelegate)
  *  @brief
  *    This routine is the getter for the state machine
  *
- *  @return  The currently set delegate
+ *  @return  The currently set delegate, or NULL if no delegate or a
+ *           constant-result delegate tag is set.
  *
  */
-Delegate::Base *
-Driver::GetDelegate()
+template <typename StateType, typename EventType>
+Delegate::BasicBase<StateType, EventType> *
+BasicDriver<StateType, EventType>::GetDelegate()
 {
     return mDelegate;
 }
 
+/**
+ *
+ *  @brief
+ *    This routine sets the output sink, to which the output event of
+ *    each transition taken is passed.
+ *
+ *  @param[in]  inFunction  The function to pass outputs to, or NULL
+ *                          to discard them.
+ *  @param[in]  inContext   The context to call it with.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicDriver<StateType, EventType>::SetOutputSink(OutputFunction inFunction, void *inContext)
+{
+    mOutputFunction = inFunction;
+    mOutputContext  = inContext;
+}
+
 /**
  *
  *  @brief
@@ -195,8 +280,9 @@ Driver::GetDelegate()
  *           \c false.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Driver::HandleEvent(const Event &inEvent)
+BasicDriver<StateType, EventType>::HandleEvent(const Event &inEvent)
 {
     bool status = true;
 
@@ -219,24 +305,93 @@ Driver::HandleEvent(const Event &inEvent)
  *                               excitation event to handle.
  *  @param[in]  inCurrentState   A reference to the current state.
  *
- *  @return  \c true if the event was handled successfully; otherwise,
- *           \c false.
+ *  An event deferred in the current state is queued rather than
+ *  handled. After a change of state, any queued events are recalled
+ *  and handled in the new state.
+ *
+ *  @return  \c true if the event was handled, or deferred and queued,
+ *           successfully; otherwise, \c false.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Driver::HandleEvent(const Event &inEvent, const State &inCurrentState)
+BasicDriver<StateType, EventType>::HandleEvent(const Event &inEvent, const State &inCurrentState)
 {
     bool status = false;
     const Transition * theTransition = NULL;
+    const State theState = inCurrentState;
+    State nextState;
 
     nlPRECONDITION_VALUE(mMachine != NULL, false);
 
-    theTransition =
-        mMachine->FindTransition(inCurrentState, inEvent);
+    // A deferred event is only queued, to be recalled once the
+    // machine has left the state deferring it.
+
+    if (mMachine->IsEventDeferred(theState, inEvent))
+        return (mMachine->PushDeferredEvent(inEvent));
+
+    // A constant false delegate would veto the event in
+    // WillHandleEvent; there is no need to even find the transition.
+
+    nlEXPECT(mDispatch != kDispatchNever, done);
+
+    // A constant true delegate only needs the next state, unless
+    // there is an action, state handler or output to call or pass
+    // with the transition.
+    //
+    // Without guards or internal transition flags, the machine may
+    // find the next state with its event classes, without the
+    // transition, and the self-loop policy alone tells whether a
+    // self-loop stays in, rather than re-enters, the state. With
+    // either, the enabled transition is found, evaluating the guards
+    // only once, and tells both.
+
+    if ((mDispatch == kDispatchAlways) &&
+        !mMachine->HasActions() &&
+        !mMachine->HasStateHandlers() &&
+        !mMachine->HasOutputs())
+    {
+        if (!mMachine->HasGuards() && !mMachine->HasInternalTransitions()) {
+            status = mMachine->FindNextState(inCurrentState, inEvent, nextState);
+
+            if (status &&
+                ((nextState != theState) ||
+                 (mMachine->GetSelfLoopPolicy() != Machine::kSelfLoopInternal)))
+            {
+                mMachine->SetCurrentState(nextState);
+            }
+
+        } else {
+            theTransition =
+                mMachine->FindEnabledTransition(inCurrentState, inEvent);
 
-    if (theTransition != NULL)
-        status = HandleEvent(inEvent, inCurrentState, *theTransition);
+            status = (theTransition != NULL);
 
+            if (status && !mMachine->IsInternalTransition(*theTransition))
+                mMachine->SetCurrentState(theTransition->mEnd);
+
+        }
+
+    } else {
+        // With an accepted-event bitmap, the machine rejects an event
+        // not accepted in the current state with a single bit test.
+        // With guards, they are all evaluated here, before any
+        // delegate method.
+
+        theTransition =
+            mMachine->FindEnabledTransition(inCurrentState, inEvent);
+
+        if (theTransition != NULL)
+            status = HandleEvent(inEvent, inCurrentState, *theTransition);
+
+    }
+
+    if (status && !mRecalling &&
+        (mMachine->GetDeferredEventCount() > 0) &&
+        (mMachine->GetCurrentState() != theState))
+        Recall();
+
+ done:
     return (status);
 }
 
@@ -258,15 +413,55 @@ Driver::HandleEvent(const Event &inEvent, const State &inCurrentState)
  *           \c false.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Driver::HandleEvent(const Event &inEvent,
+BasicDriver<StateType, EventType>::HandleEvent(const Event &inEvent,
                     const State &inCurrentState,
                     const Transition &inTransition)
 {
     bool status = false;
     const State & nextState = inTransition.mEnd;
+    const typename Machine::Action * action;
+    const typename Machine::Action * onExit;
+    const typename Machine::Action * onEnter;
+    bool internal;
 
     nlPRECONDITION_VALUE(mMachine != NULL, false);
+
+    action = mMachine->GetAction(inTransition);
+
+    // An internal transition never leaves its state, so neither exits
+    // nor enters it.
+
+    internal = mMachine->IsInternalTransition(inTransition);
+
+    onExit  = internal ? NULL : mMachine->GetExitHandler(inTransition.mStart);
+    onEnter = internal ? NULL : mMachine->GetEnterHandler(nextState);
+
+    // With a constant-result delegate, the outcome of every delegate
+    // method is known in advance, so skip straight to it, calling
+    // only the state handlers and the transition's action, if any.
+
+    if (mDispatch == kDispatchAlways) {
+        if ((onExit != NULL) && !onExit->mFunction(inEvent, inTransition, onExit->mContext))
+            return (false);
+
+        if ((action != NULL) && !action->mFunction(inEvent, inTransition, action->mContext))
+            return (false);
+
+        if (!internal)
+            mMachine->SetCurrentState(nextState);
+
+        if ((onEnter != NULL) && !onEnter->mFunction(inEvent, inTransition, onEnter->mContext))
+            return (false);
+
+        return (Emit(inTransition));
+
+    } else if (mDispatch == kDispatchNever) {
+        return (false);
+
+    }
+
     nlPRECONDITION_VALUE(mDelegate != NULL, false);
 
     // The general event handling recipe is:
@@ -278,6 +473,12 @@ Driver::HandleEvent(const Event &inEvent,
     // Where the delegate method or state and/or transition handlers
     // can override/defeat any of these actions, both before and
     // after, by returning false status.
+    //
+    // An internal transition never leaves its state, so it skips
+    // steps 1) and 3). The starting state's exit handler, the
+    // transition's action and the ending state's entry handler, if
+    // any, are called in steps 1), 2) and 3), respectively, between
+    // the corresponding delegate methods.
 
     {
         status = mDelegate->WillHandleEvent(inEvent, inCurrentState);
@@ -285,10 +486,15 @@ Driver::HandleEvent(const Event &inEvent,
 
         // Exit the starting state
 
-        {
+        if (!internal) {
             status = mDelegate->WillExitState(inEvent, inTransition);
             nlEXPECT(status == true, done);
 
+            if (onExit != NULL) {
+                status = onExit->mFunction(inEvent, inTransition, onExit->mContext);
+                nlEXPECT(status == true, done);
+            }
+
             status = mDelegate->DidExitState(inEvent, inTransition);
             nlEXPECT(status == true, done);
         }
@@ -299,30 +505,156 @@ Driver::HandleEvent(const Event &inEvent,
             status = mDelegate->WillTransition(inEvent, inTransition);
             nlEXPECT(status == true, done);
 
+            if (action != NULL) {
+                status = action->mFunction(inEvent, inTransition, action->mContext);
+                nlEXPECT(status == true, done);
+            }
+
             status = mDelegate->DidTransition(inEvent, inTransition);
             nlEXPECT(status == true, done);
         }
 
         // Enter the ending state
 
-        {
+        if (!internal) {
             status = mDelegate->WillEnterState(inEvent, inTransition);
             nlEXPECT(status == true, done);
 
                 mMachine->SetCurrentState(nextState);
 
+            if (onEnter != NULL) {
+                status = onEnter->mFunction(inEvent, inTransition, onEnter->mContext);
+                nlEXPECT(status == true, done);
+            }
+
             status = mDelegate->DidEnterState(inEvent, inTransition);
             nlEXPECT(status == true, done);
         }
 
         status = mDelegate->DidHandleEvent(inEvent, inCurrentState);
         nlEXPECT(status == true, done);
+
+        // Pass on the transition's output, if any
+
+        status = Emit(inTransition);
+        nlEXPECT(status == true, done);
     }
 
  done:
     return (status);
 }
 
+/**
+ *
+ *  @brief
+ *    This routine handles the specified batch of state machine
+ *    excitation events, in order, each in the then-current state.
+ *
+ *  A batch, such as a buffer of events read at once from a byte
+ *  stream, is handled without any per-event call overhead beyond that
+ *  of handling the event itself, and not at all with a constant false
+ *  delegate. An event that fails to be handled does not stop the
+ *  batch.
+ *
+ *  @param[in]  inEvents  An array of the events to handle.
+ *  @param[in]  inCount   The number of events in the array.
+ *
+ *  @return  The number of events handled successfully.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicDriver<StateType, EventType>::HandleEvents(const Event inEvents[], size_t inCount)
+{
+    size_t theHandled = 0;
+    size_t i;
+
+    nlPRECONDITION_VALUE(mMachine != NULL, 0);
+
+    if (mDispatch == kDispatchNever)
+        return (0);
+
+    for (i = 0; i < inCount; i++) {
+        if (HandleEvent(inEvents[i], mMachine->GetCurrentState()))
+            theHandled++;
+    }
+
+    return (theHandled);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine recalls the events queued in the machine's deferral
+ *    queue following a change of state.
+ *
+ *  Each pass over the queue handles the queued events, oldest first,
+ *  in the then-current state. Those still deferred are queued again,
+ *  in order, and the others are handled or, failing that, dropped.
+ *  Passes repeat while the state changes and events remain queued.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicDriver<StateType, EventType>::Recall(void)
+{
+    Event  theEvent;
+    State  theState;
+    size_t theCount;
+    bool   theMoved;
+
+    mRecalling = true;
+
+    do {
+        theMoved = false;
+        theCount = mMachine->GetDeferredEventCount();
+
+        while ((theCount-- > 0) && mMachine->PopDeferredEvent(theEvent)) {
+            theState = mMachine->GetCurrentState();
+
+            // A still-deferred event is queued again, in the slot just
+            // freed, so this never fails.
+
+            HandleEvent(theEvent, theState);
+
+            if (mMachine->GetCurrentState() != theState)
+                theMoved = true;
+        }
+    } while (theMoved && (mMachine->GetDeferredEventCount() > 0));
+
+    mRecalling = false;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine passes the output event of the specified transition,
+ *    if any, to the output sink, if any.
+ *
+ *  @param[in]  inTransition  A reference to the transition taken.
+ *
+ *  @return  \c true if there was no output or sink or the sink
+ *           accepted the output; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicDriver<StateType, EventType>::Emit(const Transition &inTransition)
+{
+    Event theOutput;
+
+    if ((mOutputFunction == NULL) || !mMachine->GetOutput(inTransition, theOutput))
+        return (true);
+
+    return (mOutputFunction(theOutput, mOutputContext));
+}
+
+// Explicit Instantiations
+
+template class BasicDriver<uint8_t, uint8_t>;
+template class BasicDriver<uint16_t, uint16_t>;
+template class BasicDriver<uint32_t, uint32_t>;
+
 }; // namespace Fsm
 
 }; // namespace nl
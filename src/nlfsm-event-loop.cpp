@@ -0,0 +1,538 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for feeding finite state
+ *      machines (FSMs) events read from file descriptors by a Linux
+ *      epoll event loop.
+ *
+ */
+
+#include <nestlabs/fsm/nlfsm-event-loop.hpp>
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+
+namespace nl {
+
+namespace Fsm {
+
+// Preprocessor Definitions
+
+/**
+ *  The most descriptors reported ready by each wait.
+ */
+#define kReadyMax   16
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the loop,
+ *    closed and without source storage or a read buffer, feeding
+ *    events through the specified driver.
+ *
+ *  The driver is pointed at each machine in turn as its descriptor is
+ *  drained, so is left pointing at one of them.
+ *
+ *  @param[in]  inDriver  A reference to the driver to share.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicEventLoop<StateType, EventType>::BasicEventLoop(Driver &inDriver) :
+    mDriver(&inDriver),
+    mPoll(-1),
+    mSources(NULL),
+    mSize(0),
+    mCount(0),
+    mActive(0),
+    mBuffer(NULL),
+    mBufferSize(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is the class destructor. It closes the loop.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicEventLoop<StateType, EventType>::~BasicEventLoop(void)
+{
+    Close();
+}
+
+/**
+ *
+ *  @brief
+ *    This routine opens the loop, creating its epoll descriptor.
+ *
+ *  @return  \c true if the loop was opened; otherwise, \c false, if it
+ *           is already open or the descriptor could not be created.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::Open(void)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(mPoll < 0, done, retval = false);
+
+    mPoll = epoll_create1(EPOLL_CLOEXEC);
+    nlREQUIRE_ACTION(mPoll >= 0, done, retval = false);
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine closes the loop, closing its epoll descriptor and
+ *    discarding every source. The sources' descriptors are left open.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicEventLoop<StateType, EventType>::Close(void)
+{
+    if (mPoll >= 0) {
+        close(mPoll);
+        mPoll = -1;
+    }
+
+    mCount  = 0;
+    mActive = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine allocates sources from the specified storage.
+ *
+ *  The storage must remain valid until the loop is closed or the
+ *  storage is next set.
+ *
+ *  @param[in,out]  ioSources  Storage for the sources.
+ *  @param[in]      inCount    The number of sources available in the
+ *                             storage.
+ *
+ *  @return  \c true if the storage was set; otherwise, \c false, if
+ *           any sources are added, in which case any existing storage
+ *           is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::SetSources(Source ioSources[], size_t inCount)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(ioSources != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inCount > 0, done, retval = false);
+    nlREQUIRE_ACTION(mActive == 0, done, retval = false);
+
+    mSources = ioSources;
+    mSize    = inCount;
+    mCount   = 0;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the buffer into which stream sources are read,
+ *    the most events handled in each batch.
+ *
+ *  The buffer must remain valid until it is next set.
+ *
+ *  @param[in,out]  ioBuffer  Storage for the buffer.
+ *  @param[in]      inSize    The number of events available in the
+ *                            storage.
+ *
+ *  @return  \c true if the buffer was set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::SetBuffer(Event ioBuffer[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(ioBuffer != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize > 0, done, retval = false);
+
+    mBuffer     = ioBuffer;
+    mBufferSize = inSize;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of sources added and not yet
+ *    removed.
+ *
+ *  @return  The number of sources.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicEventLoop<StateType, EventType>::GetSourceCount(void) const
+{
+    return (mActive);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine adds a stream source, such as a pipe or socket,
+ *    feeding the events read from the specified descriptor to the
+ *    specified machine.
+ *
+ *  @param[in]   inDescriptor  The descriptor to read, made
+ *                             non-blocking.
+ *  @param[in]   inMachine     A reference to the machine to feed.
+ *  @param[out]  outSource     The source added, to remove it with.
+ *
+ *  @return  \c true if the source was added; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::AddStream(int inDescriptor, Machine &inMachine, size_t &outSource)
+{
+    return (Add(inDescriptor, inMachine, false, Event(), outSource));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine adds a counter source, such as an eventfd or
+ *    timerfd, feeding the specified event to the specified machine as
+ *    many times as counted by the specified descriptor.
+ *
+ *  @param[in]   inDescriptor  The descriptor to read, made
+ *                             non-blocking.
+ *  @param[in]   inMachine     A reference to the machine to feed.
+ *  @param[in]   inEvent       A reference to the event counted.
+ *  @param[out]  outSource     The source added, to remove it with.
+ *
+ *  @return  \c true if the source was added; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::AddCounter(int inDescriptor, Machine &inMachine, const Event &inEvent, size_t &outSource)
+{
+    return (Add(inDescriptor, inMachine, true, inEvent, outSource));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine removes the specified source from the loop, leaving
+ *    its descriptor open.
+ *
+ *  A stream source is removed automatically at the end of its stream
+ *  and any source on a read error. The storage of a removed source is
+ *  reused by the next source added.
+ *
+ *  @param[in]  inSource  The source to remove.
+ *
+ *  @return  \c true if the source was removed; otherwise, \c false, if
+ *           there is no such source or it was already removed.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::Remove(size_t inSource)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(inSource < mCount, done, retval = false);
+    nlREQUIRE_ACTION(mSources[inSource].mDescriptor >= 0, done, retval = false);
+
+    epoll_ctl(mPoll, EPOLL_CTL_DEL, mSources[inSource].mDescriptor, NULL);
+
+    mSources[inSource].mDescriptor = -1;
+
+    mActive--;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine waits for, and drains, any ready sources, feeding
+ *    their events to their machines.
+ *
+ *  @param[in]   inTimeout   The most milliseconds to wait for a ready
+ *                           source, zero to not wait or -1 to wait
+ *                           indefinitely.
+ *  @param[out]  outHandled  The number of events handled successfully.
+ *
+ *  @return  \c true if the wait succeeded or was interrupted;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::Poll(int inTimeout, size_t &outHandled)
+{
+    struct epoll_event theReady[kReadyMax];
+    int                theCount;
+    int                i;
+    bool               retval = true;
+
+    outHandled = 0;
+
+    nlREQUIRE_ACTION(mPoll >= 0, done, retval = false);
+    nlREQUIRE_ACTION(mBuffer != NULL, done, retval = false);
+
+    theCount = epoll_wait(mPoll, theReady, kReadyMax, inTimeout);
+    nlREQUIRE_ACTION((theCount >= 0) || (errno == EINTR), done, retval = false);
+
+    for (i = 0; i < theCount; i++) {
+        const size_t theSource = static_cast<size_t>(theReady[i].data.u64);
+
+        // An earlier source in the batch may have removed this one.
+
+        if (mSources[theSource].mDescriptor < 0)
+            continue;
+
+        if (mSources[theSource].mCounter)
+            DrainCounter(theSource, outHandled);
+        else
+            DrainStream(theSource, ((theReady[i].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR)) != 0), outHandled);
+    }
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine adds a source feeding the specified machine from the
+ *    specified descriptor, registered edge-triggered.
+ *
+ *  The storage of the first removed source, if any, is reused;
+ *  otherwise, that of the next never used.
+ *
+ *  @param[in]   inDescriptor  The descriptor to read, made
+ *                             non-blocking.
+ *  @param[in]   inMachine     A reference to the machine to feed.
+ *  @param[in]   inCounter     Whether the descriptor carries a count
+ *                             of events rather than the events.
+ *  @param[in]   inEvent       A reference to the event counted, for a
+ *                             counter source.
+ *  @param[out]  outSource     The source added.
+ *
+ *  @return  \c true if the source was added; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicEventLoop<StateType, EventType>::Add(int inDescriptor, Machine &inMachine, bool inCounter, const Event &inEvent, size_t &outSource)
+{
+    struct epoll_event theEvent;
+    size_t             theSource;
+    int                theFlags;
+    int                status;
+    bool               retval = true;
+
+    nlREQUIRE_ACTION(mPoll >= 0, done, retval = false);
+    nlREQUIRE_ACTION(inDescriptor >= 0, done, retval = false);
+    nlREQUIRE_ACTION(mActive < mSize, done, retval = false);
+
+    // Every source below the count is in use unless fewer are active.
+
+    theSource = mCount;
+
+    if (mActive < mCount) {
+        for (theSource = 0; mSources[theSource].mDescriptor >= 0; theSource++)
+            continue;
+    }
+
+    theFlags = fcntl(inDescriptor, F_GETFL);
+    nlREQUIRE_ACTION(theFlags >= 0, done, retval = false);
+
+    status = fcntl(inDescriptor, F_SETFL, theFlags | O_NONBLOCK);
+    nlREQUIRE_ACTION(status == 0, done, retval = false);
+
+    theEvent.events   = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    theEvent.data.u64 = theSource;
+
+    status = epoll_ctl(mPoll, EPOLL_CTL_ADD, inDescriptor, &theEvent);
+    nlREQUIRE_ACTION(status == 0, done, retval = false);
+
+    mSources[theSource].mDescriptor   = inDescriptor;
+    mSources[theSource].mMachine      = &inMachine;
+    mSources[theSource].mCounter      = inCounter;
+    mSources[theSource].mEvent        = inEvent;
+    mSources[theSource].mPartialBytes = 0;
+
+    if (theSource == mCount)
+        mCount++;
+
+    mActive++;
+
+    outSource = theSource;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine drains the specified stream source, handling each
+ *    buffer of events read as a batch.
+ *
+ *  A read shorter than the buffer leaves the stream empty, so stops
+ *  the drain without a further read to be told so, unless the stream
+ *  has been hung up, in which case it is read to its end and removed.
+ *
+ *  The bytes of a wider event split across reads are kept with the
+ *  source and placed ahead of the next read, to complete the event,
+ *  so the events read stay aligned.
+ *
+ *  @param[in]      inSource   The source to drain.
+ *  @param[in]      inHangUp   Whether the stream has been hung up.
+ *  @param[in,out]  ioHandled  The number of events handled
+ *                             successfully, incremented by those
+ *                             drained.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicEventLoop<StateType, EventType>::DrainStream(size_t inSource, bool inHangUp, size_t &ioHandled)
+{
+    Source &        theSource = mSources[inSource];
+    uint8_t * const theBuffer = reinterpret_cast<uint8_t *>(mBuffer);
+    const size_t    theBytes  = mBufferSize * sizeof (Event);
+    size_t          theCarried;
+    size_t          theTotal;
+    ssize_t         theRead;
+
+    mDriver->SetMachine(*theSource.mMachine);
+
+    while (true) {
+        theCarried = theSource.mPartialBytes;
+
+        memcpy(theBuffer, theSource.mPartial, theCarried);
+
+        theRead = read(theSource.mDescriptor, theBuffer + theCarried, theBytes - theCarried);
+
+        if (theRead > 0) {
+            theTotal = theCarried + static_cast<size_t>(theRead);
+
+            theSource.mPartialBytes = theTotal % sizeof (Event);
+
+            memcpy(theSource.mPartial, theBuffer + theTotal - theSource.mPartialBytes, theSource.mPartialBytes);
+
+            ioHandled += mDriver->HandleEvents(mBuffer, theTotal / sizeof (Event));
+
+            if ((static_cast<size_t>(theRead) < (theBytes - theCarried)) && !inHangUp)
+                break;
+
+        } else if ((theRead < 0) && (errno == EINTR)) {
+            continue;
+
+        } else {
+            if ((theRead == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK)))
+                Remove(inSource);
+
+            break;
+
+        }
+    }
+}
+
+/**
+ *
+ *  @brief
+ *    This routine drains the specified counter source, whose single
+ *    read resets its count, handling its event as many times as
+ *    counted.
+ *
+ *  @param[in]      inSource   The source to drain.
+ *  @param[in,out]  ioHandled  The number of events handled
+ *                             successfully, incremented by those
+ *                             drained.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicEventLoop<StateType, EventType>::DrainCounter(size_t inSource, size_t &ioHandled)
+{
+    const Source & theSource = mSources[inSource];
+    uint64_t       theCount;
+    ssize_t        theRead;
+
+    do {
+        theRead = read(theSource.mDescriptor, &theCount, sizeof (theCount));
+    } while ((theRead < 0) && (errno == EINTR));
+
+    if (theRead != static_cast<ssize_t>(sizeof (theCount))) {
+        if ((theRead >= 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK)))
+            Remove(inSource);
+
+        return;
+    }
+
+    mDriver->SetMachine(*theSource.mMachine);
+
+    while (theCount-- > 0) {
+        if (mDriver->HandleEvent(theSource.mEvent, theSource.mMachine->GetCurrentState()))
+            ioHandled++;
+    }
+}
+
+// Explicit Instantiations
+
+template class BasicEventLoop<uint8_t, uint8_t>;
+template class BasicEventLoop<uint16_t, uint16_t>;
+template class BasicEventLoop<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
+
+#endif // defined(__linux__)
@@ -0,0 +1,436 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for expanding the wildcard
+ *      transitions of a finite state machine (FSM) transition table
+ *      into explicit ones.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-expander.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+namespace nl {
+
+namespace Fsm {
+
+// Preprocessor Definitions
+
+/**
+ *  The value indicating that no transition matches.
+ */
+#define kWordNone   UINT32_MAX
+
+// Type Definitions
+
+/**
+ *
+ *  @class ValueOrder
+ *
+ *  @brief
+ *   Heap sort predicate object that orders values.
+ *
+ */
+class ValueOrder
+{
+ public:
+    bool operator ()(uint32_t inFirst, uint32_t inSecond) const
+    {
+        return (inFirst < inSecond);
+    }
+};
+
+// Global Functions
+
+/**
+ *
+ *  @brief
+ *    This function sorts and removes duplicates from the specified
+ *    values in place.
+ *
+ *  @return  The number of distinct values.
+ *
+ */
+static size_t
+Unique(uint32_t ioValues[], size_t inCount)
+{
+    size_t i, j;
+
+    HeapSort(ioValues, inCount, ValueOrder());
+
+    for (i = 0, j = 0; i < inCount; i++) {
+        if ((j == 0) || (ioValues[j - 1] != ioValues[i]))
+            ioValues[j++] = ioValues[i];
+    }
+
+    return (j);
+}
+
+/**
+ *
+ *  @brief
+ *    This function finds the offset of the first transition with the
+ *    specified starting state and event among the specified sorted
+ *    transition table offsets.
+ *
+ *  @return  The offset of the first matching transition, or
+ *           kWordNone if there is none.
+ *
+ */
+template <typename Transition>
+static uint32_t
+FindFirst(const Transition inTransitions[],
+          const uint32_t inArcs[],
+          size_t inCount,
+          const typename Transition::State &inState,
+          const typename Transition::Event &inEvent)
+{
+    size_t theLow  = 0;
+    size_t theHigh = inCount;
+
+    while (theLow < theHigh) {
+        const size_t      theMiddle     = theLow + ((theHigh - theLow) / 2);
+        const Transition &theTransition = inTransitions[inArcs[theMiddle]];
+
+        if ((theTransition.mStart < inState) ||
+            ((theTransition.mStart == inState) && (theTransition.mEvent < inEvent)))
+            theLow = theMiddle + 1;
+        else
+            theHigh = theMiddle;
+    }
+
+    if ((theLow < inCount) &&
+        (inTransitions[inArcs[theLow]].mStart == inState) &&
+        (inTransitions[inArcs[theLow]].mEvent == inEvent))
+        return (inArcs[theLow]);
+
+    return (kWordNone);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is the class default (i.e. void) constructor. It
+ *    instantiates the expander without workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicExpander<StateType, EventType>::BasicExpander(void) :
+    mWorkspace(NULL),
+    mSize(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the
+ *    expander with the specified workspace.
+ *
+ *  @param[in]  inWorkspace  The workspace to expand within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicExpander<StateType, EventType>::BasicExpander(Word inWorkspace[], size_t inSize) :
+    mWorkspace(inWorkspace),
+    mSize(inSize)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the workspace to expand within.
+ *
+ *  @param[in]  inWorkspace  The workspace to expand within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicExpander<StateType, EventType>::SetWorkspace(Word inWorkspace[], size_t inSize)
+{
+    mWorkspace = inWorkspace;
+    mSize      = inSize;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of workspace required to
+ *    expand a transition table with the specified number of
+ *    transitions.
+ *
+ *  @param[in]  inCount  The number of transitions in the table.
+ *
+ *  @return  The number of words required, or zero if the table is too
+ *           large to expand.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicExpander<StateType, EventType>::GetWorkspaceSize(size_t inCount)
+{
+    if ((inCount >= (UINT32_MAX - 1)) || (inCount >= (SIZE_MAX / 16)))
+        return (0);
+
+    // Sorted arcs; distinct states; and distinct events.
+
+    return ((inCount > 0) ? (4 * inCount) : 1);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the specified transition has a
+ *    wildcard starting state or event.
+ *
+ *  @param[in]  inTransition  A reference to the transition.
+ *
+ *  @return  \c true if the transition is a wildcard transition;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicExpander<StateType, EventType>::IsWildcard(const Transition &inTransition)
+{
+    return ((inTransition.mStart == static_cast<State>(Transition::kAnyState)) ||
+            (inTransition.mEvent == static_cast<Event>(Transition::kAnyEvent)));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of transitions in the expansion of
+ *    the specified transition table.
+ *
+ *  @param[in]   inTransitions  The transition table to expand.
+ *  @param[in]   inCount        The number of transitions in the table.
+ *  @param[out]  outCount       The number of transitions in the
+ *                              expanded table.
+ *
+ *  @return  \c true if the table may be expanded; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicExpander<StateType, EventType>::GetExpandedCount(const Transition inTransitions[],
+                                                      size_t inCount,
+                                                      size_t &outCount) const
+{
+    return (Run(inTransitions, inCount, NULL, 0, outCount));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine expands the wildcard transitions of the specified
+ *    transition table into explicit ones.
+ *
+ *  Since the expanded table is generally the larger, it may not be
+ *  the table to expand itself. Any per-transition storage for the
+ *  machine, such as actions or guards, is for the expanded table.
+ *
+ *  @param[in]      inTransitions   The transition table to expand.
+ *  @param[in]      inCount         The number of transitions in the
+ *                                  table.
+ *  @param[out]     outTransitions  Storage for the expanded table.
+ *  @param[in,out]  ioCount         On input, the number of transitions
+ *                                  available in the expanded table
+ *                                  storage; on output, the number of
+ *                                  transitions in the expanded table.
+ *
+ *  @return  \c true if the table was expanded; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicExpander<StateType, EventType>::Expand(const Transition inTransitions[],
+                                            size_t inCount,
+                                            Transition outTransitions[],
+                                            size_t &ioCount) const
+{
+    size_t theCount = 0;
+    bool   retval;
+
+    nlREQUIRE_ACTION(outTransitions != NULL, done, retval = false);
+    nlREQUIRE_ACTION(outTransitions != inTransitions, done, retval = false);
+
+    retval = Run(inTransitions, inCount, outTransitions, ioCount, theCount);
+    nlREQUIRE(retval, done);
+
+    ioCount = theCount;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine expands the specified transition table, either
+ *    into the specified storage or, if none, only counting the
+ *    expanded transitions.
+ *
+ *  @param[in]   inTransitions   The transition table to expand.
+ *  @param[in]   inCount         The number of transitions in the
+ *                               table.
+ *  @param[out]  outTransitions  Storage for the expanded table, or
+ *                               NULL to only count.
+ *  @param[in]   inSize          The number of transitions available
+ *                               in the storage.
+ *  @param[out]  outCount        The number of transitions in the
+ *                               expanded table.
+ *
+ *  @return  \c true if the table was expanded; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicExpander<StateType, EventType>::Run(const Transition inTransitions[],
+                                         size_t inCount,
+                                         Transition outTransitions[],
+                                         size_t inSize,
+                                         size_t &outCount) const
+{
+    const State  theAnyState = static_cast<State>(Transition::kAnyState);
+    const Event  theAnyEvent = static_cast<Event>(Transition::kAnyEvent);
+    const size_t theSize     = GetWorkspaceSize(inCount);
+    uint32_t *   theArcs;
+    uint32_t *   theStates;
+    uint32_t *   theEvents;
+    size_t       theStateCount = 0;
+    size_t       theEventCount = 0;
+    size_t       i, j, k;
+    bool         retval = true;
+
+    outCount = 0;
+
+    nlREQUIRE_ACTION((inTransitions != NULL) || (inCount == 0), done, retval = false);
+    nlREQUIRE_ACTION(mWorkspace != NULL, done, retval = false);
+    nlREQUIRE_ACTION(theSize > 0, done, retval = false);
+    nlREQUIRE_ACTION(mSize >= theSize, done, retval = false);
+
+    // Carve the workspace.
+
+    theArcs   = mWorkspace;
+    theStates = theArcs + inCount;
+    theEvents = theStates + (2 * inCount);
+
+    // Gather the explicit states and events, which the wildcards
+    // match, and sort the transitions by starting state and event,
+    // with the wildcards last.
+
+    for (i = 0; i < inCount; i++) {
+        const Transition &theTransition = inTransitions[i];
+
+        nlREQUIRE_ACTION(theTransition.mEnd != theAnyState, done, retval = false);
+
+        theArcs[i] = static_cast<uint32_t>(i);
+        theStates[theStateCount++] = theTransition.mEnd;
+
+        if (theTransition.mStart != theAnyState)
+            theStates[theStateCount++] = theTransition.mStart;
+
+        if (theTransition.mEvent != theAnyEvent)
+            theEvents[theEventCount++] = theTransition.mEvent;
+    }
+
+    HeapSort(theArcs, inCount, ArcOrder<Transition>(inTransitions));
+
+    theStateCount = Unique(theStates, theStateCount);
+    theEventCount = Unique(theEvents, theEventCount);
+
+    for (i = 0; i < inCount; i++) {
+        const Transition &theTransition = inTransitions[i];
+        const bool        theAnyStart   = (theTransition.mStart == theAnyState);
+        const bool        theAnyInput   = (theTransition.mEvent == theAnyEvent);
+
+        if (!theAnyStart && !theAnyInput) {
+            if (outTransitions != NULL) {
+                nlREQUIRE_ACTION(outCount < inSize, done, retval = false);
+
+                outTransitions[outCount] = theTransition;
+            }
+
+            outCount++;
+            continue;
+        }
+
+        // A later wildcard transition of the same pattern never wins.
+
+        if (FindFirst(inTransitions, theArcs, inCount, theTransition.mStart, theTransition.mEvent) != i)
+            continue;
+
+        for (j = 0; j < (theAnyStart ? theStateCount : 1); j++) {
+            const State theState = theAnyStart ? static_cast<State>(theStates[j]) : theTransition.mStart;
+
+            for (k = 0; k < (theAnyInput ? theEventCount : 1); k++) {
+                const Event theEvent = theAnyInput ? static_cast<Event>(theEvents[k]) : theTransition.mEvent;
+
+                // Skip the pairs matched by a more specific transition.
+
+                if (FindFirst(inTransitions, theArcs, inCount, theState, theEvent) != kWordNone)
+                    continue;
+
+                if (theAnyStart &&
+                    (FindFirst(inTransitions, theArcs, inCount, theState, theAnyEvent) != kWordNone))
+                    continue;
+
+                if (theAnyStart && theAnyInput &&
+                    (FindFirst(inTransitions, theArcs, inCount, theAnyState, theEvent) != kWordNone))
+                    continue;
+
+                if (outTransitions != NULL) {
+                    nlREQUIRE_ACTION(outCount < inSize, done, retval = false);
+
+                    outTransitions[outCount].mStart = theState;
+                    outTransitions[outCount].mEvent = theEvent;
+                    outTransitions[outCount].mEnd   = theTransition.mEnd;
+                }
+
+                outCount++;
+            }
+        }
+    }
+
+ done:
+    return (retval);
+}
+
+// Explicit Instantiations
+
+template class BasicExpander<uint8_t, uint8_t>;
+template class BasicExpander<uint16_t, uint16_t>;
+template class BasicExpander<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
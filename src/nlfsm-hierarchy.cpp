@@ -0,0 +1,692 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for driving a finite state
+ *      machine (FSM) as a hierarchical state machine (HSM), in which
+ *      states have parents and inherit their transitions.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-hierarchy.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-state-delegate-base.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+namespace Fsm {
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the
+ *    hierarchy over the specified machine with the specified parents,
+ *    without workspace or a delegate.
+ *
+ *  @param[in]  inMachine  A reference to the machine to drive.
+ *  @param[in]  inParents  The parent of each state, by state, or the
+ *                         state itself for a top-level state.
+ *  @param[in]  inStates   The number of states in the hierarchy.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicHierarchy<StateType, EventType>::BasicHierarchy(Machine &inMachine,
+                                                     const State inParents[],
+                                                     size_t inStates) :
+    mMachine(&inMachine),
+    mDelegate(NULL),
+    mOutputFunction(NULL),
+    mOutputContext(NULL),
+    mParents(inParents),
+    mStates(inStates),
+    mDepths(NULL),
+    mArcs(NULL),
+    mPaths(NULL),
+    mCount(0),
+    mRecalling(false)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is the setter for the delegate.
+ *
+ *  @param[in]  inDelegate  A pointer to the event delegate to call, or
+ *                          NULL for none.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicHierarchy<StateType, EventType>::SetDelegate(Base *inDelegate)
+{
+    mDelegate = inDelegate;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is the getter for the delegate.
+ *
+ *  @return  The currently set delegate, or NULL if none is set.
+ *
+ */
+template <typename StateType, typename EventType>
+Delegate::BasicBase<StateType, EventType> *
+BasicHierarchy<StateType, EventType>::GetDelegate()
+{
+    return mDelegate;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the output sink, to which the output event of
+ *    each transition taken is passed.
+ *
+ *  @param[in]  inFunction  The function to pass outputs to, or NULL
+ *                          to discard them.
+ *  @param[in]  inContext   The context to call it with.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicHierarchy<StateType, EventType>::SetOutputSink(OutputFunction inFunction, void *inContext)
+{
+    mOutputFunction = inFunction;
+    mOutputContext  = inContext;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of workspace required to
+ *    hold the state depths and the exit and entry paths of each
+ *    transition of the machine's current transition table.
+ *
+ *  @return  The number of words required, or zero if the parents do
+ *           not form a hierarchy or the table has a state outside of
+ *           it.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicHierarchy<StateType, EventType>::GetWorkspaceSize(void) const
+{
+    const Transition * theTransitions;
+    size_t             theCount;
+    size_t             theSize;
+    size_t             i;
+
+    if ((mParents == NULL) || (mStates == 0) || (mStates >= UINT32_MAX))
+        return (0);
+
+    for (i = 0; i < mStates; i++) {
+        if (Walk(static_cast<State>(i)) == SIZE_MAX)
+            return (0);
+    }
+
+    theTransitions = mMachine->GetTransitions(theCount);
+
+    if ((theCount >= UINT32_MAX) || (theCount >= (SIZE_MAX / 2 / mStates)))
+        return (0);
+
+    // State depths; exit depths and entry path offsets; and entry
+    // paths.
+
+    theSize = mStates + (2 * theCount);
+
+    for (i = 0; i < theCount; i++) {
+        const Transition &theTransition = theTransitions[i];
+
+        if ((theTransition.mStart >= mStates) || (theTransition.mEnd >= mStates))
+            return (0);
+
+        theSize += Walk(theTransition.mEnd) - GetExitDepth(theTransition) + 1;
+    }
+
+    return (theSize);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine computes the state depths and the exit and entry
+ *    paths of each transition of the machine's current transition
+ *    table in the specified workspace, after which the hierarchy may
+ *    handle events.
+ *
+ *  The workspace must remain valid, and be computed again, until the
+ *  machine's transition table is next set.
+ *
+ *  @param[in,out]  ioWorkspace  The workspace to compute in.
+ *  @param[in]      inSize       The number of words in the
+ *                               workspace, at least that returned by
+ *                               #GetWorkspaceSize.
+ *
+ *  @return  \c true if the paths were computed; otherwise, \c false,
+ *           in which case any previous paths are unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicHierarchy<StateType, EventType>::SetWorkspace(Word ioWorkspace[], size_t inSize)
+{
+    const size_t       theSize = GetWorkspaceSize();
+    const Transition * theTransitions;
+    size_t             theCount;
+    Word *             theArcs;
+    Word *             thePaths;
+    size_t             theOffset = 0;
+    size_t             i;
+    bool               retval = true;
+
+    nlREQUIRE_ACTION(ioWorkspace != NULL, done, retval = false);
+    nlREQUIRE_ACTION(theSize > 0, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= theSize, done, retval = false);
+
+    theTransitions = mMachine->GetTransitions(theCount);
+
+    // Carve the workspace.
+
+    theArcs  = ioWorkspace + mStates;
+    thePaths = theArcs + (2 * theCount);
+
+    for (i = 0; i < mStates; i++)
+        ioWorkspace[i] = static_cast<Word>(Walk(static_cast<State>(i)));
+
+    // Store each transition's exit depth and its entry path, down
+    // from that depth to the ending state.
+
+    for (i = 0; i < theCount; i++) {
+        const size_t theExitDepth = GetExitDepth(theTransitions[i]);
+        const size_t theLength    = ioWorkspace[theTransitions[i].mEnd] - theExitDepth + 1;
+        State        theState     = theTransitions[i].mEnd;
+        size_t       j;
+
+        theArcs[(2 * i)]     = static_cast<Word>(theExitDepth);
+        theArcs[(2 * i) + 1] = static_cast<Word>(theOffset);
+
+        for (j = theLength; j > 0; j--) {
+            thePaths[theOffset + j - 1] = theState;
+            theState = mParents[theState];
+        }
+
+        theOffset += theLength;
+    }
+
+    mDepths = ioWorkspace;
+    mArcs   = theArcs;
+    mPaths  = thePaths;
+    mCount  = theCount;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the depth of the specified state in the
+ *    hierarchy, zero for a top-level state.
+ *
+ *  @param[in]  inState  A reference to the state.
+ *
+ *  @return  The depth of the state, or SIZE_MAX if it is outside of
+ *           the hierarchy.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicHierarchy<StateType, EventType>::GetDepth(const State &inState) const
+{
+    if (mDepths == NULL)
+        return (Walk(inState));
+
+    if (inState >= mStates)
+        return (SIZE_MAX);
+
+    return (mDepths[inState]);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the first specified state is
+ *    the second or one of its ancestors.
+ *
+ *  @param[in]  inAncestor  A reference to the candidate ancestor.
+ *  @param[in]  inState     A reference to the state.
+ *
+ *  @return  \c true if the first state contains the second;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicHierarchy<StateType, EventType>::IsAncestor(const State &inAncestor, const State &inState) const
+{
+    const size_t theAncestorDepth = GetDepth(inAncestor);
+    size_t       theDepth         = GetDepth(inState);
+    State        theState         = inState;
+
+    if ((theAncestorDepth == SIZE_MAX) || (theDepth == SIZE_MAX))
+        return (false);
+
+    while (theDepth > theAncestorDepth) {
+        theState = mParents[theState];
+        theDepth--;
+    }
+
+    return (theState == inAncestor);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine attempts to find the enabled transition for the
+ *    specified event out of the specified state or, failing that, out
+ *    of its nearest ancestor with one.
+ *
+ *  @param[in]  inState  A reference to the state to find a transition
+ *                       for.
+ *  @param[in]  inEvent  A reference to the event to find a transition
+ *                       for.
+ *
+ *  @return  A pointer to the transition if successful; otherwise,
+ *           NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicHierarchy<StateType, EventType>::FindTransition(const State &inState, const Event &inEvent) const
+{
+    const Transition * theTransition;
+    State              theState = inState;
+
+    while ((theTransition = mMachine->FindEnabledTransition(theState, inEvent)) == NULL) {
+        if ((theState >= mStates) || (mParents[theState] == theState))
+            break;
+
+        theState = mParents[theState];
+    }
+
+    return (theTransition);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine handles the specified event by taking the machine
+ *    through the transition found for it, exiting and entering states
+ *    along the transition's precomputed paths, or by deferring it.
+ *
+ *  @param[in]  inEvent  A reference to the event to handle.
+ *
+ *  @return  \c true if the event was handled or deferred successfully;
+ *           otherwise, \c false, if there was no transition for the
+ *           event, the deferral queue was full, the delegate, a
+ *           handler or an action aborted it or the output sink did not
+ *           accept the output.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicHierarchy<StateType, EventType>::HandleEvent(const Event &inEvent)
+{
+    const State        theCurrentState = mMachine->GetCurrentState();
+    const Transition * theTransition;
+    bool               deferred;
+    bool               status = false;
+
+    nlPRECONDITION_VALUE(mDepths != NULL, false);
+
+    nlEXPECT(theCurrentState < mStates, done);
+
+    theTransition = Resolve(theCurrentState, inEvent, deferred);
+
+    // A deferred event is only queued, to be recalled once the
+    // machine has left the state deferring it.
+
+    if (deferred)
+        return (mMachine->PushDeferredEvent(inEvent));
+
+    nlEXPECT(theTransition != NULL, done);
+
+    status = Take(inEvent, theCurrentState, *theTransition);
+
+    // Recall deferred events once the state has changed, unless
+    // already recalling them.
+
+    if (status &&
+        !mRecalling &&
+        (mMachine->GetDeferredEventCount() > 0) &&
+        (mMachine->GetCurrentState() != theCurrentState))
+    {
+        Recall();
+    }
+
+ done:
+    return (status);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine attempts to find the enabled transition for the
+ *    specified event out of the specified state or its nearest
+ *    ancestor with one, noting whether a state on the way defers the
+ *    event instead.
+ *
+ *  @param[in]   inState      A reference to the state to find a
+ *                            transition for.
+ *  @param[in]   inEvent      A reference to the event to find a
+ *                            transition for.
+ *  @param[out]  outDeferred  Set to \c true if the state, or an
+ *                            ancestor nearer than any with a
+ *                            transition, defers the event; otherwise,
+ *                            \c false.
+ *
+ *  @return  A pointer to the transition if one was found before any
+ *           deferring state; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicHierarchy<StateType, EventType>::Resolve(const State &inState, const Event &inEvent, bool &outDeferred) const
+{
+    const Transition * theTransition;
+    State              theState = inState;
+
+    outDeferred = false;
+
+    while ((theTransition = mMachine->FindEnabledTransition(theState, inEvent)) == NULL) {
+        if (mMachine->IsEventDeferred(theState, inEvent)) {
+            outDeferred = true;
+            break;
+        }
+
+        if ((theState >= mStates) || (mParents[theState] == theState))
+            break;
+
+        theState = mParents[theState];
+    }
+
+    return (theTransition);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine takes the machine through the specified transition
+ *    for the specified event, calling the delegate's hooks, if any,
+ *    around the exit walk, action and entry walk, and then passes on
+ *    the transition's output.
+ *
+ *  @param[in]  inEvent       A reference to the event being handled.
+ *  @param[in]  inState       A reference to the state the event is
+ *                            handled in.
+ *  @param[in]  inTransition  A reference to the transition to take.
+ *
+ *  @return  \c true if the transition was taken successfully;
+ *           otherwise, \c false, if the delegate, a handler or the
+ *           action aborted it or the output sink did not accept the
+ *           output.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicHierarchy<StateType, EventType>::Take(const Event &inEvent, const State &inState, const Transition &inTransition)
+{
+    const Transition *               theFirst;
+    const typename Machine::Action * theHandler;
+    size_t                           theCount;
+    size_t                           theOffset;
+    size_t                           theDepth;
+    State                            theState;
+    const Word *                     thePath;
+    Event                            theOutput;
+    bool                             internal;
+    bool                             status = false;
+
+    theFirst  = mMachine->GetTransitions(theCount);
+    theOffset = static_cast<size_t>(&inTransition - theFirst);
+
+    nlEXPECT(theOffset < mCount, done);
+
+    internal = mMachine->IsInternalTransition(inTransition);
+
+    status = ((mDelegate == NULL) || mDelegate->WillHandleEvent(inEvent, inState));
+    nlEXPECT(status == true, done);
+
+    // Exit the current state and its ancestors up to the exit depth.
+
+    if (!internal) {
+        status = ((mDelegate == NULL) || mDelegate->WillExitState(inEvent, inTransition));
+        nlEXPECT(status == true, done);
+
+        theState = inState;
+
+        for (theDepth = mDepths[inState] + 1; theDepth > mArcs[2 * theOffset]; theDepth--) {
+            theHandler = mMachine->GetExitHandler(theState);
+
+            if (theHandler != NULL) {
+                status = theHandler->mFunction(inEvent, inTransition, theHandler->mContext);
+                nlEXPECT(status == true, done);
+            }
+
+            theState = mParents[theState];
+        }
+
+        status = ((mDelegate == NULL) || mDelegate->DidExitState(inEvent, inTransition));
+        nlEXPECT(status == true, done);
+    }
+
+    // Make the transition between states
+
+    status = ((mDelegate == NULL) || mDelegate->WillTransition(inEvent, inTransition));
+    nlEXPECT(status == true, done);
+
+    theHandler = mMachine->GetAction(inTransition);
+
+    if (theHandler != NULL) {
+        status = theHandler->mFunction(inEvent, inTransition, theHandler->mContext);
+        nlEXPECT(status == true, done);
+    }
+
+    status = ((mDelegate == NULL) || mDelegate->DidTransition(inEvent, inTransition));
+    nlEXPECT(status == true, done);
+
+    // Enter the states down from the exit depth to the ending state.
+
+    if (!internal) {
+        status = ((mDelegate == NULL) || mDelegate->WillEnterState(inEvent, inTransition));
+        nlEXPECT(status == true, done);
+
+        mMachine->SetCurrentState(inTransition.mEnd);
+
+        thePath  = mPaths + mArcs[(2 * theOffset) + 1];
+        theCount = mDepths[inTransition.mEnd] - mArcs[2 * theOffset] + 1;
+
+        while (theCount-- > 0) {
+            theHandler = mMachine->GetEnterHandler(static_cast<State>(*thePath++));
+
+            if (theHandler != NULL) {
+                status = theHandler->mFunction(inEvent, inTransition, theHandler->mContext);
+                nlEXPECT(status == true, done);
+            }
+        }
+
+        status = ((mDelegate == NULL) || mDelegate->DidEnterState(inEvent, inTransition));
+        nlEXPECT(status == true, done);
+    }
+
+    status = ((mDelegate == NULL) || mDelegate->DidHandleEvent(inEvent, inState));
+    nlEXPECT(status == true, done);
+
+    // Pass on the transition's output, if any
+
+    if ((mOutputFunction != NULL) && mMachine->GetOutput(inTransition, theOutput))
+        status = mOutputFunction(theOutput, mOutputContext);
+
+ done:
+    return (status);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine recalls the events queued in the machine's deferral
+ *    queue following a change of state.
+ *
+ *  Each pass over the queue handles the queued events, oldest first,
+ *  in the then-current state. Those still deferred are queued again,
+ *  in order, and the others are handled or, failing that, dropped.
+ *  Passes repeat while the state changes and events remain queued.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicHierarchy<StateType, EventType>::Recall(void)
+{
+    Event  theEvent;
+    State  theState;
+    size_t theCount;
+    bool   theMoved;
+
+    mRecalling = true;
+
+    do {
+        theMoved = false;
+        theCount = mMachine->GetDeferredEventCount();
+
+        while ((theCount-- > 0) && mMachine->PopDeferredEvent(theEvent)) {
+            theState = mMachine->GetCurrentState();
+
+            // A still-deferred event is queued again, in the slot just
+            // freed, so this never fails.
+
+            HandleEvent(theEvent);
+
+            if (mMachine->GetCurrentState() != theState)
+                theMoved = true;
+        }
+    } while (theMoved && (mMachine->GetDeferredEventCount() > 0));
+
+    mRecalling = false;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the depth of the specified state by walking its
+ *    ancestors.
+ *
+ *  @param[in]  inState  A reference to the state.
+ *
+ *  @return  The depth of the state, or SIZE_MAX if it is outside of
+ *           the hierarchy or its ancestors form a cycle.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicHierarchy<StateType, EventType>::Walk(const State &inState) const
+{
+    State  theState = inState;
+    size_t theDepth = 0;
+
+    if ((mParents == NULL) || (theState >= mStates))
+        return (SIZE_MAX);
+
+    while (mParents[theState] != theState) {
+        theState = mParents[theState];
+        theDepth++;
+
+        if ((theState >= mStates) || (theDepth >= mStates))
+            return (SIZE_MAX);
+    }
+
+    return (theDepth);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the depth of the shallowest state exited by the
+ *    specified transition, one below the nearest ancestor properly
+ *    containing both its starting and ending states, or zero if there
+ *    is none.
+ *
+ *  A transition to or from an ancestor of its other state, including
+ *  a self-loop, exits and enters that ancestor as well.
+ *
+ *  @param[in]  inTransition  A reference to the transition.
+ *
+ *  @return  The exit depth of the transition.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicHierarchy<StateType, EventType>::GetExitDepth(const Transition &inTransition) const
+{
+    State  theStart      = inTransition.mStart;
+    State  theEnd        = inTransition.mEnd;
+    size_t theStartDepth = Walk(theStart);
+    size_t theEndDepth   = Walk(theEnd);
+
+    while (theStartDepth > theEndDepth) {
+        theStart = mParents[theStart];
+        theStartDepth--;
+    }
+
+    while (theEndDepth > theStartDepth) {
+        theEnd = mParents[theEnd];
+        theEndDepth--;
+    }
+
+    while (theStart != theEnd) {
+        if (mParents[theStart] == theStart)
+            return (0);
+
+        theStart = mParents[theStart];
+        theEnd   = mParents[theEnd];
+        theStartDepth--;
+    }
+
+    if ((theStart == inTransition.mStart) || (theStart == inTransition.mEnd))
+        return (theStartDepth);
+
+    return (theStartDepth + 1);
+}
+
+// Explicit Instantiations
+
+template class BasicHierarchy<uint8_t, uint8_t>;
+template class BasicHierarchy<uint16_t, uint16_t>;
+template class BasicHierarchy<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
@@ -77,15 +77,50 @@
  *
  */
 
+#include <stdint.h>
+
 #include <nlassert.h>
 
 #include <nestlabs/fsm/nlfsm-transition.hpp>
 #include <nestlabs/fsm/nlfsm-machine.hpp>
 
+#include "nlfsm-utilities.hpp"
+
 namespace nl {
 
 namespace Fsm {
 
+// Preprocessor Definitions
+
+/**
+ *  The dense index entry value indicating that there is no transition
+ *  for the corresponding state and event.
+ */
+#define kOffsetNone   UINT32_MAX
+
+/**
+ *  The offset cached for a state and event pair without a
+ *  transition.
+ */
+#define kOffsetAbsent (UINT32_MAX - 1)
+
+/**
+ *  The average number of keys per bucket of the perfect hash index,
+ *  trading index size (one displacement per bucket) against build
+ *  time (more keys to place at once per bucket).
+ */
+#define kHashBucketLoad   4
+
+/**
+ *  The inverse of the fraction of spare slots in the perfect hash
+ *  index. A bucket of k keys placed into slots a fraction f of which
+ *  are free succeeds with a probability of only about f^k per try,
+ *  so a fully loaded index may leave no displacement for the last
+ *  multi-key buckets; a quarter of spare slots keeps f at least
+ *  that for every bucket.
+ */
+#define kHashSlotSlack    4
+
 // Type Definitions
 
 /**
@@ -97,6 +132,7 @@ namespace Fsm {
  *   event tuple in a state machine transition arc.
  *
  */
+template <typename StateType, typename EventType>
 class FindTransitionPredicate
 {
  public:
@@ -114,7 +150,7 @@ class FindTransitionPredicate
      *                       starting state to find a transition for.
      *
      */
-    FindTransitionPredicate(const State &inState, const Event &inEvent) :
+    FindTransitionPredicate(const StateType &inState, const EventType &inEvent) :
         mState(inState),
         mEvent(inEvent)
     {
@@ -135,7 +171,7 @@ class FindTransitionPredicate
      *           event tuple data members; otherwise, \c false.
      *
      */
-    bool operator ()(const Transition * const inTransition) const
+    bool operator ()(const BasicTransition<StateType, EventType> * const inTransition) const
     {
         bool status;
 
@@ -146,10 +182,170 @@ class FindTransitionPredicate
     }
 
  private:
-    const State &   mState;
-    const Event &   mEvent;
+    const StateType &   mState;
+    const EventType &   mEvent;
+};
+
+/**
+ *
+ *  @class EntryOrder
+ *
+ *  @brief
+ *   Heap sort predicate object that orders sorted index entries by
+ *   packed key and then by table offset, such that the first of
+ *   several transitions sharing a key sorts first.
+ *
+ */
+template <typename Entry>
+class EntryOrder
+{
+ public:
+    bool operator ()(const Entry &inFirst, const Entry &inSecond) const
+    {
+        return ((inFirst.mKey < inSecond.mKey) ||
+                ((inFirst.mKey == inSecond.mKey) &&
+                 (inFirst.mOffset < inSecond.mOffset)));
+    }
 };
 
+/**
+ *
+ *  @brief
+ *    This function hashes a packed state and event key with the
+ *    specified seed, using the SplitMix64 finalizer.
+ *
+ *  @param[in]  inKey   The packed key to hash.
+ *  @param[in]  inSeed  The seed selecting the hash function.
+ *
+ *  @return  The 64-bit hash of the key.
+ *
+ */
+static inline uint64_t
+Hash(uint64_t inKey, uint64_t inSeed)
+{
+    uint64_t theValue = inKey ^ (inSeed * UINT64_C(0x9E3779B97F4A7C15));
+
+    theValue = (theValue ^ (theValue >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    theValue = (theValue ^ (theValue >> 27)) * UINT64_C(0x94D049BB133111EB);
+
+    return (theValue ^ (theValue >> 31));
+}
+
+/**
+ *
+ *  @brief
+ *    This function maps a hash onto the range [0, inRange) with a
+ *    multiply and shift rather than a division.
+ *
+ *  @param[in]  inHash   The hash to map.
+ *  @param[in]  inRange  The size of the range, less than 2^32.
+ *
+ *  @return  The mapped hash.
+ *
+ */
+static inline size_t
+Reduce(uint64_t inHash, size_t inRange)
+{
+    return (static_cast<size_t>(((inHash >> 32) * static_cast<uint64_t>(inRange)) >> 32));
+}
+
+/**
+ *
+ *  @brief
+ *    This function gets the perfect hash index bucket for the
+ *    specified key.
+ *
+ */
+template <typename Key>
+static inline size_t
+HashBucket(const Key &inKey, size_t inBuckets)
+{
+    return (Reduce(Hash(inKey, 0), inBuckets));
+}
+
+/**
+ *
+ *  @brief
+ *    This function gets the perfect hash index slot for the
+ *    specified key, given the displacement of its bucket.
+ *
+ */
+template <typename Key>
+static inline size_t
+HashSlot(const Key &inKey, uint32_t inDisplacement, size_t inSlots)
+{
+    return (Reduce(Hash(inKey, static_cast<uint64_t>(inDisplacement) + 1), inSlots));
+}
+
+/**
+ *
+ *  @brief
+ *    This function finds a displacement placing every distinct key of
+ *    a perfect hash bucket into a free slot and, if successful, fills
+ *    those slots.
+ *
+ *  Entries sharing a key are adjacent and in table order, so only
+ *  the first, which is the first match in the table, is placed.
+ *
+ *  @param[in]      inEntries        The bucket's entries.
+ *  @param[in]      inCount          The number of entries in the bucket.
+ *  @param[in,out]  ioSlots          The perfect hash slots.
+ *  @param[in]      inSlots          The number of perfect hash slots.
+ *  @param[out]     outDisplacement  The displacement found.
+ *
+ *  @return  \c true if a displacement was found; otherwise, \c false.
+ *
+ */
+template <typename Entry>
+static bool
+PlaceHashBucket(const Entry inEntries[],
+                size_t inCount,
+                uint32_t ioSlots[],
+                size_t inSlots,
+                uint32_t &outDisplacement)
+{
+    // With k distinct keys to place and a fraction f of slots free,
+    // each try succeeds with a probability of about f^k. The index's
+    // spare slots keep f above 1 / kHashSlotSlack, so the limit is
+    // only reached for degenerate hashes.
+
+    const uint64_t theLimit = (static_cast<uint64_t>(inSlots) * 64) + 1024;
+    uint64_t       d;
+    size_t         i, j;
+
+    for (d = 0; d < theLimit; d++) {
+        const uint32_t theDisplacement = static_cast<uint32_t>(d);
+        bool           thePlaced = true;
+
+        for (i = 0; (i < inCount) && thePlaced; i++) {
+            const size_t theSlot = HashSlot(inEntries[i].mKey, theDisplacement, inSlots);
+
+            if ((i > 0) && (inEntries[i].mKey == inEntries[i - 1].mKey))
+                continue;
+
+            thePlaced = (ioSlots[theSlot] == kOffsetNone);
+
+            for (j = 0; (j < i) && thePlaced; j++)
+                thePlaced = (HashSlot(inEntries[j].mKey, theDisplacement, inSlots) != theSlot);
+        }
+
+        if (thePlaced) {
+            for (i = 0; i < inCount; i++) {
+                if ((i > 0) && (inEntries[i].mKey == inEntries[i - 1].mKey))
+                    continue;
+
+                ioSlots[HashSlot(inEntries[i].mKey, theDisplacement, inSlots)] = inEntries[i].mOffset;
+            }
+
+            outDisplacement = theDisplacement;
+
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
 /**
  *
  *  @brief
@@ -158,10 +354,47 @@ class FindTransitionPredicate
  *    state.
  *
  */
-Machine::Machine(void) :
+template <typename StateType, typename EventType>
+BasicMachine<StateType, EventType>::BasicMachine(void) :
     mCurrentState(0),
+    mStateEpoch(0),
     mCount(0),
-    mFirstTransition(NULL)
+    mFirstTransition(NULL),
+    mLookup(kLookupLinear),
+    mDenseIndex(NULL),
+    mDenseEvents(0),
+    mDenseStates(0),
+    mSortedIndex(NULL),
+    mHashIndex(NULL),
+    mHashBuckets(0),
+    mHashSlots(0),
+    mAcceptedEvents(NULL),
+    mAcceptedWords(0),
+    mAcceptedStates(0),
+    mDeferredEvents(NULL),
+    mDeferredWords(0),
+    mDeferredStates(0),
+    mQueue(NULL),
+    mQueueSize(0),
+    mQueueHead(0),
+    mQueueCount(0),
+    mClassMap(NULL),
+    mClassIndex(NULL),
+    mClassEvents(0),
+    mClasses(0),
+    mClassStates(0),
+    mSelfLoopPolicy(kSelfLoopExternal),
+    mInternal(NULL),
+    mActions(NULL),
+    mOutputs(NULL),
+    mEnterHandlers(NULL),
+    mExitHandlers(NULL),
+    mHandlerStates(0),
+    mGuards(NULL),
+    mCache(NULL),
+    mCacheSize(0),
+    mCacheNext(0),
+    mProfile(NULL)
 {
     return;
 }
@@ -181,9 +414,12 @@ Machine::Machine(void) :
  *                              at.
  *
  */
-Machine::Machine(const Transition inTransitions[],
-                 size_t inCount,
-                 const State &inCurrentState)
+template <typename StateType, typename EventType>
+BasicMachine<StateType, EventType>::BasicMachine(const Transition inTransitions[],
+                                                 size_t inCount,
+                                                 const State &inCurrentState) :
+    mStateEpoch(0),
+    mSelfLoopPolicy(kSelfLoopExternal)
 {
     SetTransitions(inTransitions, inCount, inCurrentState);
 }
@@ -195,6 +431,12 @@ Machine::Machine(const Transition inTransitions[],
  *    transitions and starts the machine at the specified starting
  *    state.
  *
+ *  Any lookup index, accepted- or deferred-event bitmap, deferral
+ *  queue, event classes, internal transition flags, actions, outputs,
+ *  state handlers, guards, cache or profile for a previous transition
+ *  table are discarded and the machine reverts to linear lookups. The
+ *  self-loop policy is kept.
+ *
  *  @param[in]  inTransitions   An array of pointers to transitions to
  *                              instantiate the machine with.
  *  @param[in]  inCount         The number of transitions in the specified
@@ -203,14 +445,48 @@ Machine::Machine(const Transition inTransitions[],
  *                              at.
  *
  */
+template <typename StateType, typename EventType>
 void
-Machine::SetTransitions(const Transition inTransitions[],
-                        size_t inCount,
-                        const State &inCurrentState)
+BasicMachine<StateType, EventType>::SetTransitions(const Transition inTransitions[],
+                                                   size_t inCount,
+                                                   const State &inCurrentState)
 {
     mCurrentState    = inCurrentState;
+    mStateEpoch++;
     mCount           = inCount;
     mFirstTransition = inTransitions;
+
+    SetLinearLookup();
+    ClearAcceptedEvents();
+    ClearDeferredEvents();
+    ClearDeferralQueue();
+    ClearEventClasses();
+    ClearInternalTransitions();
+    ClearActions();
+    ClearOutputs();
+    ClearStateHandlers();
+    ClearGuards();
+    ClearTransitionCache();
+    ClearProfile();
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the transition table of the machine.
+ *
+ *  @param[out]  outCount  The number of transitions in the table.
+ *
+ *  @return  A pointer to the first transition in the table.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::GetTransitions(size_t &outCount) const
+{
+    outCount = mCount;
+
+    return mFirstTransition;
 }
 
 /**
@@ -221,8 +497,9 @@ Machine::SetTransitions(const Transition inTransitions[],
  *  @return  A reference to the current state.
  *
  */
-const State &
-Machine::GetCurrentState(void) const
+template <typename StateType, typename EventType>
+const StateType &
+BasicMachine<StateType, EventType>::GetCurrentState(void) const
 {
     return mCurrentState;
 }
@@ -233,14 +510,40 @@ Machine::GetCurrentState(void) const
  *    This routine sets the machine current state to the specified
  *    state.
  *
+ *  Setting the state, even to the current state, starts a new stay
+ *  in it and so advances the state epoch.
+ *
  *  @param[in]  inState  A reference to the state to set as the current
  *                       state.
  *
  */
+template <typename StateType, typename EventType>
 void
-Machine::SetCurrentState(const State &inState)
+BasicMachine<StateType, EventType>::SetCurrentState(const State &inState)
 {
     mCurrentState = inState;
+    mStateEpoch++;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the state epoch of the machine, the number of
+ *    times its current state has been set.
+ *
+ *  An epoch captured on entering a state no longer matches once the
+ *  machine has left it, even for the same state again, so work
+ *  scheduled on behalf of a stay in a state, such as a timeout, may
+ *  be discarded lazily.
+ *
+ *  @return  The state epoch.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicMachine<StateType, EventType>::Epoch
+BasicMachine<StateType, EventType>::GetStateEpoch(void) const
+{
+    return (mStateEpoch);
 }
 
 /**
@@ -258,23 +561,2308 @@ Machine::SetCurrentState(const State &inState)
  *           event if successful; otherwise, NULL.
  *
  */
-const Transition *
-Machine::FindTransition(const State & inState, const Event & inEvent) const
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindTransition(const State & inState, const Event & inEvent) const
 {
-    const Transition * start = mFirstTransition;
-    const Transition * end = mFirstTransition + mCount;
-    const FindTransitionPredicate theFinder(inState, inEvent);
+    const Transition * theTransition;
 
-    nlCHECK(&inState != NULL);
-    nlCHECK(&inEvent != NULL);
+    if (mCache != NULL) {
+        const Key theKey = Transition::MakeKey(inState, inEvent);
 
-    while ((start != end) && !bool(theFinder(start))) {
-        ++start;
+        if (!FindCached(theKey, theTransition)) {
+            theTransition = FindUncached(inState, inEvent);
+
+            Remember(theKey, theTransition);
+        }
+    } else {
+        theTransition = FindUncached(inState, inEvent);
     }
 
-    return ((start != end) ? start : NULL);
+    if ((mProfile != NULL) && (theTransition != NULL))
+        Hit(static_cast<Offset>(theTransition - mFirstTransition));
+
+    return (theTransition);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine attempts to find the first transition in the state
+ *    machine matching the specified starting state and event tuple
+ *    whose guard, if any, holds.
+ *
+ *  The candidates are the first matching transition, as found by
+ *  #FindTransition, and those matching transitions immediately
+ *  following it in the table, and their guards are evaluated in
+ *  table order. Without guards, this is #FindTransition.
+ *
+ *  @param[in]  inState  A reference to the starting state to find a
+ *                       transition for.
+ *  @param[in]  inEvent  A reference to the event associated with the
+ *                       starting state to find a transition for.
+ *
+ *  @return  A pointer to the enabled transition matching the
+ *           specified state and event if successful; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindEnabledTransition(const State & inState, const Event & inEvent) const
+{
+    const Transition * theTransition = FindTransition(inState, inEvent);
+    const Transition * theLast       = mFirstTransition + mCount;
+
+    if ((theTransition == NULL) || (mGuards == NULL))
+        return (theTransition);
+
+    while (true) {
+        const Guard &theGuard = mGuards[theTransition - mFirstTransition];
+
+        if ((theGuard.mFunction == NULL) || theGuard.mFunction(inEvent, *theTransition, theGuard.mContext))
+            return (theTransition);
+
+        theTransition++;
+
+        if ((theTransition == theLast) ||
+            (theTransition->mStart != inState) ||
+            (theTransition->mEvent != inEvent))
+            return (NULL);
+    }
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds a transition with the accepted-event bitmap,
+ *    if any, and the lookup strategy, bypassing the cache.
+ *
+ *  @param[in]  inState  A reference to the starting state to find a
+ *                       transition for.
+ *  @param[in]  inEvent  A reference to the event associated with the
+ *                       starting state to find a transition for.
+ *
+ *  @return  A pointer to the first transition matching the specified
+ *           state and event if successful; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindUncached(const State & inState, const Event & inEvent) const
+{
+    if ((mAcceptedEvents != NULL) && !IsEventAccepted(inState, inEvent))
+        return (NULL);
+
+    switch (mLookup) {
+
+    case kLookupDense:
+        return (FindDense(inState, inEvent));
+
+    case kLookupSorted:
+        return (FindSorted(inState, inEvent));
+
+    case kLookupEytzinger:
+        return (FindEytzinger(inState, inEvent));
+
+    case kLookupHash:
+        return (FindHash(inState, inEvent));
+
+    default:
+        return (FindLinear(inState, inEvent));
+
+    }
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the strategy the machine uses to find
+ *    transitions.
+ *
+ *  @return  The lookup strategy.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicMachine<StateType, EventType>::Lookup
+BasicMachine<StateType, EventType>::GetLookup(void) const
+{
+    return mLookup;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine reverts the machine to finding transitions with a
+ *    linear scan of the transition table, releasing any index.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::SetLinearLookup(void)
+{
+    mLookup      = kLookupLinear;
+    mDenseIndex  = NULL;
+    mDenseEvents = 0;
+    mDenseStates = 0;
+    mSortedIndex = NULL;
+    mHashIndex   = NULL;
+    mHashBuckets = 0;
+    mHashSlots   = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries required for a dense
+ *    index of the current transition table.
+ *
+ *  The dense index has one entry for each state and event pair, up to
+ *  the largest starting state and event in the table, and is only
+ *  practical for narrow or densely-numbered states and events.
+ *
+ *  @return  The number of entries required, or zero if the index size
+ *           is not representable or the table is too large to index.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetDenseIndexSize(void) const
+{
+    size_t theStates;
+    size_t theEvents;
+
+    if (!GetDenseDimensions(theStates, theEvents))
+        return (0);
+
+    return (theStates * theEvents);
 }
 
+/**
+ *
+ *  @brief
+ *    This routine builds a dense state-by-event index of the current
+ *    transition table in the specified storage and switches the
+ *    machine to constant-time lookups using it.
+ *
+ *  The storage must remain valid until the transition table is next
+ *  set or another lookup strategy is selected.
+ *
+ *  @param[in]  inIndex  Storage for the index.
+ *  @param[in]  inSize   The number of entries available in the
+ *                       storage, at least that returned by
+ *                       #GetDenseIndexSize.
+ *
+ *  @return  \c true if the index was built; otherwise, \c false, in
+ *           which case the lookup strategy is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetDenseLookup(Offset inIndex[], size_t inSize)
+{
+    size_t theStates;
+    size_t theEvents;
+    size_t i;
+    bool   retval;
+
+    nlREQUIRE_ACTION(inIndex != NULL, done, retval = false);
+
+    retval = GetDenseDimensions(theStates, theEvents);
+    nlREQUIRE(retval, done);
+
+    nlREQUIRE_ACTION(inSize >= (theStates * theEvents), done, retval = false);
+
+    for (i = 0; i < (theStates * theEvents); i++)
+        inIndex[i] = kOffsetNone;
+
+    // Walk the table in order, recording only the first transition
+    // for each state and event pair, to preserve first-match
+    // semantics.
+
+    for (i = 0; i < mCount; i++) {
+        const Transition &theTransition = mFirstTransition[i];
+        Offset &theEntry = inIndex[(static_cast<size_t>(theTransition.mStart) * theEvents) + theTransition.mEvent];
+
+        if (theEntry == kOffsetNone)
+            theEntry = static_cast<Offset>(i);
+    }
+
+    SetLinearLookup();
+
+    mLookup      = kLookupDense;
+    mDenseIndex  = inIndex;
+    mDenseEvents = theEvents;
+    mDenseStates = theStates;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries required for a sorted
+ *    index of the current transition table.
+ *
+ *  @return  The number of entries required, one per transition.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetSortedIndexSize(void) const
+{
+    return (mCount);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine builds an index of the current transition table,
+ *    sorted by packed starting state and event key, in the specified
+ *    storage and switches the machine to logarithmic-time lookups
+ *    using it.
+ *
+ *  The storage must remain valid until the transition table is next
+ *  set or another lookup strategy is selected.
+ *
+ *  @param[in]  inIndex  Storage for the index.
+ *  @param[in]  inSize   The number of entries available in the
+ *                       storage, at least that returned by
+ *                       #GetSortedIndexSize.
+ *
+ *  @return  \c true if the index was built; otherwise, \c false, in
+ *           which case the lookup strategy is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetSortedLookup(SortedEntry inIndex[], size_t inSize)
+{
+    bool   retval;
+
+    retval = BuildSortedIndex(inIndex, inSize);
+    nlREQUIRE(retval, done);
+
+    SetLinearLookup();
+
+    mLookup      = kLookupSorted;
+    mSortedIndex = inIndex;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries required for an
+ *    Eytzinger-ordered index of the current transition table.
+ *
+ *  @return  The number of entries required, one per transition plus
+ *           one unused root sentinel.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetEytzingerIndexSize(void) const
+{
+    return (mCount + 1);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine builds an index of the current transition table,
+ *    sorted by packed starting state and event key and laid out in
+ *    Eytzinger order, in the specified storage and switches the
+ *    machine to logarithmic-time lookups using it.
+ *
+ *  In Eytzinger order, the children of the entry at position k are
+ *  at positions 2k and 2k + 1, such that the first several levels of
+ *  every search share the same few cache lines.
+ *
+ *  The index storage must remain valid until the transition table is
+ *  next set or another lookup strategy is selected. The scratch
+ *  storage is only used while building the index and may be released
+ *  or reused once this routine returns.
+ *
+ *  @param[in]  inIndex        Storage for the index.
+ *  @param[in]  inSize         The number of entries available in the
+ *                             index storage, at least that returned by
+ *                             #GetEytzingerIndexSize.
+ *  @param[in]  inScratch      Scratch storage for building the index.
+ *  @param[in]  inScratchSize  The number of entries available in the
+ *                             scratch storage, at least that returned by
+ *                             #GetSortedIndexSize.
+ *
+ *  @return  \c true if the index was built; otherwise, \c false, in
+ *           which case the lookup strategy is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetEytzingerLookup(SortedEntry inIndex[],
+                                                       size_t inSize,
+                                                       SortedEntry inScratch[],
+                                                       size_t inScratchSize)
+{
+    size_t theNext;
+    size_t k = 1;
+    bool   retval = true;
+
+    nlREQUIRE_ACTION(inIndex != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= (mCount + 1), done, retval = false);
+
+    retval = BuildSortedIndex(inScratch, inScratchSize);
+    nlREQUIRE(retval, done);
+
+    // Fill the tree with an iterative in-order traversal, which visits
+    // the positions in ascending key order, starting from the leftmost.
+
+    while ((2 * k) <= mCount)
+        k = 2 * k;
+
+    for (theNext = 0; theNext < mCount; theNext++) {
+        inIndex[k] = inScratch[theNext];
+
+        if (((2 * k) + 1) <= mCount) {
+            // Descend to the leftmost position of the right subtree.
+
+            k = (2 * k) + 1;
+
+            while ((2 * k) <= mCount)
+                k = 2 * k;
+        } else {
+            // Climb past every ancestor of which this position is in
+            // the right subtree, then to the parent.
+
+            while ((k & 1) != 0)
+                k >>= 1;
+
+            k >>= 1;
+        }
+    }
+
+    // The root sentinel is never examined, but keep it defined.
+
+    inIndex[0].mKey    = 0;
+    inIndex[0].mOffset = kOffsetNone;
+
+    SetLinearLookup();
+
+    mLookup      = kLookupEytzinger;
+    mSortedIndex = inIndex;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries required for a perfect
+ *    hash index of the current transition table.
+ *
+ *  @return  The number of entries required, one per bucket of about
+ *           four transitions plus one slot per transition and a
+ *           quarter again as many spare slots.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetHashIndexSize(void) const
+{
+    return (GetHashBuckets() + GetHashSlots());
+}
+
+/**
+ *
+ *  @brief
+ *    This routine builds a perfect hash index of the packed
+ *    starting state and event keys of the current transition table
+ *    in the specified storage and switches the machine to
+ *    constant-time, single-probe lookups using it.
+ *
+ *  The index is built by hashing and displacing: keys are first
+ *  hashed into buckets and then, largest bucket first, each bucket
+ *  searches for the displacement of a second hash that places all of
+ *  its keys in free slots. A lookup hashes the key to its bucket,
+ *  applies that bucket's displacement to find its slot and compares
+ *  the key of the transition in that slot against the key sought.
+ *
+ *  The index storage must remain valid until the transition table is
+ *  next set or another lookup strategy is selected. The scratch
+ *  storage is only used while building the index and may be released
+ *  or reused once this routine returns.
+ *
+ *  @param[in]  inIndex        Storage for the index.
+ *  @param[in]  inSize         The number of entries available in the
+ *                             index storage, at least that returned by
+ *                             #GetHashIndexSize.
+ *  @param[in]  inScratch      Scratch storage for building the index.
+ *  @param[in]  inScratchSize  The number of entries available in the
+ *                             scratch storage, at least that returned by
+ *                             #GetSortedIndexSize.
+ *
+ *  @return  \c true if the index was built; otherwise, \c false, in
+ *           which case the lookup strategy is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetHashLookup(Offset inIndex[],
+                                                  size_t inSize,
+                                                  SortedEntry inScratch[],
+                                                  size_t inScratchSize)
+{
+    const size_t theBuckets = GetHashBuckets();
+    const size_t theSlotCount = GetHashSlots();
+    Offset *     theDisplacements = inIndex;
+    Offset *     theSlots = inIndex + theBuckets;
+    size_t       theLargest = 0;
+    size_t       theSum = 0;
+    size_t       i, j, b;
+    bool         retval = true;
+
+    nlREQUIRE_ACTION(inIndex != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= (theBuckets + theSlotCount), done, retval = false);
+    nlREQUIRE_ACTION(inScratch != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inScratchSize >= mCount, done, retval = false);
+    nlREQUIRE_ACTION(mCount < kOffsetNone, done, retval = false);
+
+    // Distribute the keys into contiguous runs by bucket with a
+    // counting sort, using the displacements as the bucket counts and
+    // then cursors. Each run is in table order.
+
+    for (b = 0; b < theBuckets; b++)
+        theDisplacements[b] = 0;
+
+    for (i = 0; i < mCount; i++)
+        theDisplacements[HashBucket(mFirstTransition[i].GetKey(), theBuckets)]++;
+
+    for (b = 0; b < theBuckets; b++) {
+        const size_t theCount = theDisplacements[b];
+
+        if (theCount > theLargest)
+            theLargest = theCount;
+
+        theDisplacements[b] = static_cast<Offset>(theSum);
+        theSum += theCount;
+    }
+
+    for (i = 0; i < mCount; i++) {
+        const Key    theKey = mFirstTransition[i].GetKey();
+        const size_t theEntry = theDisplacements[HashBucket(theKey, theBuckets)]++;
+
+        inScratch[theEntry].mKey    = theKey;
+        inScratch[theEntry].mOffset = static_cast<Offset>(i);
+    }
+
+    // Group duplicate keys within each run, preserving table order
+    // among them, such that only the first is placed.
+
+    for (i = 0; i < mCount; i = j) {
+        const size_t theBucket = HashBucket(inScratch[i].mKey, theBuckets);
+
+        for (j = i + 1; (j < mCount) && (HashBucket(inScratch[j].mKey, theBuckets) == theBucket); j++)
+            continue;
+
+        HeapSort(inScratch + i, j - i, EntryOrder<SortedEntry>());
+    }
+
+    for (b = 0; b < theBuckets; b++)
+        theDisplacements[b] = 0;
+
+    for (i = 0; i < theSlotCount; i++)
+        theSlots[i] = kOffsetNone;
+
+    // Place the buckets, largest first, while the most slots are
+    // free.
+
+    for (theSum = theLargest; (theSum > 0) && retval; theSum--) {
+        for (i = 0; (i < mCount) && retval; i = j) {
+            const size_t theBucket = HashBucket(inScratch[i].mKey, theBuckets);
+
+            for (j = i + 1; (j < mCount) && (HashBucket(inScratch[j].mKey, theBuckets) == theBucket); j++)
+                continue;
+
+            if ((j - i) == theSum)
+                retval = PlaceHashBucket(inScratch + i, j - i, theSlots, theSlotCount, theDisplacements[theBucket]);
+        }
+    }
+
+    nlREQUIRE(retval, done);
+
+    SetLinearLookup();
+
+    mLookup      = kLookupHash;
+    mHashIndex   = inIndex;
+    mHashBuckets = theBuckets;
+    mHashSlots   = theSlotCount;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words required for a per-state
+ *    accepted-event bitmap of the current transition table.
+ *
+ *  @return  The number of words required, or zero if the state and
+ *           event identifiers are too large to be mapped.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetAcceptedEventsSize(void) const
+{
+    size_t theStates;
+    size_t theEvents;
+
+    if (!GetDenseDimensions(theStates, theEvents))
+        return (0);
+
+    return (theStates * ((theEvents + kMaskBits - 1) / kMaskBits));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine builds a per-state bitmap of the events with a
+ *    transition out of each state of the current transition table in
+ *    the specified storage, after which events not accepted in a
+ *    state are rejected before any lookup.
+ *
+ *  The storage must remain valid until the transition table is next
+ *  set or the bitmap is cleared.
+ *
+ *  @param[in]  inBitmap  Storage for the bitmap.
+ *  @param[in]  inSize    The number of words available in the
+ *                        storage, at least that returned by
+ *                        #GetAcceptedEventsSize.
+ *
+ *  @return  \c true if the bitmap was built; otherwise, \c false, in
+ *           which case any existing bitmap is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetAcceptedEvents(Mask inBitmap[], size_t inSize)
+{
+    size_t theStates;
+    size_t theEvents;
+    size_t theWords;
+    size_t i;
+    bool   retval;
+
+    nlREQUIRE_ACTION(inBitmap != NULL, done, retval = false);
+
+    retval = GetDenseDimensions(theStates, theEvents);
+    nlREQUIRE(retval, done);
+
+    theWords = (theEvents + kMaskBits - 1) / kMaskBits;
+
+    nlREQUIRE_ACTION(inSize >= (theStates * theWords), done, retval = false);
+
+    for (i = 0; i < (theStates * theWords); i++)
+        inBitmap[i] = 0;
+
+    for (i = 0; i < mCount; i++) {
+        const Transition &theTransition = mFirstTransition[i];
+
+        inBitmap[(static_cast<size_t>(theTransition.mStart) * theWords) + (theTransition.mEvent / kMaskBits)] |=
+            static_cast<Mask>(1) << (theTransition.mEvent % kMaskBits);
+    }
+
+    mAcceptedEvents = inBitmap;
+    mAcceptedWords  = theWords;
+    mAcceptedStates = theStates;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine discards the per-state accepted-event bitmap, if
+ *    any, such that every event is looked up.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearAcceptedEvents(void)
+{
+    mAcceptedEvents = NULL;
+    mAcceptedWords  = 0;
+    mAcceptedStates = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the row of the per-state accepted-event bitmap
+ *    for the specified state.
+ *
+ *  @param[in]   inState   A reference to the state to get the row for.
+ *  @param[out]  outWords  The number of words in the row.
+ *
+ *  @return  A pointer to the first word of the row if the machine has
+ *           a bitmap and the state has a row in it; otherwise, NULL,
+ *           with \c outWords set to zero.
+ *
+ */
+template <typename StateType, typename EventType>
+const typename BasicMachine<StateType, EventType>::Mask *
+BasicMachine<StateType, EventType>::GetAcceptedEvents(const State &inState, size_t &outWords) const
+{
+    if ((mAcceptedEvents == NULL) || (inState >= mAcceptedStates)) {
+        outWords = 0;
+        return (NULL);
+    }
+
+    outWords = mAcceptedWords;
+
+    return (mAcceptedEvents + (static_cast<size_t>(inState) * mAcceptedWords));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the specified event has a
+ *    transition out of the specified state.
+ *
+ *  With a per-state accepted-event bitmap, this is a single bit test;
+ *  without one, it is a lookup.
+ *
+ *  @param[in]  inState  A reference to the state to test.
+ *  @param[in]  inEvent  A reference to the event to test.
+ *
+ *  @return  \c true if the event is accepted in the state; otherwise,
+ *           \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::IsEventAccepted(const State &inState, const Event &inEvent) const
+{
+    if (mAcceptedEvents == NULL)
+        return (FindTransition(inState, inEvent) != NULL);
+
+    if ((inState >= mAcceptedStates) || ((inEvent / kMaskBits) >= mAcceptedWords))
+        return (false);
+
+    return ((mAcceptedEvents[(static_cast<size_t>(inState) * mAcceptedWords) + (inEvent / kMaskBits)] &
+             (static_cast<Mask>(1) << (inEvent % kMaskBits))) != 0);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of storage required for the
+ *    per-state deferred-event bitmap of the current transition table,
+ *    the same as for the accepted-event bitmap.
+ *
+ *  @return  The number of words required, or zero if the state and
+ *           event identifiers are too large to be mapped.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetDeferredEventsSize(void) const
+{
+    return (GetAcceptedEventsSize());
+}
+
+/**
+ *
+ *  @brief
+ *    This routine starts a per-state bitmap of the events deferred in
+ *    each state of the current transition table in the specified
+ *    storage, with no events deferred.
+ *
+ *  Events are then deferred in a state with #SetEventDeferred. The
+ *  storage must remain valid until the transition table is next set
+ *  or the bitmap is cleared.
+ *
+ *  @param[in,out]  ioBitmap  Storage for the bitmap.
+ *  @param[in]      inSize    The number of words available in the
+ *                            storage, at least that returned by
+ *                            #GetDeferredEventsSize.
+ *
+ *  @return  \c true if the bitmap was started; otherwise, \c false,
+ *           in which case any existing bitmap is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetDeferredEvents(Mask ioBitmap[], size_t inSize)
+{
+    size_t theStates;
+    size_t theEvents;
+    size_t theWords;
+    size_t i;
+    bool   retval;
+
+    nlREQUIRE_ACTION(ioBitmap != NULL, done, retval = false);
+
+    retval = GetDenseDimensions(theStates, theEvents);
+    nlREQUIRE(retval, done);
+
+    theWords = (theEvents + kMaskBits - 1) / kMaskBits;
+
+    nlREQUIRE_ACTION(inSize >= (theStates * theWords), done, retval = false);
+
+    for (i = 0; i < (theStates * theWords); i++)
+        ioBitmap[i] = 0;
+
+    mDeferredEvents = ioBitmap;
+    mDeferredWords  = theWords;
+    mDeferredStates = theStates;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine discards the per-state deferred-event bitmap, after
+ *    which no events are deferred.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearDeferredEvents(void)
+{
+    mDeferredEvents = NULL;
+    mDeferredWords  = 0;
+    mDeferredStates = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine defers the specified event in the specified state.
+ *
+ *  @param[in]  inState  A reference to the state to defer the event in.
+ *  @param[in]  inEvent  A reference to the event to defer.
+ *
+ *  @return  \c true if the event was deferred; otherwise, \c false,
+ *           if there is no bitmap or the state or event is outside of
+ *           it.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetEventDeferred(const State &inState, const Event &inEvent)
+{
+    if ((mDeferredEvents == NULL) || (inState >= mDeferredStates) || ((inEvent / kMaskBits) >= mDeferredWords))
+        return (false);
+
+    mDeferredEvents[(static_cast<size_t>(inState) * mDeferredWords) + (inEvent / kMaskBits)] |=
+        static_cast<Mask>(1) << (inEvent % kMaskBits);
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the specified event is deferred
+ *    in the specified state.
+ *
+ *  @param[in]  inState  A reference to the state to test.
+ *  @param[in]  inEvent  A reference to the event to test.
+ *
+ *  @return  \c true if the event is deferred in the state; otherwise,
+ *           \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::IsEventDeferred(const State &inState, const Event &inEvent) const
+{
+    if ((mDeferredEvents == NULL) || (inState >= mDeferredStates) || ((inEvent / kMaskBits) >= mDeferredWords))
+        return (false);
+
+    return ((mDeferredEvents[(static_cast<size_t>(inState) * mDeferredWords) + (inEvent / kMaskBits)] &
+             (static_cast<Mask>(1) << (inEvent % kMaskBits))) != 0);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine starts queuing deferred events in the specified
+ *    storage, initially empty.
+ *
+ *  The storage must remain valid until the transition table is next
+ *  set or the queue is cleared.
+ *
+ *  @param[in,out]  ioQueue  Storage for the queue.
+ *  @param[in]      inSize   The number of events available in the
+ *                           storage.
+ *
+ *  @return  \c true if queuing started; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetDeferralQueue(Event ioQueue[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(ioQueue != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize > 0, done, retval = false);
+
+    mQueue      = ioQueue;
+    mQueueSize  = inSize;
+    mQueueHead  = 0;
+    mQueueCount = 0;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine stops queuing deferred events, discarding any that
+ *    are queued.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearDeferralQueue(void)
+{
+    mQueue      = NULL;
+    mQueueSize  = 0;
+    mQueueHead  = 0;
+    mQueueCount = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine queues the specified deferred event, after any
+ *    already queued.
+ *
+ *  @param[in]  inEvent  A reference to the event to queue.
+ *
+ *  @return  \c true if the event was queued; otherwise, \c false, if
+ *           there is no queue or it is full.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::PushDeferredEvent(const Event &inEvent)
+{
+    size_t theTail;
+
+    if (mQueueCount >= mQueueSize)
+        return (false);
+
+    theTail = mQueueHead + mQueueCount;
+
+    if (theTail >= mQueueSize)
+        theTail -= mQueueSize;
+
+    mQueue[theTail] = inEvent;
+    mQueueCount++;
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine dequeues the oldest deferred event.
+ *
+ *  @param[out]  outEvent  The dequeued event, if any.
+ *
+ *  @return  \c true if an event was dequeued; otherwise, \c false, if
+ *           the queue is empty.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::PopDeferredEvent(Event &outEvent)
+{
+    if (mQueueCount == 0)
+        return (false);
+
+    outEvent = mQueue[mQueueHead];
+
+    if (++mQueueHead == mQueueSize)
+        mQueueHead = 0;
+
+    mQueueCount--;
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of queued deferred events.
+ *
+ *  @return  The number of queued deferred events.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetDeferredEventCount(void) const
+{
+    return (mQueueCount);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether a deferred-event bitmap or a
+ *    deferral queue is set.
+ *
+ *  @return  \c true if either is set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::HasDeferral(void) const
+{
+    return ((mDeferredEvents != NULL) || (mQueue != NULL));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries required for an event
+ *    class map of the current transition table.
+ *
+ *  @return  The number of entries required, one per event up to the
+ *           largest in the table, or zero if the state and event
+ *           identifiers are too large to be mapped.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetEventClassMapSize(void) const
+{
+    size_t theStates;
+    size_t theEvents;
+
+    if (!GetDenseDimensions(theStates, theEvents))
+        return (0);
+
+    return (theEvents);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine partitions the events of the current transition
+ *    table into equivalence classes, events with the same next state
+ *    (or lack thereof) in every state, and builds a state-by-class
+ *    next-state index for constant-time next-state lookups.
+ *
+ *  Classes are numbered in order of their lowest event. The index is
+ *  built in place: the storage must be large enough for a dense
+ *  index, which is built first and then compacted such that, once
+ *  this routine returns, only the first #GetNextStateIndexSize
+ *  entries remain in use.
+ *
+ *  The class map and index storage must remain valid until the
+ *  transition table is next set or the classes are cleared.
+ *
+ *  @param[out]     outClassMap     Storage for the class of each event.
+ *  @param[in]      inClassMapSize  The number of entries available in
+ *                                  the class map storage, at least
+ *                                  that returned by
+ *                                  #GetEventClassMapSize.
+ *  @param[in,out]  ioIndex         Storage for the index.
+ *  @param[in]      inIndexSize     The number of entries available in
+ *                                  the index storage, at least that
+ *                                  returned by #GetDenseIndexSize.
+ *
+ *  @return  \c true if the classes and index were built; otherwise,
+ *           \c false, in which case any existing classes are
+ *           unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetEventClasses(Event outClassMap[],
+                                                    size_t inClassMapSize,
+                                                    Offset ioIndex[],
+                                                    size_t inIndexSize)
+{
+    size_t theStates;
+    size_t theEvents;
+    size_t theClasses = 0;
+    size_t s, e, f, c;
+    bool   retval;
+
+    nlREQUIRE_ACTION(outClassMap != NULL, done, retval = false);
+    nlREQUIRE_ACTION(ioIndex != NULL, done, retval = false);
+
+    retval = GetDenseDimensions(theStates, theEvents);
+    nlREQUIRE(retval, done);
+
+    nlREQUIRE_ACTION(inClassMapSize >= theEvents, done, retval = false);
+    nlREQUIRE_ACTION(inIndexSize >= (theStates * theEvents), done, retval = false);
+
+    // Build the dense index, keeping the first match for each state
+    // and event pair.
+
+    for (s = 0; s < (theStates * theEvents); s++)
+        ioIndex[s] = kOffsetNone;
+
+    for (s = 0; s < mCount; s++) {
+        const Transition &theTransition = mFirstTransition[s];
+        Offset &theEntry = ioIndex[(static_cast<size_t>(theTransition.mStart) * theEvents) + theTransition.mEvent];
+
+        if (theEntry == kOffsetNone)
+            theEntry = static_cast<Offset>(s);
+    }
+
+    // Assign each event the class of the first lower event, the
+    // lowest of its class, whose column has the same next states;
+    // otherwise, a new class.
+
+    for (e = 0; e < theEvents; e++) {
+        for (f = 0, c = 0; f < e; f++) {
+            if (outClassMap[f] != c)
+                continue;
+
+            for (s = 0; s < theStates; s++) {
+                if (!IsSameNextState(ioIndex[(s * theEvents) + e], ioIndex[(s * theEvents) + f]))
+                    break;
+            }
+
+            if (s == theStates)
+                break;
+
+            c++;
+        }
+
+        if (f == e)
+            c = theClasses++;
+
+        outClassMap[e] = static_cast<Event>(c);
+    }
+
+    // Compact the dense index in place down to the columns of the
+    // lowest event of each class. Every entry moves to an offset no
+    // greater than its own, so no entry is overwritten before it is
+    // read.
+
+    for (s = 0; s < theStates; s++) {
+        for (e = 0, c = 0; e < theEvents; e++) {
+            if (outClassMap[e] == c)
+                ioIndex[(s * theClasses) + c++] = ioIndex[(s * theEvents) + e];
+        }
+    }
+
+    mClassMap    = outClassMap;
+    mClassIndex  = ioIndex;
+    mClassEvents = theEvents;
+    mClasses     = theClasses;
+    mClassStates = theStates;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine discards the event classes and next-state index, if
+ *    any.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearEventClasses(void)
+{
+    mClassMap    = NULL;
+    mClassIndex  = NULL;
+    mClassEvents = 0;
+    mClasses     = 0;
+    mClassStates = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of event classes.
+ *
+ *  @return  The number of event classes, or zero if none have been
+ *           built.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetEventClassCount(void) const
+{
+    return (mClasses);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries in use by the
+ *    state-by-class next-state index.
+ *
+ *  @return  The number of entries in use, or zero if no index has
+ *           been built.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetNextStateIndexSize(void) const
+{
+    return (mClassStates * mClasses);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds the state that the specified event moves the
+ *    specified state to.
+ *
+ *  With event classes, this is a class map and next-state index
+ *  lookup; without, with guards or with a profile, it is a
+ *  transition lookup. The index only records the arc of the first
+ *  event of each class, so profiling through it would charge that
+ *  arc rather than the one actually taken.
+ *
+ *  @param[in]   inState   A reference to the starting state.
+ *  @param[in]   inEvent   A reference to the event.
+ *  @param[out]  outState  The next state, if any.
+ *
+ *  @return  \c true if the event has a transition out of the state;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::FindNextState(const State &inState, const Event &inEvent, State &outState) const
+{
+    const Transition * theTransition;
+    Offset             theOffset;
+
+    if ((mClassIndex == NULL) ||
+        (mGuards != NULL) ||
+        (mProfile != NULL))
+    {
+        theTransition = FindEnabledTransition(inState, inEvent);
+
+        if (theTransition == NULL)
+            return (false);
+
+        outState = theTransition->mEnd;
+
+        return (true);
+    }
+
+    if ((inState >= mClassStates) || (inEvent >= mClassEvents))
+        return (false);
+
+    theOffset = mClassIndex[(static_cast<size_t>(inState) * mClasses) + mClassMap[inEvent]];
+
+    if (theOffset == kOffsetNone)
+        return (false);
+
+    outState = mFirstTransition[theOffset].mEnd;
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets whether all self-loops are internal.
+ *
+ *  @return  The self-loop policy.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicMachine<StateType, EventType>::SelfLoop
+BasicMachine<StateType, EventType>::GetSelfLoopPolicy(void) const
+{
+    return mSelfLoopPolicy;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets whether all self-loops are internal, that is,
+ *    taken without exiting and re-entering their state.
+ *
+ *  @param[in]  inPolicy  The self-loop policy to set.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::SetSelfLoopPolicy(SelfLoop inPolicy)
+{
+    mSelfLoopPolicy = inPolicy;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words required for the internal
+ *    transition flags of the current transition table.
+ *
+ *  @return  The number of words required, one bit per transition.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetInternalTransitionsSize(void) const
+{
+    return ((mCount + kMaskBits - 1) / kMaskBits);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the internal transition flags, in which bit
+ *    (offset % 32) of word (offset / 32) is set for each transition,
+ *    by offset in the table, that is internal.
+ *
+ *  Only self-loops are taken as internal; flags on transitions to
+ *  another state are ignored. The flags must remain valid until the
+ *  transition table is next set or the flags are cleared.
+ *
+ *  @param[in]  inFlags  The internal transition flags.
+ *  @param[in]  inSize   The number of words of flags, at least that
+ *                       returned by #GetInternalTransitionsSize.
+ *
+ *  @return  \c true if the flags were set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetInternalTransitions(const Mask inFlags[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(inFlags != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= GetInternalTransitionsSize(), done, retval = false);
+
+    mInternal = inFlags;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine clears the internal transition flags, such that
+ *    only the self-loop policy determines which transitions are
+ *    internal.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearInternalTransitions(void)
+{
+    mInternal = NULL;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether internal transition flags are
+ *    set.
+ *
+ *  @return  \c true if flags are set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::HasInternalTransitions(void) const
+{
+    return (mInternal != NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the specified transition is
+ *    internal, that is, a self-loop taken without exiting and
+ *    re-entering its state.
+ *
+ *  A self-loop is internal if the self-loop policy makes all
+ *  self-loops internal or if it is in the transition table and its
+ *  internal transition flag is set.
+ *
+ *  @param[in]  inTransition  A reference to the transition to test.
+ *
+ *  @return  \c true if the transition is internal; otherwise,
+ *           \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::IsInternalTransition(const Transition &inTransition) const
+{
+    size_t theOffset;
+
+    if (inTransition.mStart != inTransition.mEnd)
+        return (false);
+
+    if (mSelfLoopPolicy == kSelfLoopInternal)
+        return (true);
+
+    if ((mInternal == NULL) || (&inTransition < mFirstTransition) || (&inTransition >= (mFirstTransition + mCount)))
+        return (false);
+
+    theOffset = static_cast<size_t>(&inTransition - mFirstTransition);
+
+    return ((mInternal[theOffset / kMaskBits] & (static_cast<Mask>(1) << (theOffset % kMaskBits))) != 0);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the actions of the transitions, one for each
+ *    transition, by offset in the table.
+ *
+ *  The actions must remain valid until the transition table is next
+ *  set or the actions are cleared.
+ *
+ *  @param[in]  inActions  The action of each transition.
+ *  @param[in]  inSize     The number of actions, at least the number
+ *                         of transitions.
+ *
+ *  @return  \c true if the actions were set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetActions(const Action inActions[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(inActions != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= mCount, done, retval = false);
+
+    mActions = inActions;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine clears the actions of the transitions.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearActions(void)
+{
+    mActions = NULL;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the transitions have actions.
+ *
+ *  @return  \c true if actions are set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::HasActions(void) const
+{
+    return (mActions != NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the action of the specified transition.
+ *
+ *  @param[in]  inTransition  A reference to the transition, in the
+ *                            transition table, to get the action of.
+ *
+ *  @return  A pointer to the action if the transition is in the table
+ *           and has an action function; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const typename BasicMachine<StateType, EventType>::Action *
+BasicMachine<StateType, EventType>::GetAction(const Transition &inTransition) const
+{
+    const Action * theAction;
+
+    if ((mActions == NULL) || (&inTransition < mFirstTransition) || (&inTransition >= (mFirstTransition + mCount)))
+        return (NULL);
+
+    theAction = &mActions[&inTransition - mFirstTransition];
+
+    return ((theAction->mFunction != NULL) ? theAction : NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the output events of the transitions, one for
+ *    each transition, by offset in the table, making the machine a
+ *    Mealy machine.
+ *
+ *  A transition without an output has Transition::kNoEvent as its
+ *  output. The outputs must remain valid until the transition table
+ *  is next set or the outputs are cleared.
+ *
+ *  @param[in]  inOutputs  The output event of each transition.
+ *  @param[in]  inSize     The number of outputs, at least the number
+ *                         of transitions.
+ *
+ *  @return  \c true if the outputs were set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetOutputs(const Event inOutputs[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(inOutputs != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= mCount, done, retval = false);
+
+    mOutputs = inOutputs;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine clears the output events of the transitions.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearOutputs(void)
+{
+    mOutputs = NULL;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the transitions have output
+ *    events.
+ *
+ *  @return  \c true if outputs are set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::HasOutputs(void) const
+{
+    return (mOutputs != NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the output event of the specified transition.
+ *
+ *  @param[in]   inTransition  A reference to the transition, in the
+ *                             transition table, to get the output of.
+ *  @param[out]  outOutput     The output event, if any.
+ *
+ *  @return  \c true if the transition is in the table and has an
+ *           output; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::GetOutput(const Transition &inTransition, Event &outOutput) const
+{
+    if ((mOutputs == NULL) || (&inTransition < mFirstTransition) || (&inTransition >= (mFirstTransition + mCount)))
+        return (false);
+
+    outOutput = mOutputs[&inTransition - mFirstTransition];
+
+    return (outOutput != static_cast<Event>(Transition::kNoEvent));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entry or exit handlers required
+ *    to cover every state of the current transition table.
+ *
+ *  @return  The number of handlers required, one more than the
+ *           largest starting or ending state in the table, or zero if
+ *           the table is empty or the states are too large to index.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetStateHandlersSize(void) const
+{
+    State theMaxState = 0;
+    size_t i;
+
+    if ((mFirstTransition == NULL) || (mCount == 0))
+        return (0);
+
+    for (i = 0; i < mCount; i++) {
+        if (mFirstTransition[i].mStart > theMaxState)
+            theMaxState = mFirstTransition[i].mStart;
+
+        if (mFirstTransition[i].mEnd > theMaxState)
+            theMaxState = mFirstTransition[i].mEnd;
+    }
+
+    if (static_cast<uint64_t>(theMaxState) >= SIZE_MAX)
+        return (0);
+
+    return (static_cast<size_t>(theMaxState) + 1);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the entry and exit handlers of the states, one
+ *    of each for each state, by state.
+ *
+ *  Either array may be NULL for no handlers of that kind. The
+ *  handlers must remain valid until the transition table is next set
+ *  or the handlers are cleared.
+ *
+ *  @param[in]  inOnEnter  The entry handler of each state, or NULL.
+ *  @param[in]  inOnExit   The exit handler of each state, or NULL.
+ *  @param[in]  inSize     The number of handlers in each array, at
+ *                         least that returned by
+ *                         #GetStateHandlersSize.
+ *
+ *  @return  \c true if the handlers were set; otherwise, \c false,
+ *           in which case any existing handlers are unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetStateHandlers(const Action inOnEnter[],
+                                                     const Action inOnExit[],
+                                                     size_t inSize)
+{
+    const size_t theStates = GetStateHandlersSize();
+    bool retval = true;
+
+    nlREQUIRE_ACTION((inOnEnter != NULL) || (inOnExit != NULL), done, retval = false);
+    nlREQUIRE_ACTION(theStates != 0, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= theStates, done, retval = false);
+
+    mEnterHandlers = inOnEnter;
+    mExitHandlers  = inOnExit;
+    mHandlerStates = inSize;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine clears the entry and exit handlers of the states.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearStateHandlers(void)
+{
+    mEnterHandlers = NULL;
+    mExitHandlers  = NULL;
+    mHandlerStates = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the states have entry or exit
+ *    handlers.
+ *
+ *  @return  \c true if handlers are set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::HasStateHandlers(void) const
+{
+    return (mHandlerStates != 0);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the entry handler of the specified state.
+ *
+ *  @param[in]  inState  A reference to the state to get the entry
+ *                       handler of.
+ *
+ *  @return  A pointer to the handler if the state has one with a
+ *           function; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const typename BasicMachine<StateType, EventType>::Action *
+BasicMachine<StateType, EventType>::GetEnterHandler(const State &inState) const
+{
+    const Action * theHandler;
+
+    if ((mEnterHandlers == NULL) || (static_cast<uint64_t>(inState) >= mHandlerStates))
+        return (NULL);
+
+    theHandler = &mEnterHandlers[inState];
+
+    return ((theHandler->mFunction != NULL) ? theHandler : NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the exit handler of the specified state.
+ *
+ *  @param[in]  inState  A reference to the state to get the exit
+ *                       handler of.
+ *
+ *  @return  A pointer to the handler if the state has one with a
+ *           function; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const typename BasicMachine<StateType, EventType>::Action *
+BasicMachine<StateType, EventType>::GetExitHandler(const State &inState) const
+{
+    const Action * theHandler;
+
+    if ((mExitHandlers == NULL) || (static_cast<uint64_t>(inState) >= mHandlerStates))
+        return (NULL);
+
+    theHandler = &mExitHandlers[inState];
+
+    return ((theHandler->mFunction != NULL) ? theHandler : NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the guards of the transitions, one for each
+ *    transition, by offset in the table.
+ *
+ *  The guards must remain valid until the transition table is next
+ *  set or the guards are cleared.
+ *
+ *  @param[in]  inGuards  The guard of each transition.
+ *  @param[in]  inSize    The number of guards, at least the number
+ *                        of transitions.
+ *
+ *  @return  \c true if the guards were set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetGuards(const Guard inGuards[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(inGuards != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= mCount, done, retval = false);
+
+    mGuards = inGuards;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine clears the guards of the transitions, after which
+ *    only the first transition for a state and event is taken.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearGuards(void)
+{
+    mGuards = NULL;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the transitions have guards.
+ *
+ *  @return  \c true if guards are set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::HasGuards(void) const
+{
+    return (mGuards != NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine starts caching the most recently found transitions
+ *    in the specified storage.
+ *
+ *  The results of lookups, whether or not a transition was found,
+ *  replace the cache entries in turn and every lookup first checks
+ *  each entry, so a handful of entries suffice for bursts of repeated
+ *  events; a single entry makes the check one comparison. Since every
+ *  lookup strategy finds the same transitions, the cache stays valid
+ *  across changes of strategy. The storage must remain valid until
+ *  the transition table is next set or caching is stopped.
+ *
+ *  @param[in,out]  ioCache  Storage for the cache entries.
+ *  @param[in]      inSize   The number of entries available in the
+ *                           storage.
+ *
+ *  @return  \c true if caching started; otherwise, \c false, in
+ *           which case any previous caching continues.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetTransitionCache(SortedEntry ioCache[], size_t inSize)
+{
+    size_t i;
+    bool   retval = true;
+
+    nlREQUIRE_ACTION(ioCache != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize > 0, done, retval = false);
+    nlREQUIRE_ACTION(mCount < kOffsetAbsent, done, retval = false);
+
+    for (i = 0; i < inSize; i++)
+        ioCache[i].mOffset = kOffsetNone;
+
+    mCache     = ioCache;
+    mCacheSize = inSize;
+    mCacheNext = 0;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine stops caching found transitions, releasing the
+ *    cache storage.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearTransitionCache(void)
+{
+    mCache     = NULL;
+    mCacheSize = 0;
+    mCacheNext = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries in the transition
+ *    cache.
+ *
+ *  @return  The number of entries, or zero if not caching.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetTransitionCacheSize(void) const
+{
+    return mCacheSize;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds the result of a lookup in the cache.
+ *
+ *  @param[in]   inKey            The packed starting state and event
+ *                                key to find a transition for.
+ *  @param[out]  outTransition    A pointer to the cached transition,
+ *                                or NULL if the cache holds that none
+ *                                exists.
+ *
+ *  @return  \c true if the cache holds the result; otherwise,
+ *           \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::FindCached(const Key &inKey, const Transition *&outTransition) const
+{
+    size_t i;
+
+    for (i = 0; i < mCacheSize; i++) {
+        if ((mCache[i].mKey == inKey) && (mCache[i].mOffset != kOffsetNone)) {
+            outTransition = (mCache[i].mOffset == kOffsetAbsent) ? NULL : (mFirstTransition + mCache[i].mOffset);
+
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine caches the result of a lookup in place of the next
+ *    cache entry in turn.
+ *
+ *  @param[in]  inKey          The packed starting state and event key
+ *                             looked up.
+ *  @param[in]  inTransition   A pointer to the transition found, if
+ *                             any.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::Remember(const Key &inKey, const Transition *inTransition) const
+{
+    mCache[mCacheNext].mKey    = inKey;
+    mCache[mCacheNext].mOffset = (inTransition == NULL) ? kOffsetAbsent : static_cast<Offset>(inTransition - mFirstTransition);
+
+    if (++mCacheNext == mCacheSize)
+        mCacheNext = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine starts profiling the machine, counting each time
+ *    a transition is found into the specified storage.
+ *
+ *  The counts are accumulated onto the storage as is, so it should
+ *  be zeroed to start a new profile, and must remain valid until the
+ *  transition table is next set or profiling is stopped. Transitions
+ *  found through the next-state index of the event classes are
+ *  counted as well, against the first transition for the state and
+ *  event that the index refers to.
+ *
+ *  @param[in,out]  ioCounts  Storage for the count of each
+ *                            transition, indexed by its offset in
+ *                            the table.
+ *  @param[in]      inSize    The number of counts available in the
+ *                            storage, at least the number of
+ *                            transitions.
+ *
+ *  @return  \c true if profiling started; otherwise, \c false, in
+ *           which case any previous profiling continues.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::SetProfile(Count ioCounts[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(ioCounts != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= mCount, done, retval = false);
+
+    mProfile = ioCounts;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine stops profiling the machine, releasing the count
+ *    storage, which keeps the counts so far.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::ClearProfile(void)
+{
+    mProfile = NULL;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the per-transition hit counts of the machine.
+ *
+ *  @return  A pointer to the count storage if profiling; otherwise,
+ *           NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicMachine<StateType, EventType>::Count *
+BasicMachine<StateType, EventType>::GetProfile(void) const
+{
+    return mProfile;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine counts a hit on the transition at the specified
+ *    offset, saturating rather than wrapping.
+ *
+ *  @param[in]  inOffset  The offset of the transition found.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMachine<StateType, EventType>::Hit(Offset inOffset) const
+{
+    if (mProfile[inOffset] != UINT32_MAX)
+        mProfile[inOffset]++;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds a transition with a linear scan of the
+ *    transition table.
+ *
+ *  @param[in]  inState  A reference to the starting state to find a
+ *                       transition for.
+ *  @param[in]  inEvent  A reference to the event associated with the
+ *                       starting state to find a transition for.
+ *
+ *  @return  A pointer to the first transition matching the specified
+ *           state and event if successful; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindLinear(const State & inState, const Event & inEvent) const
+{
+    const Transition * start = mFirstTransition;
+    const Transition * end = mFirstTransition + mCount;
+    const FindTransitionPredicate<StateType, EventType> theFinder(inState, inEvent);
+
+    while ((start != end) && !bool(theFinder(start))) {
+        ++start;
+    }
+
+    return ((start != end) ? start : NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds a transition with a single dense index
+ *    lookup.
+ *
+ *  @param[in]  inState  A reference to the starting state to find a
+ *                       transition for.
+ *  @param[in]  inEvent  A reference to the event associated with the
+ *                       starting state to find a transition for.
+ *
+ *  @return  A pointer to the first transition matching the specified
+ *           state and event if successful; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindDense(const State & inState, const Event & inEvent) const
+{
+    Offset theOffset;
+
+    if ((inState >= mDenseStates) || (inEvent >= mDenseEvents))
+        return (NULL);
+
+    theOffset = mDenseIndex[(static_cast<size_t>(inState) * mDenseEvents) + inEvent];
+
+    return ((theOffset != kOffsetNone) ? (mFirstTransition + theOffset) : NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds a transition with a binary search of the
+ *    sorted index.
+ *
+ *  @param[in]  inState  A reference to the starting state to find a
+ *                       transition for.
+ *  @param[in]  inEvent  A reference to the event associated with the
+ *                       starting state to find a transition for.
+ *
+ *  @return  A pointer to the first transition matching the specified
+ *           state and event if successful; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindSorted(const State & inState, const Event & inEvent) const
+{
+    const Key           theKey = Transition::MakeKey(inState, inEvent);
+    const SortedEntry * theBase = mSortedIndex;
+    size_t              theLength = mCount;
+
+    if (theLength == 0)
+        return (NULL);
+
+    // Find the first entry whose key is not less than the key
+    // sought. The number of iterations depends only on the index
+    // size and each selects the next base with a conditional move
+    // rather than a branch, so lookups neither mispredict nor vary
+    // in latency with the key.
+
+    while (theLength > 1) {
+        const size_t theHalf = theLength / 2;
+
+        theBase    = (theBase[theHalf].mKey < theKey) ? theBase + theHalf : theBase;
+        theLength -= theHalf;
+    }
+
+    theBase += (theBase->mKey < theKey);
+
+    if ((theBase < (mSortedIndex + mCount)) && (theBase->mKey == theKey))
+        return (mFirstTransition + theBase->mOffset);
+
+    return (NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds the first transition for the specified state
+ *    and event by descending the Eytzinger-ordered index.
+ *
+ *  @param[in]  inState  A reference to the starting state to find a
+ *                       transition for.
+ *  @param[in]  inEvent  A reference to the event associated with the
+ *                       starting state to find a transition for.
+ *
+ *  @return  A pointer to the first transition matching the specified
+ *           state and event if successful; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindEytzinger(const State & inState, const Event & inEvent) const
+{
+    const Key theKey = Transition::MakeKey(inState, inEvent);
+    size_t    k = 1;
+
+    // Descend to a leaf, going right whenever the entry is less than
+    // the key sought.
+
+    while (k <= mCount)
+        k = (2 * k) + (mSortedIndex[k].mKey < theKey);
+
+    // The first entry not less than the key sought is where the
+    // descent last went left: strip the trailing right turns and that
+    // left turn. No such entry leaves the root sentinel position.
+
+    k >>= __builtin_ffsll(~static_cast<unsigned long long>(k));
+
+    if ((k != 0) && (mSortedIndex[k].mKey == theKey))
+        return (mFirstTransition + mSortedIndex[k].mOffset);
+
+    return (NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine finds the first transition for the specified state
+ *    and event by probing the perfect hash index.
+ *
+ *  @param[in]  inState  A reference to the starting state to find a
+ *                       transition for.
+ *  @param[in]  inEvent  A reference to the event associated with the
+ *                       starting state to find a transition for.
+ *
+ *  @return  A pointer to the first transition matching the specified
+ *           state and event if successful; otherwise, NULL.
+ *
+ */
+template <typename StateType, typename EventType>
+const BasicTransition<StateType, EventType> *
+BasicMachine<StateType, EventType>::FindHash(const State & inState, const Event & inEvent) const
+{
+    const Key theKey = Transition::MakeKey(inState, inEvent);
+    Offset    theOffset;
+
+    if (mCount == 0)
+        return (NULL);
+
+    // Every key hashes to some slot, so the transition found must be
+    // verified against the key sought.
+
+    theOffset = mHashIndex[mHashBuckets + HashSlot(theKey, mHashIndex[HashBucket(theKey, mHashBuckets)], mHashSlots)];
+
+    if ((theOffset != kOffsetNone) && (mFirstTransition[theOffset].GetKey() == theKey))
+        return (mFirstTransition + theOffset);
+
+    return (NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of buckets of a perfect hash index
+ *    of the current transition table.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetHashBuckets(void) const
+{
+    return ((mCount + kHashBucketLoad - 1) / kHashBucketLoad);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of slots of a perfect hash index of
+ *    the current transition table, one per transition plus spares.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMachine<StateType, EventType>::GetHashSlots(void) const
+{
+    return (mCount + ((mCount + kHashSlotSlack - 1) / kHashSlotSlack));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine fills the specified storage with an index of the
+ *    current transition table sorted by packed starting state and
+ *    event key and, for equal keys, by table offset.
+ *
+ *  @param[out]  outIndex  Storage for the index.
+ *  @param[in]   inSize    The number of entries available in the
+ *                         storage, at least that returned by
+ *                         #GetSortedIndexSize.
+ *
+ *  @return  \c true if the index was built; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::BuildSortedIndex(SortedEntry outIndex[], size_t inSize) const
+{
+    size_t i;
+    bool   retval = true;
+
+    nlREQUIRE_ACTION(outIndex != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= mCount, done, retval = false);
+    nlREQUIRE_ACTION(mCount < kOffsetNone, done, retval = false);
+
+    for (i = 0; i < mCount; i++) {
+        outIndex[i].mKey    = mFirstTransition[i].GetKey();
+        outIndex[i].mOffset = static_cast<Offset>(i);
+    }
+
+    HeapSort(outIndex, mCount, EntryOrder<SortedEntry>());
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines the dimensions of a dense index of the
+ *    current transition table.
+ *
+ *  @param[out]  outStates  The number of states (i.e., rows).
+ *  @param[out]  outEvents  The number of events (i.e., columns).
+ *
+ *  @return  \c true if the table may be densely indexed; otherwise,
+ *           \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::GetDenseDimensions(size_t &outStates, size_t &outEvents) const
+{
+    State theMaxState = 0;
+    Event theMaxEvent = 0;
+    size_t i;
+
+    outStates = 0;
+    outEvents = 0;
+
+    if ((mFirstTransition == NULL) || (mCount == 0) || (mCount >= kOffsetNone))
+        return (false);
+
+    for (i = 0; i < mCount; i++) {
+        if (mFirstTransition[i].mStart > theMaxState)
+            theMaxState = mFirstTransition[i].mStart;
+
+        if (mFirstTransition[i].mEvent > theMaxEvent)
+            theMaxEvent = mFirstTransition[i].mEvent;
+    }
+
+    if ((static_cast<uint64_t>(theMaxState) >= SIZE_MAX) ||
+        (static_cast<uint64_t>(theMaxEvent) >= SIZE_MAX))
+        return (false);
+
+    outStates = static_cast<size_t>(theMaxState) + 1;
+    outEvents = static_cast<size_t>(theMaxEvent) + 1;
+
+    if (outStates > (SIZE_MAX / sizeof (Offset) / outEvents)) {
+        outStates = 0;
+        outEvents = 0;
+        return (false);
+    }
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether two dense index entries lead to
+ *    the same next state, where an entry without a transition leads
+ *    only to the same as another without.
+ *
+ *  @param[in]  inFirst   The first entry to compare.
+ *  @param[in]  inSecond  The second entry to compare.
+ *
+ *  @return  \c true if the entries lead to the same next state;
+ *           otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMachine<StateType, EventType>::IsSameNextState(Offset inFirst, Offset inSecond) const
+{
+    if ((inFirst == kOffsetNone) || (inSecond == kOffsetNone))
+        return (inFirst == inSecond);
+
+    return (mFirstTransition[inFirst].mEnd == mFirstTransition[inSecond].mEnd);
+}
+
+// Explicit Instantiations
+
+template class BasicMachine<uint8_t, uint8_t>;
+template class BasicMachine<uint16_t, uint16_t>;
+template class BasicMachine<uint32_t, uint32_t>;
+
 }; // namespace Fsm
 
 }; // namespace nl
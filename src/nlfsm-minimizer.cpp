@@ -0,0 +1,673 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for minimizing a finite state
+ *      machine (FSM) transition table by merging equivalent states.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+#include <nestlabs/fsm/nlfsm-minimizer.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+namespace nl {
+
+namespace Fsm {
+
+// Preprocessor Definitions
+
+/**
+ *  The value indicating that no state has yet been chosen to
+ *  represent a block.
+ */
+#define kWordNone   UINT32_MAX
+
+// Type Definitions
+
+/**
+ *
+ *  @struct Partition
+ *
+ *  @brief
+ *    A refinable partition of the integers [0, n) into sets, each a
+ *    contiguous range of an element array, which may be split by
+ *    marking some of a set's elements.
+ *
+ */
+struct Partition
+{
+    uint32_t    mSets;          //!< The number of sets.
+    uint32_t *  mElements;      //!< The elements, grouped by set.
+    uint32_t *  mLocations;     //!< The location of each element.
+    uint32_t *  mSetOf;         //!< The set of each element.
+    uint32_t *  mFirst;         //!< The first location of each set.
+    uint32_t *  mPast;          //!< One past the last location of each
+                                //!< set.
+};
+
+/**
+ *
+ *  @struct Marks
+ *
+ *  @brief
+ *    The marked element counts per set and the list of sets with
+ *    marked elements, shared by partitions split one after another.
+ *
+ */
+struct Marks
+{
+    uint32_t *  mMarked;        //!< The number of marked elements of
+                                //!< each set.
+    uint32_t *  mTouched;       //!< The sets with marked elements.
+    uint32_t    mCount;         //!< The number of sets with marked
+                                //!< elements.
+};
+
+/**
+ *
+ *  @class LabelOrder
+ *
+ *  @brief
+ *   Heap sort predicate object that orders arcs, each an index into
+ *   an array of transition table offsets, by event and index.
+ *
+ */
+template <typename Transition>
+class LabelOrder
+{
+ public:
+    LabelOrder(const Transition inTransitions[], const uint32_t inArcs[]) :
+        mTransitions(inTransitions),
+        mArcs(inArcs)
+    {
+        return;
+    }
+
+    bool operator ()(uint32_t inFirst, uint32_t inSecond) const
+    {
+        const Transition &theFirst  = mTransitions[mArcs[inFirst]];
+        const Transition &theSecond = mTransitions[mArcs[inSecond]];
+
+        if (theFirst.mEvent != theSecond.mEvent)
+            return (theFirst.mEvent < theSecond.mEvent);
+
+        return (inFirst < inSecond);
+    }
+
+ private:
+    const Transition *  mTransitions;
+    const uint32_t *    mArcs;
+};
+
+/**
+ *
+ *  @class ClassOrder
+ *
+ *  @brief
+ *   Heap sort predicate object that orders states by initial
+ *   partition class and state.
+ *
+ */
+class ClassOrder
+{
+ public:
+    ClassOrder(const uint32_t inClasses[]) :
+        mClasses(inClasses)
+    {
+        return;
+    }
+
+    bool operator ()(uint32_t inFirst, uint32_t inSecond) const
+    {
+        if (mClasses[inFirst] != mClasses[inSecond])
+            return (mClasses[inFirst] < mClasses[inSecond]);
+
+        return (inFirst < inSecond);
+    }
+
+ private:
+    const uint32_t *    mClasses;
+};
+
+/**
+ *
+ *  @brief
+ *    This function initializes the specified partition with its
+ *    elements in a single set.
+ *
+ */
+static void
+Initialize(Partition &ioPartition, uint32_t inElements)
+{
+    uint32_t i;
+
+    ioPartition.mSets = (inElements > 0) ? 1 : 0;
+
+    for (i = 0; i < inElements; i++) {
+        ioPartition.mElements[i]  = i;
+        ioPartition.mLocations[i] = i;
+        ioPartition.mSetOf[i]     = 0;
+    }
+
+    if (inElements > 0) {
+        ioPartition.mFirst[0] = 0;
+        ioPartition.mPast[0]  = inElements;
+    }
+}
+
+/**
+ *
+ *  @brief
+ *    This function marks the specified element by moving it into the
+ *    marked prefix of its set, if it is not already marked.
+ *
+ */
+static void
+Mark(Partition &ioPartition, Marks &ioMarks, uint32_t inElement)
+{
+    const uint32_t theSet      = ioPartition.mSetOf[inElement];
+    const uint32_t theLocation = ioPartition.mLocations[inElement];
+    const uint32_t theMarked   = ioPartition.mFirst[theSet] + ioMarks.mMarked[theSet];
+
+    if (theLocation < theMarked)
+        return;
+
+    ioPartition.mElements[theLocation] = ioPartition.mElements[theMarked];
+    ioPartition.mLocations[ioPartition.mElements[theLocation]] = theLocation;
+    ioPartition.mElements[theMarked] = inElement;
+    ioPartition.mLocations[inElement] = theMarked;
+
+    if (ioMarks.mMarked[theSet]++ == 0)
+        ioMarks.mTouched[ioMarks.mCount++] = theSet;
+}
+
+/**
+ *
+ *  @brief
+ *    This function splits every set with marked elements into its
+ *    marked and unmarked elements, giving the smaller of the two a new
+ *    set, and clears the marks.
+ *
+ */
+static void
+Split(Partition &ioPartition, Marks &ioMarks)
+{
+    while (ioMarks.mCount > 0) {
+        const uint32_t theSet    = ioMarks.mTouched[--ioMarks.mCount];
+        const uint32_t theMarked = ioPartition.mFirst[theSet] + ioMarks.mMarked[theSet];
+        const uint32_t theNew    = ioPartition.mSets;
+        uint32_t       i;
+
+        if (theMarked == ioPartition.mPast[theSet]) {
+            ioMarks.mMarked[theSet] = 0;
+            continue;
+        }
+
+        if (ioMarks.mMarked[theSet] <= (ioPartition.mPast[theSet] - theMarked)) {
+            ioPartition.mFirst[theNew] = ioPartition.mFirst[theSet];
+            ioPartition.mPast[theNew]  = theMarked;
+            ioPartition.mFirst[theSet] = theMarked;
+        } else {
+            ioPartition.mPast[theNew]  = ioPartition.mPast[theSet];
+            ioPartition.mFirst[theNew] = theMarked;
+            ioPartition.mPast[theSet]  = theMarked;
+        }
+
+        for (i = ioPartition.mFirst[theNew]; i < ioPartition.mPast[theNew]; i++)
+            ioPartition.mSetOf[ioPartition.mElements[i]] = theNew;
+
+        ioMarks.mMarked[theSet] = 0;
+        ioMarks.mMarked[theNew] = 0;
+        ioPartition.mSets++;
+    }
+}
+
+/**
+ *
+ *  @brief
+ *    This function regroups the elements of a single-set partition,
+ *    already sorted by key, into one set per distinct key.
+ *
+ *  @param[in,out]  ioPartition  The partition to regroup.
+ *  @param[in]      inElements   The number of elements.
+ *  @param[in]      inKeys       The key of each element.
+ *
+ */
+template <typename Key>
+static void
+Group(Partition &ioPartition, uint32_t inElements, const Key &inKeys)
+{
+    uint32_t i;
+
+    if (inElements == 0)
+        return;
+
+    ioPartition.mSets     = 0;
+    ioPartition.mFirst[0] = 0;
+
+    for (i = 0; i < inElements; i++) {
+        const uint32_t theElement = ioPartition.mElements[i];
+
+        if ((i > 0) && (inKeys(theElement) != inKeys(ioPartition.mElements[i - 1]))) {
+            ioPartition.mPast[ioPartition.mSets++] = i;
+            ioPartition.mFirst[ioPartition.mSets]  = i;
+        }
+
+        ioPartition.mSetOf[theElement]     = ioPartition.mSets;
+        ioPartition.mLocations[theElement] = i;
+    }
+
+    ioPartition.mPast[ioPartition.mSets++] = inElements;
+}
+
+/**
+ *  Key object yielding the event of an arc.
+ */
+template <typename Transition>
+class LabelKey
+{
+ public:
+    LabelKey(const Transition inTransitions[], const uint32_t inArcs[]) :
+        mTransitions(inTransitions),
+        mArcs(inArcs)
+    {
+        return;
+    }
+
+    typename Transition::Event operator ()(uint32_t inArc) const
+    {
+        return (mTransitions[mArcs[inArc]].mEvent);
+    }
+
+ private:
+    const Transition *  mTransitions;
+    const uint32_t *    mArcs;
+};
+
+/**
+ *  Key object yielding the initial partition class of a state.
+ */
+class ClassKey
+{
+ public:
+    ClassKey(const uint32_t inClasses[]) :
+        mClasses(inClasses)
+    {
+        return;
+    }
+
+    uint32_t operator ()(uint32_t inState) const
+    {
+        return (mClasses[inState]);
+    }
+
+ private:
+    const uint32_t *    mClasses;
+};
+
+/**
+ *
+ *  @brief
+ *    This routine is the class default (i.e. void) constructor. It
+ *    instantiates the minimizer without workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicMinimizer<StateType, EventType>::BasicMinimizer(void) :
+    mWorkspace(NULL),
+    mSize(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the
+ *    minimizer with the specified workspace.
+ *
+ *  @param[in]  inWorkspace  The workspace to minimize within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicMinimizer<StateType, EventType>::BasicMinimizer(Word inWorkspace[], size_t inSize) :
+    mWorkspace(inWorkspace),
+    mSize(inSize)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the workspace to minimize within.
+ *
+ *  @param[in]  inWorkspace  The workspace to minimize within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicMinimizer<StateType, EventType>::SetWorkspace(Word inWorkspace[], size_t inSize)
+{
+    mWorkspace = inWorkspace;
+    mSize      = inSize;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of states of the specified
+ *    transition table, that is, one more than the largest state in
+ *    the table or the initial state.
+ *
+ *  @param[in]  inTransitions   The transition table.
+ *  @param[in]  inCount         The number of transitions in the table.
+ *  @param[in]  inInitialState  A reference to the initial state.
+ *
+ *  @return  The number of states, or zero if too many to minimize.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMinimizer<StateType, EventType>::GetStateCount(const Transition inTransitions[],
+                                                    size_t inCount,
+                                                    const State &inInitialState)
+{
+    uint64_t theMaxState = inInitialState;
+    size_t   i;
+
+    for (i = 0; i < inCount; i++) {
+        if (inTransitions[i].mStart > theMaxState)
+            theMaxState = inTransitions[i].mStart;
+
+        if (inTransitions[i].mEnd > theMaxState)
+            theMaxState = inTransitions[i].mEnd;
+    }
+
+    if ((theMaxState >= (kWordNone - 1)) || (theMaxState >= (SIZE_MAX / 16)))
+        return (0);
+
+    return (static_cast<size_t>(theMaxState) + 1);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of workspace required to
+ *    minimize the specified transition table.
+ *
+ *  @param[in]  inTransitions   The transition table.
+ *  @param[in]  inCount         The number of transitions in the table.
+ *  @param[in]  inInitialState  A reference to the initial state.
+ *
+ *  @return  The number of words required, or zero if the table is too
+ *           large to minimize.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicMinimizer<StateType, EventType>::GetWorkspaceSize(const Transition inTransitions[],
+                                                       size_t inCount,
+                                                       const State &inInitialState)
+{
+    const size_t theStates = GetStateCount(inTransitions, inCount, inInitialState);
+    const size_t theLarger = (theStates > inCount) ? theStates : inCount;
+
+    if ((theStates == 0) || (inCount >= (kWordNone - 1)) || (inCount >= (SIZE_MAX / 16)))
+        return (0);
+
+    // Arcs; state blocks; arc cords; marks; and arcs by ending state.
+
+    return (inCount + (5 * theStates) + (5 * inCount) + (2 * (theLarger + 1)) + inCount + (theStates + 1));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine minimizes the specified transition table.
+ *
+ *  The minimized table contains, for every state that represents a
+ *  block of equivalent states, the first transition for each of its
+ *  events, with ending states mapped to their representatives, sorted
+ *  by starting state and event. States that neither appear in the
+ *  table nor are the initial state are never merged with those that
+ *  do.
+ *
+ *  @param[in]      inTransitions   The transition table to minimize.
+ *  @param[in]      inCount         The number of transitions in the
+ *                                  table.
+ *  @param[in]      inInitialState  A reference to the initial state.
+ *  @param[in]      inPartition     An optional array, indexed by
+ *                                  state, of initial partition classes;
+ *                                  states of different classes are never
+ *                                  merged. If NULL, all states are
+ *                                  initially of the same class.
+ *  @param[out]     outTransitions  Storage for the minimized table,
+ *                                  which must not overlap the table to
+ *                                  minimize.
+ *  @param[in,out]  ioCount         On input, the number of transitions
+ *                                  available in the minimized table
+ *                                  storage; on output, the number of
+ *                                  transitions in the minimized table.
+ *  @param[out]     outStateMap     Storage for the state map, indexed
+ *                                  by original state, of the
+ *                                  representative of each state.
+ *  @param[in]      inStateMapSize  The number of states available in
+ *                                  the state map storage, at least that
+ *                                  returned by #GetStateCount.
+ *
+ *  @return  \c true if the table was minimized; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicMinimizer<StateType, EventType>::Minimize(const Transition inTransitions[],
+                                               size_t inCount,
+                                               const State &inInitialState,
+                                               const Word inPartition[],
+                                               Transition outTransitions[],
+                                               size_t &ioCount,
+                                               State outStateMap[],
+                                               size_t inStateMapSize) const
+{
+    const size_t theStates = GetStateCount(inTransitions, inCount, inInitialState);
+    const size_t theLarger = (theStates > inCount) ? theStates : inCount;
+    uint32_t *   theArcs;
+    uint32_t *   theByEnd;
+    uint32_t *   theEndFirst;
+    Partition    theBlocks;
+    Partition    theCords;
+    Marks        theMarks;
+    uint32_t     theArcCount = 0;
+    uint32_t     b, c;
+    size_t       i, j;
+    bool         retval = true;
+
+    nlREQUIRE_ACTION((inTransitions != NULL) || (inCount == 0), done, retval = false);
+    nlREQUIRE_ACTION(outTransitions != NULL, done, retval = false);
+    nlREQUIRE_ACTION(outStateMap != NULL, done, retval = false);
+    nlREQUIRE_ACTION(mWorkspace != NULL, done, retval = false);
+    nlREQUIRE_ACTION(theStates > 0, done, retval = false);
+    nlREQUIRE_ACTION(inStateMapSize >= theStates, done, retval = false);
+    nlREQUIRE_ACTION(mSize >= GetWorkspaceSize(inTransitions, inCount, inInitialState), done, retval = false);
+    nlREQUIRE_ACTION(mSize > 0, done, retval = false);
+
+    // Carve the workspace.
+
+    theArcs               = mWorkspace;
+    theBlocks.mElements   = theArcs + inCount;
+    theBlocks.mLocations  = theBlocks.mElements + theStates;
+    theBlocks.mSetOf      = theBlocks.mLocations + theStates;
+    theBlocks.mFirst      = theBlocks.mSetOf + theStates;
+    theBlocks.mPast       = theBlocks.mFirst + theStates;
+    theCords.mElements    = theBlocks.mPast + theStates;
+    theCords.mLocations   = theCords.mElements + inCount;
+    theCords.mSetOf       = theCords.mLocations + inCount;
+    theCords.mFirst       = theCords.mSetOf + inCount;
+    theCords.mPast        = theCords.mFirst + inCount;
+    theMarks.mMarked      = theCords.mPast + inCount;
+    theMarks.mTouched     = theMarks.mMarked + theLarger + 1;
+    theMarks.mCount       = 0;
+    theByEnd              = theMarks.mTouched + theLarger + 1;
+    theEndFirst           = theByEnd + inCount;
+
+    // Keep only the first transition for each state and event pair,
+    // as lookups do.
+
+    for (i = 0; i < inCount; i++)
+        theArcs[i] = static_cast<uint32_t>(i);
+
+    HeapSort(theArcs, inCount, ArcOrder<Transition>(inTransitions));
+
+    for (i = 0; i < inCount; i++) {
+        const Transition &theTransition = inTransitions[theArcs[i]];
+
+        if ((theArcCount > 0) &&
+            (inTransitions[theArcs[theArcCount - 1]].mStart == theTransition.mStart) &&
+            (inTransitions[theArcs[theArcCount - 1]].mEvent == theTransition.mEvent))
+            continue;
+
+        theArcs[theArcCount++] = theArcs[i];
+    }
+
+    for (i = 0; i <= theLarger; i++)
+        theMarks.mMarked[i] = 0;
+
+    // Start the blocks of states from the initial partition, if any.
+
+    Initialize(theBlocks, static_cast<uint32_t>(theStates));
+
+    if (inPartition != NULL) {
+        HeapSort(theBlocks.mElements, theStates, ClassOrder(inPartition));
+        Group(theBlocks, static_cast<uint32_t>(theStates), ClassKey(inPartition));
+    }
+
+    // Keep states absent from the table, which would otherwise be
+    // equivalent to any state without transitions out of it, apart
+    // from those present, such that no absent state represents a
+    // present one.
+
+    Mark(theBlocks, theMarks, static_cast<uint32_t>(inInitialState));
+
+    for (i = 0; i < inCount; i++) {
+        Mark(theBlocks, theMarks, static_cast<uint32_t>(inTransitions[i].mStart));
+        Mark(theBlocks, theMarks, static_cast<uint32_t>(inTransitions[i].mEnd));
+    }
+
+    Split(theBlocks, theMarks);
+
+    // Start the cords of arcs with one per event.
+
+    Initialize(theCords, theArcCount);
+
+    HeapSort(theCords.mElements, theArcCount, LabelOrder<Transition>(inTransitions, theArcs));
+    Group(theCords, theArcCount, LabelKey<Transition>(inTransitions, theArcs));
+
+    // Index the arcs by ending state.
+
+    for (i = 0; i <= theStates; i++)
+        theEndFirst[i] = 0;
+
+    for (i = 0; i < theArcCount; i++)
+        theEndFirst[inTransitions[theArcs[i]].mEnd]++;
+
+    for (i = 0; i < theStates; i++)
+        theEndFirst[i + 1] += theEndFirst[i];
+
+    for (i = theArcCount; i-- > 0; )
+        theByEnd[--theEndFirst[inTransitions[theArcs[i]].mEnd]] = static_cast<uint32_t>(i);
+
+    // Alternately split the blocks by the starting states of each
+    // cord and the cords by the ending states of each new block,
+    // until neither splits further. Every block but the first is
+    // used as a splitter: once the arcs of a cord into every other
+    // block are split off, those remaining lead into the first.
+
+    for (b = 1, c = 0; c < theCords.mSets; c++) {
+        for (i = theCords.mFirst[c]; i < theCords.mPast[c]; i++)
+            Mark(theBlocks, theMarks, inTransitions[theArcs[theCords.mElements[i]]].mStart);
+
+        Split(theBlocks, theMarks);
+
+        for (; b < theBlocks.mSets; b++) {
+            for (i = theBlocks.mFirst[b]; i < theBlocks.mPast[b]; i++) {
+                const uint32_t theState = theBlocks.mElements[i];
+
+                for (j = theEndFirst[theState]; j < theEndFirst[theState + 1]; j++)
+                    Mark(theCords, theMarks, theByEnd[j]);
+            }
+
+            Split(theCords, theMarks);
+        }
+    }
+
+    // Represent each block by its lowest state, using the marks, now
+    // unused, to record the representatives.
+
+    for (b = 0; b < theBlocks.mSets; b++)
+        theMarks.mTouched[b] = kWordNone;
+
+    for (i = 0; i < theStates; i++) {
+        uint32_t &theRepresentative = theMarks.mTouched[theBlocks.mSetOf[i]];
+
+        if (theRepresentative == kWordNone)
+            theRepresentative = static_cast<uint32_t>(i);
+
+        outStateMap[i] = static_cast<State>(theRepresentative);
+    }
+
+    // Emit the arcs out of each representative.
+
+    for (i = 0, j = 0; i < theArcCount; i++) {
+        const Transition &theTransition = inTransitions[theArcs[i]];
+
+        if (outStateMap[theTransition.mStart] != theTransition.mStart)
+            continue;
+
+        nlREQUIRE_ACTION(j < ioCount, done, retval = false);
+
+        outTransitions[j].mStart = theTransition.mStart;
+        outTransitions[j].mEvent = theTransition.mEvent;
+        outTransitions[j].mEnd   = outStateMap[theTransition.mEnd];
+        j++;
+    }
+
+    ioCount = j;
+
+ done:
+    return (retval);
+}
+
+// Explicit Instantiations
+
+template class BasicMinimizer<uint8_t, uint8_t>;
+template class BasicMinimizer<uint16_t, uint16_t>;
+template class BasicMinimizer<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
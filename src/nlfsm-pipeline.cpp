@@ -0,0 +1,360 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for chaining finite state
+ *      machines (FSMs) into a pipeline, each feeding its output events
+ *      to the next through a single-producer, single-consumer queue.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+#include <nestlabs/fsm/nlfsm-pipeline.hpp>
+
+namespace nl {
+
+namespace Fsm {
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the pipeline
+ *    with the specified stages, in order, and without queues.
+ *
+ *  Each stage's driver must be pointed at the stage's machine, whose
+ *  transitions should have outputs, and is not otherwise to be used
+ *  while the pipeline runs.
+ *
+ *  @param[in]  inStages  The driver of each stage. The array must
+ *                        remain valid for the life of the pipeline.
+ *  @param[in]  inCount   The number of stages.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicPipeline<StateType, EventType>::BasicPipeline(Driver * const inStages[], size_t inCount) :
+    mStages(inStages),
+    mCount(inCount),
+    mQueues(NULL)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets up the queues between the stages, initially
+ *    empty, splitting the specified event storage evenly among them,
+ *    and points each stage's driver output sink at its output queue.
+ *
+ *  The queues and storage must remain valid for the life of the
+ *  pipeline and must not be set while any stage is running.
+ *
+ *  @param[in,out]  ioQueues  Storage for the queues.
+ *  @param[in]      inQueues  The number of queues, one more than the
+ *                            number of stages.
+ *  @param[in,out]  ioEvents  Storage for the queued events.
+ *  @param[in]      inEvents  The number of events available in the
+ *                            storage, at least two for each queue.
+ *
+ *  @return  \c true if the queues were set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicPipeline<StateType, EventType>::SetQueues(Queue ioQueues[], size_t inQueues, Event ioEvents[], size_t inEvents)
+{
+    size_t theSize;
+    size_t i;
+    bool   retval = true;
+
+    nlREQUIRE_ACTION(mStages != NULL, done, retval = false);
+    nlREQUIRE_ACTION(ioQueues != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inQueues == (mCount + 1), done, retval = false);
+    nlREQUIRE_ACTION(ioEvents != NULL, done, retval = false);
+
+    // Each ring leaves one entry empty to tell full from empty, so
+    // holding at least one event takes two entries.
+
+    theSize = inEvents / inQueues;
+
+    nlREQUIRE_ACTION(theSize >= 2, done, retval = false);
+
+    for (i = 0; i < inQueues; i++) {
+        ioQueues[i].mEvents = &ioEvents[i * theSize];
+        ioQueues[i].mSize   = theSize;
+        ioQueues[i].mHead   = 0;
+        ioQueues[i].mTail   = 0;
+    }
+
+    for (i = 0; i < mCount; i++) {
+        mStages[i]->SetOutputSink(Output, &ioQueues[i + 1]);
+    }
+
+    mQueues = ioQueues;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of stages.
+ *
+ *  @return  The number of stages.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicPipeline<StateType, EventType>::GetStageCount(void) const
+{
+    return (mCount);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine pushes the specified event into the first queue, as
+ *    the input of the first stage.
+ *
+ *  Only one thread may push events at a time.
+ *
+ *  @param[in]  inEvent  A reference to the event to push.
+ *
+ *  @return  \c true if the event was queued; otherwise, \c false, if
+ *           the queue is full or not set.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicPipeline<StateType, EventType>::Push(const Event &inEvent)
+{
+    nlPRECONDITION_VALUE(mQueues != NULL, false);
+
+    return (Enqueue(mQueues[0], inEvent));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine pops the oldest event from the last queue, the
+ *    output of the last stage.
+ *
+ *  Only one thread may pop events at a time.
+ *
+ *  @param[out]  outEvent  The event popped, if any.
+ *
+ *  @return  \c true if an event was popped; otherwise, \c false, if
+ *           the queue is empty or not set.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicPipeline<StateType, EventType>::Pop(Event &outEvent)
+{
+    nlPRECONDITION_VALUE(mQueues != NULL, false);
+
+    return (Dequeue(mQueues[mCount], outEvent));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine runs the specified stage, handling up to the
+ *    specified number of events from its input queue with its driver,
+ *    while its output queue has room for every output the next event
+ *    might emit.
+ *
+ *  Only one thread may run each stage at a time, but each stage may
+ *  run in its own thread.
+ *
+ *  @param[in]  inStage  The stage to run.
+ *  @param[in]  inMax    The most events to take from the input queue.
+ *
+ *  @return  The number of events taken from the input queue, whether
+ *           or not they were handled, which is zero if the input
+ *           queue is empty or the output queue lacks room.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicPipeline<StateType, EventType>::RunStage(size_t inStage, size_t inMax)
+{
+    const Machine * theMachine;
+    Event           theEvent;
+    size_t          retval = 0;
+
+    nlPRECONDITION_VALUE(mQueues != NULL, 0);
+    nlPRECONDITION_VALUE(inStage < mCount, 0);
+
+    theMachine = mStages[inStage]->GetMachine();
+
+    while (retval < inMax) {
+        // Besides its own output, an event that moves the machine may
+        // recall, and emit an output for, every deferred event.
+
+        if (GetRoom(mQueues[inStage + 1]) < (theMachine->GetDeferredEventCount() + 1))
+            break;
+
+        if (!Dequeue(mQueues[inStage], theEvent))
+            break;
+
+        mStages[inStage]->HandleEvent(theEvent);
+
+        retval++;
+    }
+
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of events the specified queue has
+ *    room for, as seen by its producer.
+ *
+ *  @param[in]  inQueue  A reference to the queue.
+ *
+ *  @return  The number of events that may be appended.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicPipeline<StateType, EventType>::GetRoom(const Queue &inQueue)
+{
+    const size_t theTail = __atomic_load_n(&inQueue.mTail, __ATOMIC_RELAXED);
+    const size_t theHead = __atomic_load_n(&inQueue.mHead, __ATOMIC_ACQUIRE);
+
+    // One entry always stays empty to tell full from empty.
+
+    return (((theHead + inQueue.mSize) - theTail - 1) % inQueue.mSize);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine appends the specified event to the specified queue,
+ *    as its producer.
+ *
+ *  @param[in,out]  ioQueue  A reference to the queue.
+ *  @param[in]      inEvent  A reference to the event to append.
+ *
+ *  @return  \c true if the event was appended; otherwise, \c false, if
+ *           the queue is full.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicPipeline<StateType, EventType>::Enqueue(Queue &ioQueue, const Event &inEvent)
+{
+    size_t theTail = __atomic_load_n(&ioQueue.mTail, __ATOMIC_RELAXED);
+    size_t theNext = theTail + 1;
+
+    if (theNext == ioQueue.mSize)
+        theNext = 0;
+
+    // Only overwrite an entry once the consumer has finished reading
+    // it.
+
+    if (theNext == __atomic_load_n(&ioQueue.mHead, __ATOMIC_ACQUIRE))
+        return (false);
+
+    ioQueue.mEvents[theTail] = inEvent;
+
+    // Publish the event with the tail that makes it visible to the
+    // consumer.
+
+    __atomic_store_n(&ioQueue.mTail, theNext, __ATOMIC_RELEASE);
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine removes the oldest event from the specified queue,
+ *    as its consumer.
+ *
+ *  @param[in,out]  ioQueue   A reference to the queue.
+ *  @param[out]     outEvent  The event removed, if any.
+ *
+ *  @return  \c true if an event was removed; otherwise, \c false, if
+ *           the queue is empty.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicPipeline<StateType, EventType>::Dequeue(Queue &ioQueue, Event &outEvent)
+{
+    size_t theHead = __atomic_load_n(&ioQueue.mHead, __ATOMIC_RELAXED);
+    size_t theNext;
+
+    // Read the event only after the tail that published it.
+
+    if (theHead == __atomic_load_n(&ioQueue.mTail, __ATOMIC_ACQUIRE))
+        return (false);
+
+    outEvent = ioQueue.mEvents[theHead];
+
+    theNext = theHead + 1;
+
+    if (theNext == ioQueue.mSize)
+        theNext = 0;
+
+    // Release the entry to the producer only with the head that
+    // follows reading it.
+
+    __atomic_store_n(&ioQueue.mHead, theNext, __ATOMIC_RELEASE);
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is the output sink of each stage's driver, appending
+ *    the specified output event to the stage's output queue.
+ *
+ *  @param[in]  inOutput   A reference to the output event.
+ *  @param[in]  inContext  A pointer to the output queue.
+ *
+ *  @return  \c true if the output was queued; otherwise, \c false, if
+ *           the queue is full.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicPipeline<StateType, EventType>::Output(const Event &inOutput, void *inContext)
+{
+    return (Enqueue(*static_cast<Queue *>(inContext), inOutput));
+}
+
+// Explicit Instantiations
+
+template class BasicPipeline<uint8_t, uint8_t>;
+template class BasicPipeline<uint16_t, uint16_t>;
+template class BasicPipeline<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
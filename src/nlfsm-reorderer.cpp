@@ -0,0 +1,422 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for reordering a finite state
+ *      machine (FSM) transition table, hottest transitions first,
+ *      from a profile of per-transition hit counts.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-reorderer.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+namespace nl {
+
+namespace Fsm {
+
+// Type Definitions
+
+/**
+ *
+ *  @class HitOrder
+ *
+ *  @brief
+ *   Heap sort predicate object that orders transition table offsets
+ *   by descending hit count and offset.
+ *
+ */
+class HitOrder
+{
+ public:
+    HitOrder(const uint32_t inCounts[]) :
+        mCounts(inCounts)
+    {
+        return;
+    }
+
+    bool operator ()(uint32_t inFirst, uint32_t inSecond) const
+    {
+        if (mCounts[inFirst] != mCounts[inSecond])
+            return (mCounts[inFirst] > mCounts[inSecond]);
+
+        return (inFirst < inSecond);
+    }
+
+ private:
+    const uint32_t *    mCounts;
+};
+
+/**
+ *
+ *  @brief
+ *    This routine is the class default (i.e. void) constructor. It
+ *    instantiates the reorderer without workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicReorderer<StateType, EventType>::BasicReorderer(void) :
+    mWorkspace(NULL),
+    mSize(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the
+ *    reorderer with the specified workspace.
+ *
+ *  @param[in]  inWorkspace  The workspace to reorder within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicReorderer<StateType, EventType>::BasicReorderer(Word inWorkspace[], size_t inSize) :
+    mWorkspace(inWorkspace),
+    mSize(inSize)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the workspace to reorder within.
+ *
+ *  @param[in]  inWorkspace  The workspace to reorder within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicReorderer<StateType, EventType>::SetWorkspace(Word inWorkspace[], size_t inSize)
+{
+    mWorkspace = inWorkspace;
+    mSize      = inSize;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of workspace required to
+ *    reorder a transition table of the specified size.
+ *
+ *  @param[in]  inCount  The number of transitions in the table.
+ *
+ *  @return  The number of words required, or zero if the table is too
+ *           large to reorder.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicReorderer<StateType, EventType>::GetWorkspaceSize(size_t inCount)
+{
+    if ((inCount >= UINT32_MAX) || (inCount >= (SIZE_MAX / 8)))
+        return (0);
+
+    // The order of the transitions and the count each sorts by.
+
+    return (2 * inCount);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine reorders the specified transition table by
+ *    descending hit count into separate storage.
+ *
+ *  @param[in]   inTransitions   The transition table to reorder.
+ *  @param[in]   inCount         The number of transitions in the
+ *                               table.
+ *  @param[in]   inCounts        The hit count of each transition,
+ *                               indexed by its offset in the table.
+ *  @param[out]  outTransitions  Storage for the reordered table, of
+ *                               the same size, which must not overlap
+ *                               the table to reorder.
+ *  @param[out]  outCounts       Optional storage for the hit counts
+ *                               in the reordered order, which must not
+ *                               overlap the counts to reorder by.
+ *
+ *  @return  \c true if the table was reordered; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicReorderer<StateType, EventType>::Reorder(const Transition inTransitions[],
+                                              size_t inCount,
+                                              const Count inCounts[],
+                                              Transition outTransitions[],
+                                              Count outCounts[]) const
+{
+    size_t i;
+    bool   retval = true;
+
+    nlREQUIRE_ACTION(outTransitions != NULL, done, retval = false);
+
+    retval = Order(inTransitions, inCount, inCounts);
+    nlREQUIRE(retval, done);
+
+    for (i = 0; i < inCount; i++) {
+        outTransitions[i] = inTransitions[mWorkspace[i]];
+
+        if (outCounts != NULL)
+            outCounts[i] = inCounts[mWorkspace[i]];
+    }
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine reorders the transition table of the specified,
+ *    profiling machine by descending hit count and installs the
+ *    reordered table in the machine.
+ *
+ *  The machine keeps its current state and its profile, with the
+ *  counts reordered in place along with the transitions, but reverts
+ *  to linear lookups; any index, accepted-event bitmap, event classes
+ *  or transition cache must be rebuilt.
+ *
+ *  Installing the table discards everything set for the previous
+ *  table. So that nothing indexed by transition offset or attached
+ *  to a state is silently lost, a machine with actions, guards,
+ *  outputs, internal transition flags, state handlers, a deferred-
+ *  event bitmap or a deferral queue is not reordered; set them again
+ *  after reordering, for the new order. Installing the table also
+ *  advances the machine's state epoch, cancelling any timers pending
+ *  on the machine.
+ *
+ *  @param[in,out]  ioMachine       A reference to the profiling machine
+ *                                  to reorder.
+ *  @param[out]     outTransitions  Storage for the reordered table,
+ *                                  which must not overlap the machine's
+ *                                  current table and must remain valid
+ *                                  while installed.
+ *  @param[in]      inSize          The number of transitions available
+ *                                  in the reordered table storage, at
+ *                                  least those of the machine.
+ *
+ *  @return  \c true if the table was reordered and installed;
+ *           otherwise, \c false, in which case the machine is
+ *           unchanged, including if it has any of the above set.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicReorderer<StateType, EventType>::Reorder(Machine &ioMachine,
+                                              Transition outTransitions[],
+                                              size_t inSize) const
+{
+    const State        theState = ioMachine.GetCurrentState();
+    Count * const      theCounts = ioMachine.GetProfile();
+    const Transition * theTransitions;
+    size_t             theCount;
+    size_t             i;
+    bool               retval = true;
+
+    theTransitions = ioMachine.GetTransitions(theCount);
+
+    nlREQUIRE_ACTION(theCounts != NULL, done, retval = false);
+    nlREQUIRE_ACTION(outTransitions != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= theCount, done, retval = false);
+
+    nlREQUIRE_ACTION(!ioMachine.HasActions(), done, retval = false);
+    nlREQUIRE_ACTION(!ioMachine.HasGuards(), done, retval = false);
+    nlREQUIRE_ACTION(!ioMachine.HasOutputs(), done, retval = false);
+    nlREQUIRE_ACTION(!ioMachine.HasInternalTransitions(), done, retval = false);
+    nlREQUIRE_ACTION(!ioMachine.HasStateHandlers(), done, retval = false);
+    nlREQUIRE_ACTION(!ioMachine.HasDeferral(), done, retval = false);
+
+    retval = Order(theTransitions, theCount, theCounts);
+    nlREQUIRE(retval, done);
+
+    // The counts sorted by are no longer needed, so they make room to
+    // reorder the raw counts in place.
+
+    for (i = 0; i < theCount; i++) {
+        outTransitions[i]         = theTransitions[mWorkspace[i]];
+        mWorkspace[theCount + i]  = theCounts[mWorkspace[i]];
+    }
+
+    for (i = 0; i < theCount; i++)
+        theCounts[i] = mWorkspace[theCount + i];
+
+    ioMachine.SetTransitions(outTransitions, theCount, theState);
+
+    retval = ioMachine.SetProfile(theCounts, theCount);
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine formats the specified transition table as C
+ *    aggregate initializers, one transition per line with its hit
+ *    count, if any, in a trailing comment, for pasting into the
+ *    definition of a transition array.
+ *
+ *  Like snprintf, the formatted text is truncated to fit the buffer
+ *  and is always null-terminated if the buffer is not empty, and the
+ *  length of the untruncated text is returned, such that a first call
+ *  with an empty buffer sizes the buffer for a second.
+ *
+ *  @param[in]   inTransitions  The transition table to format.
+ *  @param[in]   inCount        The number of transitions in the table.
+ *  @param[in]   inCounts       An optional array of the hit count of
+ *                              each transition.
+ *  @param[out]  outBuffer      Storage for the formatted text.
+ *  @param[in]   inSize         The number of characters available in
+ *                              the storage, including the terminating
+ *                              null character.
+ *
+ *  @return  The length of the formatted text, excluding the
+ *           terminating null character.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicReorderer<StateType, EventType>::Format(const Transition inTransitions[],
+                                             size_t inCount,
+                                             const Count inCounts[],
+                                             char outBuffer[],
+                                             size_t inSize)
+{
+    size_t theLength = 0;
+    size_t i;
+
+    if ((outBuffer != NULL) && (inSize > 0))
+        outBuffer[0] = '\0';
+
+    for (i = 0; i < inCount; i++) {
+        const Transition &theTransition = inTransitions[i];
+        const bool        theFits = ((outBuffer != NULL) && (theLength < inSize));
+        int               theStatus;
+
+        if (inCounts != NULL) {
+            theStatus = snprintf(theFits ? (outBuffer + theLength) : NULL,
+                                 theFits ? (inSize - theLength) : 0,
+                                 "    { %lu, %lu, %lu }, /* %lu */\n",
+                                 static_cast<unsigned long>(theTransition.mStart),
+                                 static_cast<unsigned long>(theTransition.mEvent),
+                                 static_cast<unsigned long>(theTransition.mEnd),
+                                 static_cast<unsigned long>(inCounts[i]));
+        } else {
+            theStatus = snprintf(theFits ? (outBuffer + theLength) : NULL,
+                                 theFits ? (inSize - theLength) : 0,
+                                 "    { %lu, %lu, %lu },\n",
+                                 static_cast<unsigned long>(theTransition.mStart),
+                                 static_cast<unsigned long>(theTransition.mEvent),
+                                 static_cast<unsigned long>(theTransition.mEnd));
+        }
+
+        if (theStatus < 0)
+            break;
+
+        theLength += static_cast<size_t>(theStatus);
+    }
+
+    return (theLength);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine orders the specified transition table by descending
+ *    hit count, leaving the offset of each transition in its new
+ *    position at the start of the workspace.
+ *
+ *  @param[in]  inTransitions  The transition table to order.
+ *  @param[in]  inCount        The number of transitions in the table.
+ *  @param[in]  inCounts       The hit count of each transition.
+ *
+ *  @return  \c true if the table was ordered; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicReorderer<StateType, EventType>::Order(const Transition inTransitions[],
+                                            size_t inCount,
+                                            const Count inCounts[]) const
+{
+    uint32_t * theArcs;
+    uint32_t * theKeys;
+    size_t     theLeader = 0;
+    size_t     i;
+    bool       retval = true;
+
+    nlREQUIRE_ACTION((inTransitions != NULL) || (inCount == 0), done, retval = false);
+    nlREQUIRE_ACTION((inCounts != NULL) || (inCount == 0), done, retval = false);
+    nlREQUIRE_ACTION(mWorkspace != NULL, done, retval = false);
+    nlREQUIRE_ACTION((GetWorkspaceSize(inCount) > 0) || (inCount == 0), done, retval = false);
+    nlREQUIRE_ACTION(mSize >= GetWorkspaceSize(inCount), done, retval = false);
+
+    theArcs = mWorkspace;
+    theKeys = mWorkspace + inCount;
+
+    // Key every transition by the count of the first transition for
+    // its state and event, such that duplicates sort alongside, and
+    // by offset after, the transition shadowing them.
+
+    for (i = 0; i < inCount; i++)
+        theArcs[i] = static_cast<uint32_t>(i);
+
+    HeapSort(theArcs, inCount, ArcOrder<Transition>(inTransitions));
+
+    for (i = 0; i < inCount; i++) {
+        const Transition &theFirst      = inTransitions[theArcs[theLeader]];
+        const Transition &theTransition = inTransitions[theArcs[i]];
+
+        if ((theFirst.mStart != theTransition.mStart) || (theFirst.mEvent != theTransition.mEvent))
+            theLeader = i;
+
+        theKeys[theArcs[i]] = inCounts[theArcs[theLeader]];
+    }
+
+    for (i = 0; i < inCount; i++)
+        theArcs[i] = static_cast<uint32_t>(i);
+
+    HeapSort(theArcs, inCount, HitOrder(theKeys));
+
+ done:
+    return (retval);
+}
+
+// Explicit Instantiations
+
+template class BasicReorderer<uint8_t, uint8_t>;
+template class BasicReorderer<uint16_t, uint16_t>;
+template class BasicReorderer<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
@@ -0,0 +1,664 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for running a finite state
+ *      machine (FSM) over a buffer of events, such as a memory-mapped
+ *      file, without a driver.
+ *
+ */
+
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // defined(__linux__)
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-runner.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+namespace nl {
+
+namespace Fsm {
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the runner
+ *    for the specified state machine, uncompiled, without accepting
+ *    states and at the machine's current state.
+ *
+ *  @param[in]  inMachine  A reference to the state machine to run.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicRunner<StateType, EventType>::BasicRunner(const Machine &inMachine) :
+    mMachine(&inMachine),
+    mTable(NULL),
+    mStates(0),
+    mEvents(0),
+    mAccepting(NULL),
+    mState(inMachine.GetCurrentState()),
+    mPosition(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of entries of storage required for
+ *    the compiled next-state table of the machine.
+ *
+ *  @return  The number of entries required, or zero if the state and
+ *           event identifiers are too large to be mapped.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicRunner<StateType, EventType>::GetTableSize(void) const
+{
+    size_t theStates;
+    size_t theEvents;
+
+    if (!GetDimensions(theStates, theEvents))
+        return (0);
+
+    return (theStates * theEvents);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine compiles the machine's transition table into a
+ *    dense next-state table in the specified storage, which the runner
+ *    uses from then on.
+ *
+ *  The storage must remain valid until the runner is next compiled.
+ *  The table reflects the machine's transitions at the time; any
+ *  accepting states are kept. The transitions are read directly from
+ *  the machine's table, rather than looked up, so compiling neither
+ *  fills the machine's cache nor counts towards its profile.
+ *
+ *  @param[in,out]  ioTable  Storage for the table.
+ *  @param[in]      inSize   The number of entries available in the
+ *                           storage.
+ *
+ *  @return  \c true if the table was compiled; otherwise, \c false, if
+ *           the storage is too small, the machine has guards or its
+ *           state and event identifiers are too large to be mapped.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicRunner<StateType, EventType>::Compile(State ioTable[], size_t inSize)
+{
+    const Transition * theTransitions;
+    size_t             theCount;
+    size_t             theStates;
+    size_t             theEvents;
+    size_t             theState;
+    size_t             theEvent;
+    bool               retval = true;
+
+    nlREQUIRE_ACTION(ioTable != NULL, done, retval = false);
+    nlREQUIRE_ACTION(!mMachine->HasGuards(), done, retval = false);
+    nlREQUIRE_ACTION(GetDimensions(theStates, theEvents), done, retval = false);
+    nlREQUIRE_ACTION(inSize >= (theStates * theEvents), done, retval = false);
+
+    // Without a transition, an event leaves the state unchanged.
+
+    for (theState = 0; theState < theStates; theState++) {
+        for (theEvent = 0; theEvent < theEvents; theEvent++)
+            ioTable[(theState * theEvents) + theEvent] = static_cast<State>(theState);
+    }
+
+    // Write the transitions last to first, so that the first match in
+    // the table, as any lookup would find, is the one left standing.
+
+    theTransitions = mMachine->GetTransitions(theCount);
+
+    while (theCount-- > 0) {
+        theState = static_cast<size_t>(theTransitions[theCount].mStart);
+        theEvent = static_cast<size_t>(theTransitions[theCount].mEvent);
+
+        ioTable[(theState * theEvents) + theEvent] = theTransitions[theCount].mEnd;
+    }
+
+    mTable  = ioTable;
+    mStates = theStates;
+    mEvents = theEvents;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of states (i.e., rows) in the
+ *    compiled table, which any state the runner reaches is less than.
+ *
+ *  @return  The number of states, or zero if not compiled.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicRunner<StateType, EventType>::GetStateCount(void) const
+{
+    return (mStates);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of storage required for
+ *    the accepting state bitmap of the compiled table.
+ *
+ *  @return  The number of words required, or zero if not compiled.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicRunner<StateType, EventType>::GetAcceptingSize(void) const
+{
+    return ((mStates + kMaskBits - 1) / kMaskBits);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the accepting states, whose entry #Scan
+ *    reports, as a bitmap with a bit for each state of the compiled
+ *    table.
+ *
+ *  The bitmap must remain valid until the accepting states are next
+ *  set or cleared.
+ *
+ *  @param[in]  inStates  The accepting state bitmap.
+ *  @param[in]  inSize    The number of words in the bitmap.
+ *
+ *  @return  \c true if the accepting states were set; otherwise,
+ *           \c false, if not compiled or the bitmap is too small.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicRunner<StateType, EventType>::SetAccepting(const Mask inStates[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(inStates != NULL, done, retval = false);
+    nlREQUIRE_ACTION(mTable != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= GetAcceptingSize(), done, retval = false);
+
+    mAccepting = inStates;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine clears the accepting states.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicRunner<StateType, EventType>::ClearAccepting(void)
+{
+    mAccepting = NULL;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the runner's current state.
+ *
+ *  @return  A reference to the current state.
+ *
+ */
+template <typename StateType, typename EventType>
+const StateType &
+BasicRunner<StateType, EventType>::GetState(void) const
+{
+    return (mState);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the runner's current state, leaving the
+ *    position unchanged.
+ *
+ *  @param[in]  inState  A reference to the state to set.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicRunner<StateType, EventType>::SetState(const State &inState)
+{
+    mState = inState;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of events run since the last reset,
+ *    the position of the next event in the stream.
+ *
+ *  @return  The position.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicRunner<StateType, EventType>::GetPosition(void) const
+{
+    return (mPosition);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine resets the runner to the machine's current state, at
+ *    the start of a new stream.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicRunner<StateType, EventType>::Reset(void)
+{
+    mState    = mMachine->GetCurrentState();
+    mPosition = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine runs the specified events from the current state.
+ *
+ *  @param[in]  inEvents  The events to run.
+ *  @param[in]  inCount   The number of events.
+ *
+ *  @return  A reference to the resulting current state.
+ *
+ */
+template <typename StateType, typename EventType>
+const StateType &
+BasicRunner<StateType, EventType>::Run(const Event inEvents[], size_t inCount)
+{
+    const State * const theTable  = mTable;
+    const size_t        theEvents = mEvents;
+    State               theState  = mState;
+    size_t              i;
+
+    nlPRECONDITION_VALUE(mTable != NULL, mState);
+    nlPRECONDITION_VALUE(mState < mStates, mState);
+
+    for (i = 0; i < inCount; i++) {
+        if (inEvents[i] < theEvents)
+            theState = theTable[(static_cast<size_t>(theState) * theEvents) + inEvents[i]];
+    }
+
+    mState     = theState;
+    mPosition += inCount;
+
+    return (mState);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine runs the specified events from the current state,
+ *    recording the position of each event that enters the set of
+ *    accepting states from outside it, until the events or the room
+ *    for positions run out.
+ *
+ *  Positions count from the last reset, so they are positions in the
+ *  stream when it is run in chunks. Scanning stops before an event
+ *  whose position there is no room for, so it may be resumed from
+ *  there.
+ *
+ *  @param[in]   inEvents      The events to run.
+ *  @param[in]   inCount       The number of events.
+ *  @param[out]  outPositions  Storage for the positions.
+ *  @param[in]   inMax         The number of positions available in
+ *                             the storage.
+ *  @param[out]  outScanned    The number of events run.
+ *
+ *  @return  The number of positions recorded.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicRunner<StateType, EventType>::Scan(const Event inEvents[], size_t inCount, size_t outPositions[], size_t inMax, size_t &outScanned)
+{
+    const State * const theTable  = mTable;
+    const size_t        theEvents = mEvents;
+    State               theState  = mState;
+    State               theNext;
+    bool                theWas;
+    bool                theIs;
+    size_t              i;
+    size_t              retval = 0;
+
+    outScanned = 0;
+
+    nlPRECONDITION_VALUE(mTable != NULL, 0);
+    nlPRECONDITION_VALUE(mState < mStates, 0);
+
+    theWas = IsAccepting(theState);
+
+    for (i = 0; i < inCount; i++) {
+        theNext = theState;
+
+        if (inEvents[i] < theEvents)
+            theNext = theTable[(static_cast<size_t>(theState) * theEvents) + inEvents[i]];
+
+        theIs = IsAccepting(theNext);
+
+        if (theIs && !theWas) {
+            if (retval == inMax)
+                break;
+
+            outPositions[retval++] = mPosition + i;
+        }
+
+        theState = theNext;
+        theWas   = theIs;
+    }
+
+    mState      = theState;
+    mPosition  += i;
+    outScanned  = i;
+
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine runs the specified events from the current state,
+ *    counting, for each state, the events after which it was the
+ *    current state.
+ *
+ *  @param[in]      inEvents  The events to run.
+ *  @param[in]      inCount   The number of events.
+ *  @param[in,out]  ioCounts  The count for each state of the compiled
+ *                            table, added to.
+ *  @param[in]      inSize    The number of counts.
+ *
+ *  @return  \c true if the events were run; otherwise, \c false, if
+ *           not compiled or there are too few counts.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicRunner<StateType, EventType>::Tally(const Event inEvents[], size_t inCount, Count ioCounts[], size_t inSize)
+{
+    const State * const theTable  = mTable;
+    const size_t        theEvents = mEvents;
+    State               theState  = mState;
+    size_t              i;
+    bool                retval    = true;
+
+    nlREQUIRE_ACTION(mTable != NULL, done, retval = false);
+    nlREQUIRE_ACTION(mState < mStates, done, retval = false);
+    nlREQUIRE_ACTION(ioCounts != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize >= mStates, done, retval = false);
+
+    for (i = 0; i < inCount; i++) {
+        if (inEvents[i] < theEvents)
+            theState = theTable[(static_cast<size_t>(theState) * theEvents) + inEvents[i]];
+
+        ioCounts[theState]++;
+    }
+
+    mState     = theState;
+    mPosition += inCount;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines the dimensions of the compiled table,
+ *    with a row for every state, starting or ending a transition, and
+ *    a column for every event.
+ *
+ *  @param[out]  outStates  The number of states (i.e., rows).
+ *  @param[out]  outEvents  The number of events (i.e., columns).
+ *
+ *  @return  \c true if the table may be compiled; otherwise,
+ *           \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicRunner<StateType, EventType>::GetDimensions(size_t &outStates, size_t &outEvents) const
+{
+    const Transition * theTransitions;
+    size_t             theCount;
+    State              theMaxState;
+    Event              theMaxEvent = 0;
+    size_t             i;
+
+    outStates = 0;
+    outEvents = 0;
+
+    theTransitions = mMachine->GetTransitions(theCount);
+    theMaxState    = mMachine->GetCurrentState();
+
+    if ((theTransitions == NULL) || (theCount == 0))
+        return (false);
+
+    for (i = 0; i < theCount; i++) {
+        if (theTransitions[i].mStart > theMaxState)
+            theMaxState = theTransitions[i].mStart;
+
+        if (theTransitions[i].mEnd > theMaxState)
+            theMaxState = theTransitions[i].mEnd;
+
+        if (theTransitions[i].mEvent > theMaxEvent)
+            theMaxEvent = theTransitions[i].mEvent;
+    }
+
+    if ((static_cast<uint64_t>(theMaxState) >= SIZE_MAX) ||
+        (static_cast<uint64_t>(theMaxEvent) >= SIZE_MAX))
+        return (false);
+
+    outStates = static_cast<size_t>(theMaxState) + 1;
+    outEvents = static_cast<size_t>(theMaxEvent) + 1;
+
+    if (outStates > (SIZE_MAX / sizeof (State) / outEvents)) {
+        outStates = 0;
+        outEvents = 0;
+        return (false);
+    }
+
+    return (true);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the specified state is
+ *    accepting.
+ *
+ *  @param[in]  inState  A reference to the state, in the compiled
+ *                       table.
+ *
+ *  @return  \c true if the state is accepting; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicRunner<StateType, EventType>::IsAccepting(const State &inState) const
+{
+    if (mAccepting == NULL)
+        return (false);
+
+    return ((mAccepting[inState / kMaskBits] & (static_cast<Mask>(1) << (inState % kMaskBits))) != 0);
+}
+
+// Explicit Instantiations
+
+template class BasicRunner<uint8_t, uint8_t>;
+template class BasicRunner<uint16_t, uint16_t>;
+template class BasicRunner<uint32_t, uint32_t>;
+
+#if defined(__linux__)
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the object
+ *    without a file mapped.
+ *
+ */
+MappedFile::MappedFile(void) :
+    mData(NULL),
+    mSize(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is a class destructor. It unmaps the file, if any.
+ *
+ */
+MappedFile::~MappedFile(void)
+{
+    Close();
+}
+
+/**
+ *
+ *  @brief
+ *    This routine maps the specified file read-only into memory,
+ *    unmapping any file already mapped.
+ *
+ *  An empty file maps to no data.
+ *
+ *  @param[in]  inPath  The path of the file to map.
+ *
+ *  @return  \c true if the file was mapped; otherwise, \c false, with
+ *           errno set.
+ *
+ */
+bool
+MappedFile::Open(const char *inPath)
+{
+    struct stat theStat;
+    void *      theData;
+    int         theDescriptor;
+    bool        retval = true;
+
+    Close();
+
+    theDescriptor = open(inPath, O_RDONLY | O_CLOEXEC);
+    nlREQUIRE_ACTION(theDescriptor >= 0, done, retval = false);
+
+    nlREQUIRE_ACTION(fstat(theDescriptor, &theStat) == 0, done, retval = false);
+
+    if (theStat.st_size > 0) {
+        theData = mmap(NULL, static_cast<size_t>(theStat.st_size), PROT_READ, MAP_PRIVATE, theDescriptor, 0);
+        nlREQUIRE_ACTION(theData != MAP_FAILED, done, retval = false);
+
+        // Read ahead aggressively and drop pages once passed, as the
+        // runner touches each byte once, in order.
+
+        madvise(theData, static_cast<size_t>(theStat.st_size), MADV_SEQUENTIAL);
+
+        mData = theData;
+        mSize = static_cast<size_t>(theStat.st_size);
+    }
+
+ done:
+    // The mapping, if any, outlives the descriptor.
+
+    if (theDescriptor >= 0)
+        close(theDescriptor);
+
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine unmaps the file, if any.
+ *
+ */
+void
+MappedFile::Close(void)
+{
+    if (mData != NULL) {
+        munmap(mData, mSize);
+
+        mData = NULL;
+        mSize = 0;
+    }
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the mapped data.
+ *
+ *  @return  A pointer to the data, or NULL if no file, or an empty
+ *           one, is mapped.
+ *
+ */
+const void *
+MappedFile::GetData(void) const
+{
+    return (mData);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the size of the mapped data.
+ *
+ *  @return  The size, in bytes.
+ *
+ */
+size_t
+MappedFile::GetSize(void) const
+{
+    return (mSize);
+}
+
+#endif // defined(__linux__)
+
+}; // namespace Fsm
+
+}; // namespace nl
@@ -80,6 +80,8 @@
  *
  */
 
+#include <stdint.h>
+
 #include <nestlabs/fsm/nlfsm-state-delegate-always.hpp>
 
 namespace nl {
@@ -95,12 +97,19 @@ namespace Delegate {
  *    parent constructor with a value of \c true.
  *
  */
-Always::Always(void) :
-	Boolean(true)
+template <typename StateType, typename EventType>
+BasicAlways<StateType, EventType>::BasicAlways(void) :
+	BasicBoolean<StateType, EventType>(true)
 {
 	return;
 }
 
+// Explicit Instantiations
+
+template class BasicAlways<uint8_t, uint8_t>;
+template class BasicAlways<uint16_t, uint16_t>;
+template class BasicAlways<uint32_t, uint32_t>;
+
 }; // namespace Delegate
 
 }; // namespace Fsm
@@ -0,0 +1,235 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a base class following the delegate
+ *      pattern for observing and handling various finite state machine
+ *      (FSM) management events, any of which may complete
+ *      asynchronously.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nestlabs/fsm/nlfsm-state-delegate-async.hpp>
+
+namespace nl {
+
+namespace Fsm {
+
+namespace Delegate {
+
+/**
+ *
+ *  @brief
+ *    This routine is the class void constructor. At present, it does
+ *    nothing.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicAsync<StateType, EventType>::BasicAsync(void)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    before a newly-posted event is handled and allows the delegate
+ *    receiver to decide, now or later, whether the event processing
+ *    should continue.
+ *
+ *  @param[in]  inEvent  A reference to the event being handled.
+ *  @param[in]  inState  A reference to the current state.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::WillHandleEvent(const Event &inEvent, const State &inState)
+{
+    return (kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    after a newly-posted event is handled and allows the delegate
+ *    receiver to decide, now or later, whether the event processing
+ *    should continue.
+ *
+ *  @param[in]  inEvent  A reference to the event being handled.
+ *  @param[in]  inState  A reference to the current state.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::DidHandleEvent(const Event &inEvent, const State &inState)
+{
+    return (kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    before the current state is exited in response to a newly-posted
+ *    event and allows the delegate receiver to decide, now or later,
+ *    whether the event processing should continue.
+ *
+ *  @param[in]  inEvent       A reference to the event being handled.
+ *  @param[in]  inTransition  A reference to the transition being
+ *                            taken in response to the event.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::WillExitState(const Event &inEvent, const Transition &inTransition)
+{
+    return (kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    after the current state is exited in response to a newly-posted
+ *    event and allows the delegate receiver to decide, now or later,
+ *    whether the event processing should continue.
+ *
+ *  @param[in]  inEvent       A reference to the event being handled.
+ *  @param[in]  inTransition  A reference to the transition being
+ *                            taken in response to the event.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::DidExitState(const Event &inEvent, const Transition &inTransition)
+{
+    return (kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    before the specified transition arc is taken in response to a
+ *    newly-posted event and allows the delegate receiver to decide, now
+ *    or later, whether the event processing should continue.
+ *
+ *  @param[in]  inEvent       A reference to the event being handled.
+ *  @param[in]  inTransition  A reference to the transition being
+ *                            taken in response to the event.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::WillTransition(const Event &inEvent, const Transition &inTransition)
+{
+    return (kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    after the specified transition arc is taken in response to a
+ *    newly-posted event and allows the delegate receiver to decide, now
+ *    or later, whether the event processing should continue.
+ *
+ *  @param[in]  inEvent       A reference to the event being handled.
+ *  @param[in]  inTransition  A reference to the transition being
+ *                            taken in response to the event.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::DidTransition(const Event &inEvent, const Transition &inTransition)
+{
+    return (kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    before the next state is entered in response to a newly-posted
+ *    event and allows the delegate receiver to decide, now or later,
+ *    whether the event processing should continue.
+ *
+ *  @param[in]  inEvent       A reference to the event being handled.
+ *  @param[in]  inTransition  A reference to the transition being
+ *                            taken in response to the event.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::WillEnterState(const Event &inEvent, const Transition &inTransition)
+{
+    return (kResultContinue);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is called by an associated finite state machine (FSM)
+ *    after the next state is entered in response to a newly-posted
+ *    event and allows the delegate receiver to decide, now or later,
+ *    whether the event processing should continue.
+ *
+ *  @param[in]  inEvent       A reference to the event being handled.
+ *  @param[in]  inTransition  A reference to the transition being
+ *                            taken in response to the event.
+ *
+ *  @return  #kResultContinue.
+ *
+ */
+template <typename StateType, typename EventType>
+Result
+BasicAsync<StateType, EventType>::DidEnterState(const Event &inEvent, const Transition &inTransition)
+{
+    return (kResultContinue);
+}
+
+// Explicit Instantiations
+
+template class BasicAsync<uint8_t, uint8_t>;
+template class BasicAsync<uint16_t, uint16_t>;
+template class BasicAsync<uint32_t, uint32_t>;
+
+}; // namespace Delegate
+
+}; // namespace Fsm
+
+}; // namespace nl
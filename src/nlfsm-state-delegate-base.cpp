@@ -74,6 +74,8 @@
  *      finite state machine (FSM) management events.
  */
 
+#include <stdint.h>
+
 #include <nestlabs/fsm/nlfsm-state-delegate-base.hpp>
 
 namespace nl {
@@ -89,11 +91,18 @@ namespace Delegate {
  *    nothing.
  *
  */
-Base::Base(void)
+template <typename StateType, typename EventType>
+BasicBase<StateType, EventType>::BasicBase(void)
 {
 	return;
 }
 
+// Explicit Instantiations
+
+template class BasicBase<uint8_t, uint8_t>;
+template class BasicBase<uint16_t, uint16_t>;
+template class BasicBase<uint32_t, uint32_t>;
+
 }; // namespace Delegate
 
 }; // namespace Fsm
@@ -74,6 +74,8 @@
  *
  */
 
+#include <stdint.h>
+
 #include <nestlabs/fsm/nlfsm-state-delegate-boolean.hpp>
 
 namespace nl {
@@ -93,7 +95,8 @@ namespace Delegate {
  *                         delegate methods.
  *
  */
-Boolean::Boolean(bool inBoolean) :
+template <typename StateType, typename EventType>
+BasicBoolean<StateType, EventType>::BasicBoolean(bool inBoolean) :
     mBoolean(inBoolean)
 {
     return;
@@ -113,8 +116,9 @@ Boolean::Boolean(bool inBoolean) :
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::WillHandleEvent(const Event &inEvent,
+BasicBoolean<StateType, EventType>::WillHandleEvent(const Event &inEvent,
                          const State &inState)
 {
     return (mBoolean);
@@ -134,8 +138,9 @@ Boolean::WillHandleEvent(const Event &inEvent,
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::DidHandleEvent(const Event &inEvent,
+BasicBoolean<StateType, EventType>::DidHandleEvent(const Event &inEvent,
                         const State &inState)
 {
     return (mBoolean);
@@ -156,8 +161,9 @@ Boolean::DidHandleEvent(const Event &inEvent,
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::WillExitState(const Event &inEvent,
+BasicBoolean<StateType, EventType>::WillExitState(const Event &inEvent,
                        const Transition &inTransition)
 {
     return (mBoolean);
@@ -178,8 +184,9 @@ Boolean::WillExitState(const Event &inEvent,
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::DidExitState(const Event &inEvent,
+BasicBoolean<StateType, EventType>::DidExitState(const Event &inEvent,
                       const Transition &inTransition)
 {
     return (mBoolean);
@@ -200,8 +207,9 @@ Boolean::DidExitState(const Event &inEvent,
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::WillTransition(const Event &inEvent,
+BasicBoolean<StateType, EventType>::WillTransition(const Event &inEvent,
                         const Transition &inTransition)
 {
     return (mBoolean);
@@ -222,8 +230,9 @@ Boolean::WillTransition(const Event &inEvent,
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::DidTransition(const Event &inEvent,
+BasicBoolean<StateType, EventType>::DidTransition(const Event &inEvent,
                        const Transition &inTransition)
 {
     return (mBoolean);
@@ -244,8 +253,9 @@ Boolean::DidTransition(const Event &inEvent,
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::WillEnterState(const Event &inEvent,
+BasicBoolean<StateType, EventType>::WillEnterState(const Event &inEvent,
                         const Transition &inTransition)
 {
     return (mBoolean);
@@ -266,13 +276,20 @@ Boolean::WillEnterState(const Event &inEvent,
  *  @return  The Boolean the class was instantiated with.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Boolean::DidEnterState(const Event &inEvent,
+BasicBoolean<StateType, EventType>::DidEnterState(const Event &inEvent,
                        const Transition &inTransition)
 {
     return (mBoolean);
 }
 
+// Explicit Instantiations
+
+template class BasicBoolean<uint8_t, uint8_t>;
+template class BasicBoolean<uint16_t, uint16_t>;
+template class BasicBoolean<uint32_t, uint32_t>;
+
 }; // namespace Delegate
 
 }; // namespace Fsm
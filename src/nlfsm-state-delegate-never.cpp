@@ -77,6 +77,8 @@
  *
  */
 
+#include <stdint.h>
+
 #include <nestlabs/fsm/nlfsm-state-delegate-never.hpp>
 
 namespace nl {
@@ -92,12 +94,19 @@ namespace Delegate {
  *    parent constructor with a value of \c false.
  *
  */
-Never::Never(void) :
-	Boolean(false)
+template <typename StateType, typename EventType>
+BasicNever<StateType, EventType>::BasicNever(void) :
+	BasicBoolean<StateType, EventType>(false)
 {
 	return;
 }
 
+// Explicit Instantiations
+
+template class BasicNever<uint8_t, uint8_t>;
+template class BasicNever<uint16_t, uint16_t>;
+template class BasicNever<uint32_t, uint32_t>;
+
 }; // namespace Delegate
 
 }; // namespace Fsm
@@ -78,85 +78,188 @@
  *
  */
 
-#include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
-#include <stdlib.h>
+
 #include <nestlabs/fsm/nlfsm-state-delegate-random.hpp>
 
+#include "nlfsm-utilities.hpp"
+
 namespace nl {
 
 namespace Fsm {
 
 namespace Delegate {
 
+// Preprocessor Definitions
+
+/**
+ *  The seed used by instances constructed without an explicit seed.
+ */
+#define NLFSM_DELEGATE_RANDOM_DEFAULT_SEED  0x330EU
+
+/**
+ *  The default probability with which each delegate method vetoes.
+ */
+#define NLFSM_DELEGATE_RANDOM_DEFAULT_VETO  0.5
+
 /**
  *
  *  @brief
- *    This function returns a pseudo-random instance of type \c T in the
- *    inclusive range between \c min and \c max.
+ *    This function rotates the specified value left by the specified
+ *    number of bits.
  *
- *  @tparam  The type of pseudo-random instance to return.
+ *  @param[in]  inValue  The value to rotate.
+ *  @param[in]  inBits   The number of bits, in the range [1, 31], to
+ *                       rotate by.
  *
- *  @param[in]  min  The minimum instance value, inclusive, in the range
- *                   to return.
- *  @param[in]  max  The maximum instance value, inclusive, in the range
- *                   to return.
+ *  @return  The rotated value.
  *
- *  @return  A pseudo-random instance of type \c T in the inclusive range
- *           between \c min and \c max.
+ */
+static inline uint32_t
+RotateLeft(uint32_t inValue, unsigned int inBits)
+{
+    return ((inValue << inBits) | (inValue >> (32 - inBits)));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is the class void constructor. It seeds the
+ *    instance pseudo-random number generator (PRNG) with a fixed,
+ *    default seed and sets a veto probability of one half for all
+ *    delegate methods.
  *
  */
-template <typename T>
-static T
-rand_range(const T &min, const T &max)
+template <typename StateType, typename EventType>
+BasicRandom<StateType, EventType>::BasicRandom(void)
 {
-    int64_t theValue;
+    Seed(NLFSM_DELEGATE_RANDOM_DEFAULT_SEED);
+    SetVetoProbability(NLFSM_DELEGATE_RANDOM_DEFAULT_VETO);
+}
 
-    if (min > max) {
-        return 0;
-    }
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor.
+ *
+ *  This constructor instantiates the delegate object by seeding the
+ *  instance pseudo-random number generator (PRNG) with the specified
+ *  value and sets a veto probability of one half for all delegate
+ *  methods. Other instances are unaffected.
+ *
+ *  @param[in]  inSeed  The seed value for the pseudo-random distribution
+ *                      of Boolean values returned by the delegate methods.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicRandom<StateType, EventType>::BasicRandom(unsigned int inSeed)
+{
+    Seed(inSeed);
+    SetVetoProbability(NLFSM_DELEGATE_RANDOM_DEFAULT_VETO);
+}
 
-    theValue = (max - min + 1);
-    theValue = theValue * lrand48();
+/**
+ *
+ *  @brief
+ *    This routine reseeds the instance pseudo-random number generator
+ *    (PRNG) with the specified value.
+ *
+ *  @param[in]  inSeed  The seed value for the pseudo-random distribution
+ *                      of Boolean values returned by the delegate methods.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicRandom<StateType, EventType>::Seed(unsigned int inSeed)
+{
+    uint64_t theSequence = inSeed;
+    uint64_t theValue;
 
-    // Use INT32_MAX below instead of LONG_MAX since lrand48
-    // always returns a value in the range [0, 2**31-1] regardless
-    // of what a long is defined as
+    // Expand the narrow seed into a well-mixed, non-zero xoshiro128**
+    // state.
 
-    theValue = theValue / (static_cast<int64_t>(INT32_MAX) + 1);
+    theValue   = SplitMix64(theSequence);
+    mState[0]  = static_cast<uint32_t>(theValue);
+    mState[1]  = static_cast<uint32_t>(theValue >> 32);
 
-    theValue = theValue + min;
+    theValue   = SplitMix64(theSequence);
+    mState[2]  = static_cast<uint32_t>(theValue);
+    mState[3]  = static_cast<uint32_t>(theValue >> 32);
+}
 
-    return static_cast<T>(theValue);
+/**
+ *
+ *  @brief
+ *    This routine sets the probability with which all of the delegate
+ *    methods veto (i.e., return false).
+ *
+ *  @param[in]  inProbability  The veto probability, in the inclusive
+ *                             range [0, 1]. Values outside the range are
+ *                             clamped.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicRandom<StateType, EventType>::SetVetoProbability(double inProbability)
+{
+    for (size_t i = 0; i < kHookMax; i++) {
+        SetVetoProbability(static_cast<Hook>(i), inProbability);
+    }
 }
 
 /**
  *
  *  @brief
- *    This routine is the class void constructor. At present, it does
- *    nothing.
+ *    This routine sets the probability with which the specified
+ *    delegate method vetoes (i.e., returns false).
+ *
+ *  @param[in]  inHook         The delegate method to set the veto
+ *                             probability for.
+ *  @param[in]  inProbability  The veto probability, in the inclusive
+ *                             range [0, 1]. Values outside the range are
+ *                             clamped.
  *
  */
-Random::Random(void)
+template <typename StateType, typename EventType>
+void
+BasicRandom<StateType, EventType>::SetVetoProbability(Hook inHook, double inProbability)
 {
-    return;
+    const double kScale = 4294967296.0;
+
+    if (inHook >= kHookMax)
+        return;
+
+    if (!(inProbability > 0.0))
+        mThresholds[inHook] = 0;
+    else if (inProbability >= 1.0)
+        mThresholds[inHook] = static_cast<uint64_t>(kScale);
+    else
+        mThresholds[inHook] = static_cast<uint64_t>(inProbability * kScale);
 }
 
 /**
  *
  *  @brief
- *    This routine is a class constructor.
+ *    This routine gets the probability with which the specified
+ *    delegate method vetoes (i.e., returns false).
  *
- *  This constructor instantiates the delegate object by seeding the
- *  pseudo-random number generator (PRNG) with the specified value.
+ *  @param[in]  inHook  The delegate method to get the veto probability
+ *                      for.
  *
- *  @param[in]  inSeed  The seed value for the pseudo-random distribution
- *                      of Boolean values returned by the delegate methods.
+ *  @return  The veto probability, in the inclusive range [0, 1].
  *
  */
-Random::Random(unsigned int inSeed)
+template <typename StateType, typename EventType>
+double
+BasicRandom<StateType, EventType>::GetVetoProbability(Hook inHook) const
 {
-    srand48(inSeed);
+    const double kScale = 4294967296.0;
+
+    if (inHook >= kHookMax)
+        return (0.0);
+
+    return (static_cast<double>(mThresholds[inHook]) / kScale);
 }
 
 /**
@@ -173,10 +276,11 @@ Random::Random(unsigned int inSeed)
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::WillHandleEvent(const Event &inEvent, const State &inState)
+BasicRandom<StateType, EventType>::WillHandleEvent(const Event &inEvent, const State &inState)
 {
-    return (GetStatus());
+    return (GetStatus(kHookWillHandleEvent));
 }
 
 /**
@@ -193,10 +297,11 @@ Random::WillHandleEvent(const Event &inEvent, const State &inState)
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::DidHandleEvent(const Event &inEvent, const State &inState)
+BasicRandom<StateType, EventType>::DidHandleEvent(const Event &inEvent, const State &inState)
 {
-    return (GetStatus());
+    return (GetStatus(kHookDidHandleEvent));
 }
 
 /**
@@ -214,11 +319,12 @@ Random::DidHandleEvent(const Event &inEvent, const State &inState)
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::WillExitState(const Event &inEvent,
+BasicRandom<StateType, EventType>::WillExitState(const Event &inEvent,
                       const Transition &inTransition)
 {
-    return (GetStatus());
+    return (GetStatus(kHookWillExitState));
 }
 
 /**
@@ -236,11 +342,12 @@ Random::WillExitState(const Event &inEvent,
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::DidExitState(const Event &inEvent,
+BasicRandom<StateType, EventType>::DidExitState(const Event &inEvent,
                      const Transition &inTransition)
 {
-    return (GetStatus());
+    return (GetStatus(kHookDidExitState));
 }
 
 /**
@@ -258,11 +365,12 @@ Random::DidExitState(const Event &inEvent,
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::WillTransition(const Event &inEvent,
+BasicRandom<StateType, EventType>::WillTransition(const Event &inEvent,
                        const Transition &inTransition)
 {
-    return (GetStatus());
+    return (GetStatus(kHookWillTransition));
 }
 
 /**
@@ -280,11 +388,12 @@ Random::WillTransition(const Event &inEvent,
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::DidTransition(const Event &inEvent,
+BasicRandom<StateType, EventType>::DidTransition(const Event &inEvent,
                       const Transition &inTransition)
 {
-    return (GetStatus());
+    return (GetStatus(kHookDidTransition));
 }
 
 /**
@@ -302,11 +411,12 @@ Random::DidTransition(const Event &inEvent,
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::WillEnterState(const Event &inEvent,
+BasicRandom<StateType, EventType>::WillEnterState(const Event &inEvent,
                        const Transition &inTransition)
 {
-    return (GetStatus());
+    return (GetStatus(kHookWillEnterState));
 }
 
 /**
@@ -324,28 +434,68 @@ Random::WillEnterState(const Event &inEvent,
  *  @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::DidEnterState(const Event &inEvent,
+BasicRandom<StateType, EventType>::DidEnterState(const Event &inEvent,
                       const Transition &inTransition)
 {
-    return (GetStatus());
+    return (GetStatus(kHookDidEnterState));
 }
 
 /**
  *
  *  @brief
  *    This routine gets a Boolean value from a pseudo-random
- *    distribution.
+ *    distribution, biased by the veto probability of the specified
+ *    delegate method.
+ *
+ *  @param[in]  inHook  The delegate method the value is for.
  *
  * @return  Either or \c true or \c false in a pseudo-random distribution.
  *
  */
+template <typename StateType, typename EventType>
 bool
-Random::GetStatus(void)
+BasicRandom<StateType, EventType>::GetStatus(Hook inHook)
+{
+    return (static_cast<uint64_t>(GetNext()) >= mThresholds[inHook]);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the next 32-bit value from the instance
+ *    xoshiro128** pseudo-random number generator (PRNG), advancing
+ *    its state.
+ *
+ * @return  The next pseudo-random value.
+ *
+ */
+template <typename StateType, typename EventType>
+uint32_t
+BasicRandom<StateType, EventType>::GetNext(void)
 {
-    return (rand_range<bool>(false, true));
+    const uint32_t theResult = RotateLeft(mState[1] * 5, 7) * 9;
+    const uint32_t theShift  = mState[1] << 9;
+
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+
+    mState[2] ^= theShift;
+
+    mState[3]  = RotateLeft(mState[3], 11);
+
+    return (theResult);
 }
 
+// Explicit Instantiations
+
+template class BasicRandom<uint8_t, uint8_t>;
+template class BasicRandom<uint16_t, uint16_t>;
+template class BasicRandom<uint32_t, uint32_t>;
+
 }; // namespace Delegate
 
 }; // namespace Fsm
@@ -0,0 +1,428 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for delivering timeout events to
+ *      many finite state machines (FSMs) from a single, hierarchical
+ *      timer wheel.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-driver.hpp>
+#include <nestlabs/fsm/nlfsm-machine.hpp>
+#include <nestlabs/fsm/nlfsm-timer-wheel.hpp>
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+
+namespace nl {
+
+namespace Fsm {
+
+// Preprocessor Definitions
+
+/**
+ *  The value indicating the end of a slot or the free list.
+ */
+#define kIndexNone  UINT32_MAX
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the wheel,
+ *    at time zero and without timer storage, firing events through
+ *    the specified driver.
+ *
+ *  The driver is pointed at each machine in turn as timers fire, so
+ *  is left pointing at one of them.
+ *
+ *  @param[in]  inDriver  A reference to the driver to share.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicTimerWheel<StateType, EventType>::BasicTimerWheel(Driver &inDriver) :
+    mDriver(&inDriver),
+    mTimers(NULL),
+    mFree(kIndexNone),
+    mPending(0),
+    mNow(0)
+{
+    size_t i;
+
+    for (i = 0; i < (kLevels * kSlots); i++)
+        mSlots[i] = kIndexNone;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine allocates timers from the specified storage, with
+ *    none armed.
+ *
+ *  Any timers pending in previous storage are discarded. The storage
+ *  must remain valid until it is next set.
+ *
+ *  @param[in,out]  ioTimers  Storage for the timers.
+ *  @param[in]      inCount   The number of timers available in the
+ *                            storage, the most that may be pending at
+ *                            once.
+ *
+ *  @return  \c true if the storage was set; otherwise, \c false, in
+ *           which case any existing storage is unchanged.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicTimerWheel<StateType, EventType>::SetTimers(Timer ioTimers[], size_t inCount)
+{
+    size_t i;
+    bool   retval = true;
+
+    nlREQUIRE_ACTION(ioTimers != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inCount > 0, done, retval = false);
+    nlREQUIRE_ACTION(inCount < kIndexNone, done, retval = false);
+
+    for (i = 0; i < inCount; i++)
+        ioTimers[i].mNext = ((i + 1) < inCount) ? static_cast<Index>(i + 1) : kIndexNone;
+
+    for (i = 0; i < (kLevels * kSlots); i++)
+        mSlots[i] = kIndexNone;
+
+    mTimers  = ioTimers;
+    mFree    = 0;
+    mPending = 0;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the time of the wheel.
+ *
+ *  @return  The number of ticks since the wheel started, wrapping at
+ *           its maximum.
+ *
+ */
+template <typename StateType, typename EventType>
+typename BasicTimerWheel<StateType, EventType>::Tick
+BasicTimerWheel<StateType, EventType>::GetNow(void) const
+{
+    return (mNow);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of timers armed and not yet
+ *    expired, including those cancelled.
+ *
+ *  @return  The number of pending timers.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicTimerWheel<StateType, EventType>::GetPendingCount(void) const
+{
+    return (mPending);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine arms a timer to fire the specified event at the
+ *    specified machine after the specified number of ticks, unless the
+ *    machine leaves its current state first.
+ *
+ *  During a transition, before the ending state is entered, arm the
+ *  timer with the transition instead.
+ *
+ *  @param[in]  inMachine  A reference to the machine to fire at.
+ *  @param[in]  inEvent    A reference to the event to fire.
+ *  @param[in]  inDelay    The number of ticks after which to fire, at
+ *                         least one.
+ *
+ *  @return  \c true if the timer was armed; otherwise, \c false, if
+ *           there is no timer storage or every timer is pending.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicTimerWheel<StateType, EventType>::Arm(Machine &inMachine, const Event &inEvent, Tick inDelay)
+{
+    return (Add(inMachine, inMachine.GetStateEpoch(), inMachine.GetCurrentState(), inEvent, inDelay));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine arms a timer, from within the specified transition
+ *    of the specified machine, to fire the specified event at the
+ *    machine after the specified number of ticks, unless the machine
+ *    leaves the transition's ending state first.
+ *
+ *  The transition must be in progress and its ending state not yet
+ *  entered, i.e., the timer is armed from the transition's action,
+ *  the starting state's exit handler or a delegate method up to and
+ *  including WillEnterState. An internal transition stays in its
+ *  state, so the timer belongs to the current stay. Should the
+ *  transition be vetoed before its ending state is entered, the timer
+ *  never fires.
+ *
+ *  @param[in]  inMachine     A reference to the machine to fire at.
+ *  @param[in]  inTransition  A reference to the transition in
+ *                            progress.
+ *  @param[in]  inEvent       A reference to the event to fire.
+ *  @param[in]  inDelay       The number of ticks after which to fire,
+ *                            at least one.
+ *
+ *  @return  \c true if the timer was armed; otherwise, \c false, if
+ *           there is no timer storage or every timer is pending.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicTimerWheel<StateType, EventType>::Arm(Machine &inMachine, const Transition &inTransition, const Event &inEvent, Tick inDelay)
+{
+    Epoch theEpoch = inMachine.GetStateEpoch();
+
+    // Entering the ending state advances the epoch once.
+
+    if (!inMachine.IsInternalTransition(inTransition))
+        theEpoch++;
+
+    return (Add(inMachine, theEpoch, inTransition.mEnd, inEvent, inDelay));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine advances the wheel by the specified number of
+ *    ticks, firing each timer that expires, in order of expiry, unless
+ *    it was cancelled.
+ *
+ *  With no timers pending, the wheel skips straight to the new time.
+ *
+ *  @param[in]  inTicks  The number of ticks to advance by.
+ *
+ *  @return  The number of timers fired.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicTimerWheel<StateType, EventType>::Advance(Tick inTicks)
+{
+    size_t theFired = 0;
+    size_t theLevel;
+
+    while (inTicks > 0) {
+        if (mPending == 0) {
+            mNow += inTicks;
+            break;
+        }
+
+        mNow++;
+        inTicks--;
+
+        // Each level wrapping to its first slot cascades the next
+        // higher level's current slot, highest first.
+
+        theLevel = 1;
+
+        while ((theLevel < kLevels) && (((mNow >> ((theLevel - 1) * kSlotBits)) & (kSlots - 1)) == 0))
+            theLevel++;
+
+        while (--theLevel > 0)
+            Cascade(theLevel);
+
+        theFired += Expire();
+    }
+
+    return (theFired);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine allocates and links a timer to fire the specified
+ *    event at the specified machine after the specified number of
+ *    ticks, should the machine then be in the specified stay of the
+ *    specified state.
+ *
+ *  @param[in]  inMachine  A reference to the machine to fire at.
+ *  @param[in]  inEpoch    A reference to the state epoch of the stay.
+ *  @param[in]  inState    A reference to the state.
+ *  @param[in]  inEvent    A reference to the event to fire.
+ *  @param[in]  inDelay    The number of ticks after which to fire, at
+ *                         least one.
+ *
+ *  @return  \c true if the timer was armed; otherwise, \c false, if
+ *           there is no timer storage or every timer is pending.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicTimerWheel<StateType, EventType>::Add(Machine &inMachine, const Epoch &inEpoch, const State &inState, const Event &inEvent, Tick inDelay)
+{
+    Index theTimer;
+    bool  retval = true;
+
+    nlREQUIRE_ACTION(mFree != kIndexNone, done, retval = false);
+
+    theTimer = mFree;
+    mFree    = mTimers[theTimer].mNext;
+
+    mTimers[theTimer].mMachine = &inMachine;
+    mTimers[theTimer].mEpoch   = inEpoch;
+    mTimers[theTimer].mState   = inState;
+    mTimers[theTimer].mExpiry  = mNow + ((inDelay > 0) ? inDelay : 1);
+    mTimers[theTimer].mEvent   = inEvent;
+
+    Insert(theTimer);
+
+    mPending++;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine links the specified timer into the slot of the
+ *    lowest level spanning its remaining delay.
+ *
+ *  @param[in]  inTimer  The offset of the timer to link.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicTimerWheel<StateType, EventType>::Insert(Index inTimer)
+{
+    Timer &      theTimer = mTimers[inTimer];
+    const Tick   theDelta = theTimer.mExpiry - mNow;
+    size_t       theLevel = 0;
+    size_t       theSlot;
+
+    while ((theLevel < (kLevels - 1)) && (theDelta >= (static_cast<Tick>(1) << ((theLevel + 1) * kSlotBits))))
+        theLevel++;
+
+    theSlot = (theLevel * kSlots) + ((theTimer.mExpiry >> (theLevel * kSlotBits)) & (kSlots - 1));
+
+    theTimer.mNext = mSlots[theSlot];
+    mSlots[theSlot] = inTimer;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine moves each timer of the current slot of the
+ *    specified level into the levels below, now that its remaining
+ *    delay is within their span.
+ *
+ *  @param[in]  inLevel  The level to cascade.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicTimerWheel<StateType, EventType>::Cascade(size_t inLevel)
+{
+    const size_t theSlot = (inLevel * kSlots) + ((mNow >> (inLevel * kSlotBits)) & (kSlots - 1));
+    Index        theTimer = mSlots[theSlot];
+    Index        theNext;
+
+    mSlots[theSlot] = kIndexNone;
+
+    while (theTimer != kIndexNone) {
+        theNext = mTimers[theTimer].mNext;
+
+        Insert(theTimer);
+
+        theTimer = theNext;
+    }
+}
+
+/**
+ *
+ *  @brief
+ *    This routine frees each timer of the current slot of the lowest
+ *    level, firing those whose machine is still in the stay in which
+ *    the timer was armed.
+ *
+ *  Each timer is freed before it fires, so the event handling may arm
+ *  timers again.
+ *
+ *  @return  The number of timers fired.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicTimerWheel<StateType, EventType>::Expire(void)
+{
+    const size_t theSlot  = mNow & (kSlots - 1);
+    Index        theTimer = mSlots[theSlot];
+    Index        theNext;
+    Machine *    theMachine;
+    Event        theEvent;
+    Epoch        theEpoch;
+    State        theState;
+    size_t       theFired = 0;
+
+    mSlots[theSlot] = kIndexNone;
+
+    while (theTimer != kIndexNone) {
+        theNext    = mTimers[theTimer].mNext;
+        theMachine = mTimers[theTimer].mMachine;
+        theEvent   = mTimers[theTimer].mEvent;
+        theEpoch   = mTimers[theTimer].mEpoch;
+        theState   = mTimers[theTimer].mState;
+
+        mTimers[theTimer].mNext = mFree;
+        mFree = theTimer;
+        mPending--;
+
+        // Checking the state as well discards a timer armed for a
+        // transition that was vetoed, whose epoch a later transition
+        // to another state may reach.
+
+        if ((theMachine->GetStateEpoch() == theEpoch) && (theMachine->GetCurrentState() == theState)) {
+            mDriver->SetMachine(*theMachine);
+            mDriver->HandleEvent(theEvent, theMachine->GetCurrentState());
+
+            theFired++;
+        }
+
+        theTimer = theNext;
+    }
+
+    return (theFired);
+}
+
+// Explicit Instantiations
+
+template class BasicTimerWheel<uint8_t, uint8_t>;
+template class BasicTimerWheel<uint16_t, uint16_t>;
+template class BasicTimerWheel<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
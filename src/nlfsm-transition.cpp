@@ -75,6 +75,8 @@
  *
  */
 
+#include <stdint.h>
+
 #include <nestlabs/fsm/nlfsm-event.hpp>
 #include <nestlabs/fsm/nlfsm-state.hpp>
 #include <nestlabs/fsm/nlfsm-transition.hpp>
@@ -94,13 +96,24 @@ namespace Fsm {
  *  @return  \c true if lhs and rhs are equal; otherwise, \c false.
  *
  */
-bool operator ==(const Transition &lhs, const Transition &rhs)
+template <typename StateType, typename EventType>
+bool operator ==(const BasicTransition<StateType, EventType> &lhs,
+                 const BasicTransition<StateType, EventType> &rhs)
 {
     return ((lhs.mStart == rhs.mStart) &&
             (lhs.mEvent == rhs.mEvent) &&
             (lhs.mEnd	== rhs.mEnd));
 }
 
+// Explicit Instantiations
+
+template bool operator ==(const BasicTransition<uint8_t, uint8_t> &lhs,
+                          const BasicTransition<uint8_t, uint8_t> &rhs);
+template bool operator ==(const BasicTransition<uint16_t, uint16_t> &lhs,
+                          const BasicTransition<uint16_t, uint16_t> &rhs);
+template bool operator ==(const BasicTransition<uint32_t, uint32_t> &lhs,
+                          const BasicTransition<uint32_t, uint32_t> &rhs);
+
 }; // namespace Fsm
 
 }; // namespace nl
@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file defines internal, uninstalled utilities shared by the
+ *      finite state machine (FSM) implementation and its test
+ *      programs.
+ *
+ */
+
+#ifndef NLFSM_UTILITIES_HPP
+#define NLFSM_UTILITIES_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Preprocessor Definitions
+
+/**
+ *  The number of bits in each word of a state or event bitmap.
+ */
+#define kMaskBits         32
+
+namespace nl {
+
+    namespace Fsm {
+
+        /**
+         *
+         *  @class ArcOrder
+         *
+         *  @brief
+         *   Heap sort predicate object that orders transition table
+         *   offsets by starting state, event and offset.
+         *
+         */
+        template <typename Transition>
+        class ArcOrder
+        {
+         public:
+            ArcOrder(const Transition inTransitions[]) :
+                mTransitions(inTransitions)
+            {
+                return;
+            }
+
+            bool operator ()(uint32_t inFirst, uint32_t inSecond) const
+            {
+                const Transition &theFirst  = mTransitions[inFirst];
+                const Transition &theSecond = mTransitions[inSecond];
+
+                if (theFirst.mStart != theSecond.mStart)
+                    return (theFirst.mStart < theSecond.mStart);
+
+                if (theFirst.mEvent != theSecond.mEvent)
+                    return (theFirst.mEvent < theSecond.mEvent);
+
+                return (inFirst < inSecond);
+            }
+
+         private:
+            const Transition *  mTransitions;
+        };
+
+        /**
+         *
+         *  @brief
+         *    This function restores the max-heap property of the
+         *    specified items by sifting the item at the specified root
+         *    down.
+         *
+         *  @param[in,out]  ioItems  The items being heap-sorted.
+         *  @param[in]      inRoot   The offset of the item to sift
+         *                           down.
+         *  @param[in]      inCount  The number of items in the heap.
+         *  @param[in]      inOrder  The predicate ordering the items.
+         *
+         */
+        template <typename Item, typename Order>
+        static void
+        SiftDown(Item ioItems[], size_t inRoot, size_t inCount, const Order &inOrder)
+        {
+            const Item theItem = ioItems[inRoot];
+            size_t     theChild;
+
+            while ((theChild = (2 * inRoot) + 1) < inCount) {
+                if (((theChild + 1) < inCount) && inOrder(ioItems[theChild], ioItems[theChild + 1]))
+                    theChild++;
+
+                if (!inOrder(theItem, ioItems[theChild]))
+                    break;
+
+                ioItems[inRoot] = ioItems[theChild];
+                inRoot = theChild;
+            }
+
+            ioItems[inRoot] = theItem;
+        }
+
+        /**
+         *
+         *  @brief
+         *    This function sorts the specified items in place with an
+         *    O(n log n), allocation-free heap sort.
+         *
+         *  @param[in,out]  ioItems  The items to sort.
+         *  @param[in]      inCount  The number of items to sort.
+         *  @param[in]      inOrder  The predicate ordering the items.
+         *
+         */
+        template <typename Item, typename Order>
+        static void
+        HeapSort(Item ioItems[], size_t inCount, const Order &inOrder)
+        {
+            size_t i;
+
+            for (i = inCount / 2; i > 0; i--)
+                SiftDown(ioItems, i - 1, inCount, inOrder);
+
+            for (i = inCount; i > 1; i--) {
+                const Item theItem = ioItems[0];
+
+                ioItems[0]     = ioItems[i - 1];
+                ioItems[i - 1] = theItem;
+
+                SiftDown(ioItems, 0, i - 1, inOrder);
+            }
+        }
+
+        /**
+         *
+         *  @brief
+         *    This function returns the next value in a SplitMix64
+         *    sequence, advancing the sequence state.
+         *
+         *  @param[in,out]  ioState  A reference to the sequence state.
+         *
+         *  @return  The next value in the sequence.
+         *
+         */
+        static inline uint64_t
+        SplitMix64(uint64_t &ioState)
+        {
+            uint64_t theValue;
+
+            ioState += UINT64_C(0x9E3779B97F4A7C15);
+
+            theValue = ioState;
+            theValue = (theValue ^ (theValue >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+            theValue = (theValue ^ (theValue >> 27)) * UINT64_C(0x94D049BB133111EB);
+
+            return (theValue ^ (theValue >> 31));
+        }
+
+    }; // namespace Fsm
+
+}; // namespace nl
+
+#endif // NLFSM_UTILITIES_HPP
@@ -0,0 +1,507 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements an object for validating a finite state
+ *      machine (FSM) transition table and pruning its dead
+ *      transitions.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlassert.h>
+
+#include <nestlabs/fsm/nlfsm-transition.hpp>
+#include <nestlabs/fsm/nlfsm-validator.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+namespace nl {
+
+namespace Fsm {
+
+// Preprocessor Definitions
+
+/**
+ *  The flag indicating that a state appears in the table or is the
+ *  initial state.
+ */
+#define kStatePresent       0x01
+
+/**
+ *  The flag indicating that a state is reachable from the initial
+ *  state.
+ */
+#define kStateReachable     0x02
+
+/**
+ *
+ *  @brief
+ *    This routine is the class default (i.e. void) constructor. It
+ *    instantiates the validator without workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicValidator<StateType, EventType>::BasicValidator(void) :
+    mWorkspace(NULL),
+    mSize(0),
+    mGuarded(NULL),
+    mGuardedSize(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine is a class constructor. It instantiates the
+ *    validator with the specified workspace.
+ *
+ *  @param[in]  inWorkspace  The workspace to validate within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+BasicValidator<StateType, EventType>::BasicValidator(Word inWorkspace[], size_t inSize) :
+    mWorkspace(inWorkspace),
+    mSize(inSize),
+    mGuarded(NULL),
+    mGuardedSize(0)
+{
+    return;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets the workspace to validate within.
+ *
+ *  @param[in]  inWorkspace  The workspace to validate within.
+ *  @param[in]  inSize       The number of words in the workspace.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicValidator<StateType, EventType>::SetWorkspace(Word inWorkspace[], size_t inSize)
+{
+    mWorkspace = inWorkspace;
+    mSize      = inSize;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine sets which transitions of the tables to be validated
+ *    are guarded, as a bitmap in which bit (offset % 32) of word
+ *    (offset / 32) is set for each transition with a guard.
+ *
+ *  The flags must remain valid until they are cleared and must cover
+ *  every transition of any table validated.
+ *
+ *  @param[in]  inFlags  The per-transition guarded flags.
+ *  @param[in]  inSize   The number of words of flags.
+ *
+ *  @return  \c true if the flags were set; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicValidator<StateType, EventType>::SetGuardedTransitions(const Word inFlags[], size_t inSize)
+{
+    bool retval = true;
+
+    nlREQUIRE_ACTION(inFlags != NULL, done, retval = false);
+    nlREQUIRE_ACTION(inSize > 0, done, retval = false);
+
+    mGuarded     = inFlags;
+    mGuardedSize = inSize;
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine clears the guarded flags, after which every
+ *    transition following the first for a state and event is a
+ *    duplicate.
+ *
+ */
+template <typename StateType, typename EventType>
+void
+BasicValidator<StateType, EventType>::ClearGuardedTransitions(void)
+{
+    mGuarded     = NULL;
+    mGuardedSize = 0;
+}
+
+/**
+ *
+ *  @brief
+ *    This routine determines whether the transition at the specified
+ *    offset is guarded.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicValidator<StateType, EventType>::IsGuarded(size_t inOffset) const
+{
+    return ((mGuarded != NULL) && ((mGuarded[inOffset / kMaskBits] & (static_cast<Word>(1) << (inOffset % kMaskBits))) != 0));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of states of the specified
+ *    transition table, that is, one more than the largest state in
+ *    the table or the initial state.
+ *
+ *  @param[in]  inTransitions   The transition table.
+ *  @param[in]  inCount         The number of transitions in the table.
+ *  @param[in]  inInitialState  A reference to the initial state.
+ *
+ *  @return  The number of states, or zero if too many to validate.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicValidator<StateType, EventType>::GetStateCount(const Transition inTransitions[],
+                                                    size_t inCount,
+                                                    const State &inInitialState)
+{
+    uint64_t theMaxState = inInitialState;
+    size_t   i;
+
+    for (i = 0; i < inCount; i++) {
+        if (inTransitions[i].mStart > theMaxState)
+            theMaxState = inTransitions[i].mStart;
+
+        if (inTransitions[i].mEnd > theMaxState)
+            theMaxState = inTransitions[i].mEnd;
+    }
+
+    if ((theMaxState >= (UINT32_MAX - 1)) || (theMaxState >= (SIZE_MAX / 8)))
+        return (0);
+
+    return (static_cast<size_t>(theMaxState) + 1);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine gets the number of words of workspace required to
+ *    validate or prune the specified transition table.
+ *
+ *  @param[in]  inTransitions   The transition table.
+ *  @param[in]  inCount         The number of transitions in the table.
+ *  @param[in]  inInitialState  A reference to the initial state.
+ *
+ *  @return  The number of words required, or zero if the table is too
+ *           large to validate.
+ *
+ */
+template <typename StateType, typename EventType>
+size_t
+BasicValidator<StateType, EventType>::GetWorkspaceSize(const Transition inTransitions[],
+                                                       size_t inCount,
+                                                       const State &inInitialState)
+{
+    const size_t theStates = GetStateCount(inTransitions, inCount, inInitialState);
+
+    if ((theStates == 0) || (inCount >= (UINT32_MAX - 1)) || (inCount >= (SIZE_MAX / 8)))
+        return (0);
+
+    // Sorted arcs; dead arc flags; arcs by starting state; state
+    // flags; and the search queue.
+
+    return ((2 * inCount) + (theStates + 1) + (2 * theStates));
+}
+
+/**
+ *
+ *  @brief
+ *    This routine validates the specified transition table, notifying
+ *    the specified observer, if any, of each problem found.
+ *
+ *  Duplicates are reported in order of state and event, each
+ *  against the first transition for its state and event. With
+ *  guarded flags, the transitions immediately following a guarded
+ *  candidate for the same state and event are themselves candidates
+ *  rather than duplicates, up to and including the first unguarded
+ *  one. Unreachable and sink states are reported in order of state.
+ *  States that neither appear in the table nor are the initial state
+ *  are not reported.
+ *
+ *  @param[in]   inTransitions   The transition table to validate.
+ *  @param[in]   inCount         The number of transitions in the
+ *                               table.
+ *  @param[in]   inInitialState  A reference to the initial state.
+ *  @param[in]   inObserver      An optional pointer to the observer
+ *                               to notify of each problem found.
+ *  @param[out]  outReport       A reference to storage for the numbers
+ *                               of each problem found.
+ *
+ *  @return  \c true if the table was validated, whether or not any
+ *           problems were found; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicValidator<StateType, EventType>::Validate(const Transition inTransitions[],
+                                               size_t inCount,
+                                               const State &inInitialState,
+                                               Observer *inObserver,
+                                               Report &outReport) const
+{
+    const size_t theStates = GetStateCount(inTransitions, inCount, inInitialState);
+    uint32_t *   theArcs;
+    uint32_t *   theDead;
+    uint32_t *   theFirst;
+    uint32_t *   theFlags;
+    uint32_t *   theQueue;
+    size_t       theHead = 0;
+    size_t       theTail = 0;
+    size_t       theLeader = 0;
+    size_t       i, j;
+    bool         retval = true;
+
+    nlREQUIRE_ACTION((inTransitions != NULL) || (inCount == 0), done, retval = false);
+    nlREQUIRE_ACTION(mWorkspace != NULL, done, retval = false);
+    nlREQUIRE_ACTION(theStates > 0, done, retval = false);
+    nlREQUIRE_ACTION(mSize >= GetWorkspaceSize(inTransitions, inCount, inInitialState), done, retval = false);
+    nlREQUIRE_ACTION(mSize > 0, done, retval = false);
+    nlREQUIRE_ACTION((mGuarded == NULL) || (mGuardedSize >= ((inCount + kMaskBits - 1) / kMaskBits)), done, retval = false);
+
+    outReport.mDuplicates  = 0;
+    outReport.mUnreachable = 0;
+    outReport.mSinks       = 0;
+    outReport.mDead        = 0;
+
+    // Carve the workspace.
+
+    theArcs  = mWorkspace;
+    theDead  = theArcs + inCount;
+    theFirst = theDead + inCount;
+    theFlags = theFirst + theStates + 1;
+    theQueue = theFlags + theStates;
+
+    // Find the transitions shadowed by an earlier one for the same
+    // state and event, which sort right after it, unless they are
+    // live candidates, immediately following a live, guarded one in
+    // the table.
+
+    for (i = 0; i < inCount; i++) {
+        theArcs[i] = static_cast<uint32_t>(i);
+        theDead[i] = false;
+    }
+
+    HeapSort(theArcs, inCount, ArcOrder<Transition>(inTransitions));
+
+    for (i = 0; i < inCount; i++) {
+        const Transition &theFirstTransition = inTransitions[theArcs[theLeader]];
+        const Transition &theTransition      = inTransitions[theArcs[i]];
+
+        if ((i == 0) ||
+            (theFirstTransition.mStart != theTransition.mStart) ||
+            (theFirstTransition.mEvent != theTransition.mEvent)) {
+            theLeader = i;
+            continue;
+        }
+
+        if (!theDead[theArcs[i - 1]] && IsGuarded(theArcs[i - 1]) && (theArcs[i] == (theArcs[i - 1] + 1)))
+            continue;
+
+        theDead[theArcs[i]] = true;
+        outReport.mDuplicates++;
+
+        if (inObserver != NULL)
+            inObserver->DuplicateTransition(theFirstTransition, theTransition);
+    }
+
+    // Index the sorted arcs by starting state and note which states
+    // are present.
+
+    for (i = 0; i < theStates; i++) {
+        theFirst[i] = 0;
+        theFlags[i] = 0;
+    }
+
+    theFirst[theStates] = 0;
+    theFlags[inInitialState] |= kStatePresent;
+
+    for (i = 0; i < inCount; i++) {
+        theFirst[inTransitions[i].mStart + 1]++;
+        theFlags[inTransitions[i].mStart] |= kStatePresent;
+        theFlags[inTransitions[i].mEnd]   |= kStatePresent;
+    }
+
+    for (i = 0; i < theStates; i++)
+        theFirst[i + 1] += theFirst[i];
+
+    // Search the live transitions breadth-first from the initial
+    // state.
+
+    theFlags[inInitialState] |= kStateReachable;
+    theQueue[theTail++] = inInitialState;
+
+    while (theHead < theTail) {
+        const uint32_t theState = theQueue[theHead++];
+
+        for (j = theFirst[theState]; j < theFirst[theState + 1]; j++) {
+            const uint32_t theEnd = inTransitions[theArcs[j]].mEnd;
+
+            if (theDead[theArcs[j]] || ((theFlags[theEnd] & kStateReachable) != 0))
+                continue;
+
+            theFlags[theEnd] |= kStateReachable;
+            theQueue[theTail++] = theEnd;
+        }
+    }
+
+    // Report the unreachable states and the reachable states from
+    // which no live transition leads elsewhere.
+
+    for (i = 0; i < theStates; i++) {
+        if ((theFlags[i] & kStatePresent) == 0)
+            continue;
+
+        if ((theFlags[i] & kStateReachable) == 0) {
+            outReport.mUnreachable++;
+
+            if (inObserver != NULL)
+                inObserver->UnreachableState(static_cast<State>(i));
+
+            continue;
+        }
+
+        for (j = theFirst[i]; j < theFirst[i + 1]; j++) {
+            if (!theDead[theArcs[j]] && (inTransitions[theArcs[j]].mEnd != i))
+                break;
+        }
+
+        if (j == theFirst[i + 1]) {
+            outReport.mSinks++;
+
+            if (inObserver != NULL)
+                inObserver->SinkState(static_cast<State>(i));
+        }
+    }
+
+    // Transitions out of unreachable states are as dead as the
+    // shadowed ones.
+
+    for (i = 0; i < inCount; i++) {
+        if ((theFlags[inTransitions[i].mStart] & kStateReachable) == 0)
+            theDead[i] = true;
+
+        if (theDead[i])
+            outReport.mDead++;
+    }
+
+ done:
+    return (retval);
+}
+
+/**
+ *
+ *  @brief
+ *    This routine prunes the specified transition table of shadowed
+ *    duplicates and of transitions out of unreachable states.
+ *
+ *  The pruned table keeps the remaining transitions in their original
+ *  order and behaves identically to the original from the initial
+ *  state with any lookup strategy.
+ *
+ *  Any arrays parallel to the table, such as actions, guards, outputs
+ *  or guarded flags, must be compacted to match, by moving each entry
+ *  from the original offset recorded for its transition.
+ *
+ *  @param[in]      inTransitions   The transition table to prune.
+ *  @param[in]      inCount         The number of transitions in the
+ *                                  table.
+ *  @param[in]      inInitialState  A reference to the initial state.
+ *  @param[out]     outTransitions  Storage for the pruned table, which
+ *                                  may be the table to prune itself,
+ *                                  to prune in place.
+ *  @param[out]     outOffsets      Optional storage, as large as that
+ *                                  for the pruned table, for the
+ *                                  offset in the table to prune of
+ *                                  each transition in the pruned
+ *                                  table, or NULL.
+ *  @param[in,out]  ioCount         On input, the number of transitions
+ *                                  available in the pruned table
+ *                                  storage; on output, the number of
+ *                                  transitions in the pruned table.
+ *
+ *  @return  \c true if the table was pruned; otherwise, \c false.
+ *
+ */
+template <typename StateType, typename EventType>
+bool
+BasicValidator<StateType, EventType>::Prune(const Transition inTransitions[],
+                                            size_t inCount,
+                                            const State &inInitialState,
+                                            Transition outTransitions[],
+                                            size_t outOffsets[],
+                                            size_t &ioCount) const
+{
+    const uint32_t * theDead;
+    Report           theReport;
+    size_t           i, j;
+    bool             retval;
+
+    nlREQUIRE_ACTION(outTransitions != NULL, done, retval = false);
+
+    retval = Validate(inTransitions, inCount, inInitialState, NULL, theReport);
+    nlREQUIRE(retval, done);
+
+    nlREQUIRE_ACTION(ioCount >= (inCount - theReport.mDead), done, retval = false);
+
+    // Copying forward is safe in place, since no transition moves
+    // later in the table.
+
+    theDead = mWorkspace + inCount;
+
+    for (i = 0, j = 0; i < inCount; i++) {
+        if (theDead[i])
+            continue;
+
+        if (outOffsets != NULL)
+            outOffsets[j] = i;
+
+        outTransitions[j++] = inTransitions[i];
+    }
+
+    ioCount = j;
+
+ done:
+    return (retval);
+}
+
+// Explicit Instantiations
+
+template class BasicValidator<uint8_t, uint8_t>;
+template class BasicValidator<uint16_t, uint16_t>;
+template class BasicValidator<uint32_t, uint32_t>;
+
+}; // namespace Fsm
+
+}; // namespace nl
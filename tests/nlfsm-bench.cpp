@@ -0,0 +1,329 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the transition lookup
+ *      strategies of the Nest Labs Finite State Machine library.
+ *
+ *      A pseudo-randomly generated table of sparse, 32-bit state
+ *      and event identifiers is indexed with every applicable lookup
+ *      strategy, reporting the time taken to build each index and
+ *      the mean time per lookup over a pseudo-random mix of present
+ *      and absent keys. Every strategy is checked against the sorted
+ *      index for the same results, such that the benchmark also
+ *      fails if any strategy disagrees.
+ *
+ *      A second mix of lookups, in bursts repeating the same key as
+ *      events that loop back to the same state do, measures the
+ *      transition cache against the uncached lookups.
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <nestlabs/fsm/nlfsm.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+/* Preprocessor Definitions */
+
+#define kDefaultTransitions 1000000
+#define kDefaultLookups     1000000
+#define kDefaultSeed        0x235A
+#define kDefaultBurst       8
+
+// The number of entries in the transition cache.
+
+#define kCacheEntries       4
+
+// Tables larger than this are not benchmarked with a linear scan.
+
+#define kMaxLinearTransitions 4096
+
+/* Type Definitions */
+
+typedef nl::Fsm::BasicMachine<uint32_t, uint32_t> Machine;
+
+/* Global Variables */
+
+static const char *sProgram = "nlfsm-bench";
+
+// Accumulates lookup results such that they are not optimized away.
+
+static volatile uintptr_t sSink;
+
+static double Now(void)
+{
+    struct timeval theTime;
+
+    gettimeofday(&theTime, NULL);
+
+    return (theTime.tv_sec + (theTime.tv_usec / 1e6));
+}
+
+/**
+ *
+ *  @brief
+ *    This function performs the specified lookups with the specified
+ *    machine, reporting the index build time and the mean time per
+ *    lookup, and checks the results against those expected.
+ *
+ *  @return  \c true if every lookup found the expected transition;
+ *           otherwise, \c false.
+ *
+ */
+static bool Measure(const char *inName,
+                    double inBuildTime,
+                    const Machine &inMachine,
+                    const Machine::Transition inLookups[],
+                    const Machine::Transition * const inExpected[],
+                    size_t inCount)
+{
+    uintptr_t theSum = 0;
+    size_t    theMismatches = 0;
+    double    theStart;
+    double    theElapsed;
+
+    theStart = Now();
+
+    for (size_t i = 0; i < inCount; i++)
+        theSum += reinterpret_cast<uintptr_t>(inMachine.FindTransition(inLookups[i].mStart, inLookups[i].mEvent));
+
+    theElapsed = Now() - theStart;
+    sSink     += theSum;
+
+    for (size_t i = 0; i < inCount; i++) {
+        if (inMachine.FindTransition(inLookups[i].mStart, inLookups[i].mEvent) != inExpected[i])
+            theMismatches++;
+    }
+
+    printf("%s: %-19s build %10.3f ms, lookup %8.1f ns\n",
+           sProgram, inName, inBuildTime * 1e3,
+           (inCount > 0) ? ((theElapsed * 1e9) / inCount) : 0.0);
+
+    if (theMismatches != 0)
+        fprintf(stderr, "%s: %s: %lu lookups disagree with the sorted index\n",
+                sProgram, inName, static_cast<unsigned long>(theMismatches));
+
+    return (theMismatches == 0);
+}
+
+static void Usage(FILE *inStream)
+{
+    fprintf(inStream,
+            "Usage: %s [ -h ] [ -b <burst> ] [ -n <transitions> ] [ -l <lookups> ] [ -s <seed> ]\n"
+            "\n"
+            "  -b <burst>        Mean length of bursts of repeated lookups (default %u).\n"
+            "  -h                Display this help and exit.\n"
+            "  -n <transitions>  Number of transitions in the table (default %u).\n"
+            "  -l <lookups>      Number of lookups per strategy (default %u).\n"
+            "  -s <seed>         Seed of the table and lookups (default %u).\n",
+            sProgram, kDefaultBurst, kDefaultTransitions, kDefaultLookups, kDefaultSeed);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long                 theTransitionCount = kDefaultTransitions;
+    unsigned long                 theLookupCount = kDefaultLookups;
+    unsigned long                 theBurst = kDefaultBurst;
+    uint64_t                      theRandom = kDefaultSeed;
+    Machine::Transition *         theTransitions = NULL;
+    Machine::Transition *         theLookups = NULL;
+    const Machine::Transition **  theExpected = NULL;
+    Machine::Transition *         theBursts = NULL;
+    const Machine::Transition **  theBurstExpected = NULL;
+    Machine::SortedEntry          theCache[kCacheEntries];
+    Machine::SortedEntry *        theSortedIndex = NULL;
+    Machine::SortedEntry *        theEytzingerIndex = NULL;
+    Machine::Offset *             theHashIndex = NULL;
+    Machine                       theMachine;
+    double                        theStart;
+    double                        theBuildTime;
+    int                           theOption;
+    bool                          retval = true;
+
+    while ((theOption = getopt(argc, argv, "b:hl:n:s:")) != -1) {
+        switch (theOption) {
+
+        case 'b':
+            theBurst = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'h':
+            Usage(stdout);
+            return (EXIT_SUCCESS);
+
+        case 'l':
+            theLookupCount = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'n':
+            theTransitionCount = strtoul(optarg, NULL, 0);
+            break;
+
+        case 's':
+            theRandom = strtoull(optarg, NULL, 0);
+            break;
+
+        default:
+            Usage(stderr);
+            return (EXIT_FAILURE);
+
+        }
+    }
+
+    theTransitions    = static_cast<Machine::Transition *>(malloc(theTransitionCount * sizeof (Machine::Transition)));
+    theLookups        = static_cast<Machine::Transition *>(malloc(theLookupCount * sizeof (Machine::Transition)));
+    theExpected       = static_cast<const Machine::Transition **>(malloc(theLookupCount * sizeof (Machine::Transition *)));
+    theSortedIndex    = static_cast<Machine::SortedEntry *>(malloc(theTransitionCount * sizeof (Machine::SortedEntry)));
+    theEytzingerIndex = static_cast<Machine::SortedEntry *>(malloc((theTransitionCount + 1) * sizeof (Machine::SortedEntry)));
+    theBursts         = static_cast<Machine::Transition *>(malloc(theLookupCount * sizeof (Machine::Transition)));
+    theBurstExpected  = static_cast<const Machine::Transition **>(malloc(theLookupCount * sizeof (Machine::Transition *)));
+
+    if ((theTransitions == NULL) || (theLookups == NULL) || (theExpected == NULL) ||
+        (theSortedIndex == NULL) || (theEytzingerIndex == NULL) ||
+        (theBursts == NULL) || (theBurstExpected == NULL)) {
+        fprintf(stderr, "%s: failed to allocate the table and indices\n", sProgram);
+        retval = false;
+        goto done;
+    }
+
+    // Generate a table of sparse, full-width identifiers and a mix of
+    // lookups, about half of which are for keys in the table.
+
+    for (size_t i = 0; i < theTransitionCount; i++) {
+        const uint64_t theValue = nl::Fsm::SplitMix64(theRandom);
+
+        theTransitions[i].mStart = static_cast<uint32_t>(theValue);
+        theTransitions[i].mEvent = static_cast<uint32_t>(theValue >> 32);
+        theTransitions[i].mEnd   = static_cast<uint32_t>(nl::Fsm::SplitMix64(theRandom));
+    }
+
+    for (size_t i = 0; i < theLookupCount; i++) {
+        const uint64_t theValue = nl::Fsm::SplitMix64(theRandom);
+
+        if (((theValue & 1) != 0) && (theTransitionCount > 0)) {
+            theLookups[i] = theTransitions[(theValue >> 1) % theTransitionCount];
+        } else {
+            theLookups[i].mStart = static_cast<uint32_t>(theValue);
+            theLookups[i].mEvent = static_cast<uint32_t>(nl::Fsm::SplitMix64(theRandom));
+        }
+    }
+
+    // Repeat each lookup for a burst of, on average, the requested
+    // length.
+
+    for (size_t i = 0, j = 0; i < theLookupCount; j++) {
+        const size_t theLength = 1 + (nl::Fsm::SplitMix64(theRandom) % ((2 * theBurst) + 1));
+
+        for (size_t k = 0; (k < theLength) && (i < theLookupCount); k++)
+            theBursts[i++] = theLookups[j % theLookupCount];
+    }
+
+    printf("%s: %lu transitions, %lu lookups per strategy\n", sProgram, theTransitionCount, theLookupCount);
+
+    // The sorted index establishes the expected results for every
+    // other strategy.
+
+    theMachine.SetTransitions(theTransitions, theTransitionCount, 0);
+
+    theStart     = Now();
+    retval       = theMachine.SetSortedLookup(theSortedIndex, theTransitionCount);
+    theBuildTime = Now() - theStart;
+
+    if (!retval) {
+        fprintf(stderr, "%s: failed to build the sorted index\n", sProgram);
+        goto done;
+    }
+
+    for (size_t i = 0; i < theLookupCount; i++)
+        theExpected[i] = theMachine.FindTransition(theLookups[i].mStart, theLookups[i].mEvent);
+
+    retval = Measure("sorted", theBuildTime, theMachine, theLookups, theExpected, theLookupCount) && retval;
+
+    if (theTransitionCount <= kMaxLinearTransitions) {
+        theMachine.SetLinearLookup();
+
+        retval = Measure("linear", 0, theMachine, theLookups, theExpected, theLookupCount) && retval;
+    }
+
+    theStart     = Now();
+    retval       = theMachine.SetEytzingerLookup(theEytzingerIndex, theTransitionCount + 1, theSortedIndex, theTransitionCount) && retval;
+    theBuildTime = Now() - theStart;
+
+    retval = Measure("eytzinger", theBuildTime, theMachine, theLookups, theExpected, theLookupCount) && retval;
+
+    theHashIndex = static_cast<Machine::Offset *>(malloc(theMachine.GetHashIndexSize() * sizeof (Machine::Offset)));
+
+    if (theHashIndex == NULL) {
+        fprintf(stderr, "%s: failed to allocate the perfect hash index\n", sProgram);
+        retval = false;
+        goto done;
+    }
+
+    theStart     = Now();
+    retval       = theMachine.SetHashLookup(theHashIndex, theMachine.GetHashIndexSize(), theSortedIndex, theTransitionCount) && retval;
+    theBuildTime = Now() - theStart;
+
+    retval = Measure("hash", theBuildTime, theMachine, theLookups, theExpected, theLookupCount) && retval;
+
+    // Measure the bursts without and then with the transition cache,
+    // in front of the sorted index and, where practical, a linear
+    // scan. The cache survives changes of lookup strategy.
+
+    retval = theMachine.SetSortedLookup(theSortedIndex, theTransitionCount) && retval;
+
+    for (size_t i = 0; i < theLookupCount; i++)
+        theBurstExpected[i] = theMachine.FindTransition(theBursts[i].mStart, theBursts[i].mEvent);
+
+    retval = Measure("sorted burst", 0, theMachine, theBursts, theBurstExpected, theLookupCount) && retval;
+
+    retval = theMachine.SetTransitionCache(theCache, kCacheEntries) && retval;
+
+    retval = Measure("cached sorted", 0, theMachine, theLookups, theExpected, theLookupCount) && retval;
+    retval = Measure("cached sorted burst", 0, theMachine, theBursts, theBurstExpected, theLookupCount) && retval;
+
+    if (theTransitionCount <= kMaxLinearTransitions) {
+        theMachine.SetLinearLookup();
+
+        retval = Measure("cached linear burst", 0, theMachine, theBursts, theBurstExpected, theLookupCount) && retval;
+
+        theMachine.ClearTransitionCache();
+
+        retval = Measure("linear burst", 0, theMachine, theBursts, theBurstExpected, theLookupCount) && retval;
+    }
+
+ done:
+    free(theBurstExpected);
+    free(theBursts);
+    free(theHashIndex);
+    free(theEytzingerIndex);
+    free(theSortedIndex);
+    free(theExpected);
+    free(theLookups);
+    free(theTransitions);
+
+    return (retval ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,700 @@
+/*
+ *
+ *    Copyright (c) 2026 Nest Labs, Inc. All Rights Reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ *
+ */
+
+/**
+ *    @file
+ *      This file implements a randomized, multi-threaded stress and
+ *      fault-injection campaign for the Nest Labs Finite State
+ *      Machine library.
+ *
+ *      Each campaign run constructs its own pseudo-randomly generated
+ *      transition table, machine, driver and seeded random delegate,
+ *      fires a pseudo-random event sequence through the driver, and
+ *      checks the following invariants after every event:
+ *
+ *        - The machine, using a pseudo-randomly chosen lookup
+ *          strategy, finds the same transition as a linear scan
+ *          and, with or without event classes, the same next state.
+ *
+ *        - The current state is always either the initial state or
+ *          the ending state of some transition in the table.
+ *
+ *        - An event with no matching transition leaves the current
+ *          state unchanged and invokes no delegate methods.
+ *
+ *        - An event vetoed at or before WillEnterState leaves the
+ *          current state unchanged.
+ *
+ *        - An event vetoed after WillEnterState, or handled
+ *          successfully, leaves the machine at the ending state of
+ *          the matching transition.
+ *
+ *      Runs are distributed across a pool of threads. Every run is
+ *      fully determined by its seed, which is reported on failure
+ *      such that the run may be replayed in isolation with '-s'.
+ *
+ *      The campaign is followed by a pipeline phase, in which a chain
+ *      of Mealy machines, each halving the rate of its input events,
+ *      runs with each stage in its own thread, pinned to its own
+ *      processor where available, and checks that exactly the
+ *      expected number of output events emerges.
+ *
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <nestlabs/fsm/nlfsm.hpp>
+
+#include "nlfsm-utilities.hpp"
+
+/* Preprocessor Definitions */
+
+#define kDefaultRuns        2000
+#define kDefaultEvents      2000
+#define kDefaultThreads     4
+#define kDefaultSeed        0x235A
+
+#define kMaxStates          32
+#define kMaxEvents          16
+#define kMaxTransitions     (kMaxStates * kMaxEvents)
+
+#define kMaxThreads         256
+
+#define kPipelineStages     3
+#define kPipelineQueueSize  1024
+#define kPipelineScale      256
+
+/* Type Definitions */
+
+/**
+ *  Campaign-wide parameters and results, shared among the worker
+ *  threads.
+ */
+struct Campaign
+{
+    unsigned long       mRuns;          //!< Number of runs to perform.
+    unsigned long       mEvents;        //!< Events fired per run.
+    unsigned long       mSeed;          //!< Seed of the first run.
+    bool                mVerbose;       //!< Whether to log every failure.
+
+    volatile unsigned long mNextRun;    //!< Next run to claim.
+    volatile unsigned long mFailures;   //!< Number of failed runs.
+    volatile unsigned long mFirstFailingSeed; //!< Lowest failing seed.
+    volatile unsigned long mHandled;    //!< Events handled successfully.
+    volatile unsigned long mRejected;   //!< Events without a transition.
+    volatile unsigned long mVetoed;     //!< Events vetoed by the delegate.
+};
+
+/**
+ *  A pseudo-random delegate that additionally records which of its
+ *  methods were invoked and which, if any, vetoed the in-flight
+ *  event.
+ */
+class RecordingDelegate : public nl::Fsm::Delegate::Random
+{
+public:
+    RecordingDelegate(unsigned int inSeed) :
+        nl::Fsm::Delegate::Random(inSeed)
+    {
+        Reset();
+    }
+
+    void Reset(void)
+    {
+        mCalls = 0;
+        mVeto  = kHookMax;
+    }
+
+    virtual bool WillHandleEvent(const nl::Fsm::Event &inEvent,
+                                 const nl::Fsm::State &inState)
+    {
+        return (Record(kHookWillHandleEvent, nl::Fsm::Delegate::Random::WillHandleEvent(inEvent, inState)));
+    }
+
+    virtual bool DidHandleEvent(const nl::Fsm::Event &inEvent,
+                                const nl::Fsm::State &inState)
+    {
+        return (Record(kHookDidHandleEvent, nl::Fsm::Delegate::Random::DidHandleEvent(inEvent, inState)));
+    }
+
+    virtual bool WillExitState(const nl::Fsm::Event &inEvent,
+                               const nl::Fsm::Transition &inTransition)
+    {
+        return (Record(kHookWillExitState, nl::Fsm::Delegate::Random::WillExitState(inEvent, inTransition)));
+    }
+
+    virtual bool DidExitState(const nl::Fsm::Event &inEvent,
+                              const nl::Fsm::Transition &inTransition)
+    {
+        return (Record(kHookDidExitState, nl::Fsm::Delegate::Random::DidExitState(inEvent, inTransition)));
+    }
+
+    virtual bool WillTransition(const nl::Fsm::Event &inEvent,
+                                const nl::Fsm::Transition &inTransition)
+    {
+        return (Record(kHookWillTransition, nl::Fsm::Delegate::Random::WillTransition(inEvent, inTransition)));
+    }
+
+    virtual bool DidTransition(const nl::Fsm::Event &inEvent,
+                               const nl::Fsm::Transition &inTransition)
+    {
+        return (Record(kHookDidTransition, nl::Fsm::Delegate::Random::DidTransition(inEvent, inTransition)));
+    }
+
+    virtual bool WillEnterState(const nl::Fsm::Event &inEvent,
+                                const nl::Fsm::Transition &inTransition)
+    {
+        return (Record(kHookWillEnterState, nl::Fsm::Delegate::Random::WillEnterState(inEvent, inTransition)));
+    }
+
+    virtual bool DidEnterState(const nl::Fsm::Event &inEvent,
+                               const nl::Fsm::Transition &inTransition)
+    {
+        return (Record(kHookDidEnterState, nl::Fsm::Delegate::Random::DidEnterState(inEvent, inTransition)));
+    }
+
+    size_t  mCalls;     //!< Delegate methods invoked for the last event.
+    Hook    mVeto;      //!< The vetoing method, or kHookMax if none.
+
+private:
+    bool Record(Hook inHook, bool inStatus)
+    {
+        mCalls++;
+
+        if (!inStatus)
+            mVeto = inHook;
+
+        return (inStatus);
+    }
+};
+
+/**
+ *  A pipeline stage thread, which runs its stage until it has taken
+ *  the expected number of input events.
+ */
+struct PipelineStage
+{
+    nl::Fsm::Pipeline * mPipeline;      //!< The pipeline.
+    size_t              mStage;         //!< The stage to run.
+    unsigned long       mExpected;      //!< Input events to take.
+    long                mProcessor;     //!< Processor to pin to, or -1.
+};
+
+/* Global Variables */
+
+static const char *sProgram = "nlfsm-stress";
+
+static double Now(void)
+{
+    struct timeval theTime;
+
+    gettimeofday(&theTime, NULL);
+
+    return (theTime.tv_sec + (theTime.tv_usec / 1e6));
+}
+
+static void AtomicAdd(volatile unsigned long &ioValue, unsigned long inAmount)
+{
+    __sync_fetch_and_add(&ioValue, inAmount);
+}
+
+static void RecordFailure(Campaign &inCampaign, unsigned long inSeed)
+{
+    unsigned long theFirst;
+
+    AtomicAdd(inCampaign.mFailures, 1);
+
+    do {
+        theFirst = inCampaign.mFirstFailingSeed;
+
+        if (theFirst <= inSeed)
+            break;
+
+    } while (!__sync_bool_compare_and_swap(&inCampaign.mFirstFailingSeed, theFirst, inSeed));
+}
+
+/**
+ *
+ *  @brief
+ *    This function generates a pseudo-random transition table,
+ *    returning the number of transitions written.
+ *
+ */
+static size_t GenerateTransitions(uint64_t &ioRandom,
+                                  nl::Fsm::Transition outTransitions[],
+                                  size_t &outStates,
+                                  size_t &outEvents)
+{
+    size_t theCount;
+
+    outStates = 2 + (nl::Fsm::SplitMix64(ioRandom) % (kMaxStates - 1));
+    outEvents = 1 + (nl::Fsm::SplitMix64(ioRandom) % kMaxEvents);
+    theCount  = (outStates * outEvents) / 2;
+    theCount += 1 + (nl::Fsm::SplitMix64(ioRandom) % theCount);
+
+    for (size_t i = 0; i < theCount; i++) {
+        outTransitions[i].mStart = static_cast<nl::Fsm::State>(nl::Fsm::SplitMix64(ioRandom) % outStates);
+        outTransitions[i].mEvent = static_cast<nl::Fsm::Event>(nl::Fsm::SplitMix64(ioRandom) % outEvents);
+        outTransitions[i].mEnd   = static_cast<nl::Fsm::State>(nl::Fsm::SplitMix64(ioRandom) % outStates);
+    }
+
+    return (theCount);
+}
+
+/**
+ *
+ *  @brief
+ *    This function performs one campaign run with the specified seed.
+ *
+ *  @return  \c true if all invariants held; otherwise, \c false.
+ *
+ */
+static bool Run(Campaign &inCampaign, unsigned long inSeed)
+{
+    nl::Fsm::Transition   theTransitions[kMaxTransitions];
+    bool                  theReachable[kMaxStates];
+    uint64_t              theRandom = inSeed;
+    size_t                theStates;
+    size_t                theEvents;
+    size_t                theCount;
+    nl::Fsm::State        theInitial;
+    unsigned long         theHandled = 0;
+    unsigned long         theRejected = 0;
+    unsigned long         theVetoed = 0;
+    bool                  retval = true;
+
+    theCount   = GenerateTransitions(theRandom, theTransitions, theStates, theEvents);
+    theInitial = static_cast<nl::Fsm::State>(nl::Fsm::SplitMix64(theRandom) % theStates);
+
+    memset(theReachable, 0, sizeof (theReachable));
+
+    theReachable[theInitial] = true;
+
+    for (size_t i = 0; i < theCount; i++)
+        theReachable[theTransitions[i].mEnd] = true;
+
+    {
+        RecordingDelegate              theDelegate(static_cast<unsigned int>(inSeed));
+        nl::Fsm::Machine               theMachine(theTransitions, theCount, theInitial);
+        nl::Fsm::Machine               theReference(theTransitions, theCount, theInitial);
+        nl::Fsm::Driver                theDriver(theMachine, &theDelegate);
+        nl::Fsm::Machine::Offset       theDenseIndex[kMaxStates * kMaxEvents];
+        nl::Fsm::Machine::SortedEntry  theSortedIndex[kMaxTransitions];
+        nl::Fsm::Machine::SortedEntry  theEytzingerIndex[kMaxTransitions + 1];
+        nl::Fsm::Machine::Offset       theHashIndex[kMaxTransitions + kMaxTransitions];
+        nl::Fsm::Machine::Mask         theAcceptedEvents[kMaxStates];
+        nl::Fsm::Event                 theClassMap[kMaxEvents];
+        nl::Fsm::Machine::Offset       theClassIndex[kMaxStates * kMaxEvents];
+        nl::Fsm::Machine::SortedEntry  theCache[4];
+
+        theDelegate.SetVetoProbability(0.05);
+
+        // Exercise a pseudo-randomly chosen lookup strategy, checked
+        // against a reference machine using a linear scan.
+
+        switch (nl::Fsm::SplitMix64(theRandom) % 5) {
+
+        case 1:
+            retval = theMachine.SetDenseLookup(theDenseIndex, kMaxStates * kMaxEvents);
+            break;
+
+        case 2:
+            retval = theMachine.SetSortedLookup(theSortedIndex, kMaxTransitions);
+            break;
+
+        case 3:
+            retval = theMachine.SetEytzingerLookup(theEytzingerIndex, kMaxTransitions + 1, theSortedIndex, kMaxTransitions);
+            break;
+
+        case 4:
+            retval = theMachine.SetHashLookup(theHashIndex, kMaxTransitions + kMaxTransitions, theSortedIndex, kMaxTransitions);
+            break;
+
+        default:
+            break;
+
+        }
+
+        // Independently, exercise the accepted-event bitmap.
+
+        if (retval && ((nl::Fsm::SplitMix64(theRandom) % 2) == 0))
+            retval = theMachine.SetAcceptedEvents(theAcceptedEvents, kMaxStates);
+
+        // Likewise, the event classes and next-state index.
+
+        if (retval && ((nl::Fsm::SplitMix64(theRandom) % 2) == 0))
+            retval = theMachine.SetEventClasses(theClassMap, kMaxEvents, theClassIndex, kMaxStates * kMaxEvents);
+
+        // And a transition cache of one to four entries.
+
+        if (retval && ((nl::Fsm::SplitMix64(theRandom) % 2) == 0))
+            retval = theMachine.SetTransitionCache(theCache, 1 + (nl::Fsm::SplitMix64(theRandom) % 4));
+
+        for (unsigned long i = 0; (i < inCampaign.mEvents) && retval; i++) {
+            const nl::Fsm::Event        theEvent  = static_cast<nl::Fsm::Event>(nl::Fsm::SplitMix64(theRandom) % (theEvents + 1));
+            const nl::Fsm::State        theBefore = theMachine.GetCurrentState();
+            const nl::Fsm::Transition * theTransition = theReference.FindTransition(theBefore, theEvent);
+            nl::Fsm::State              theAfter;
+            nl::Fsm::State              theNext = theBefore;
+            const bool                  theFound = theMachine.FindNextState(theBefore, theEvent, theNext);
+            bool                        theStatus;
+
+            theDelegate.Reset();
+
+            theStatus = theDriver.HandleEvent(theEvent);
+            theAfter  = theMachine.GetCurrentState();
+
+            if (!theReachable[theAfter] ||
+                (theMachine.FindTransition(theBefore, theEvent) != theTransition) ||
+                (theFound != (theTransition != NULL)) ||
+                (theFound && (theNext != theTransition->mEnd))) {
+                retval = false;
+
+            } else if (theTransition == NULL) {
+                retval = (!theStatus && (theAfter == theBefore) && (theDelegate.mCalls == 0));
+                theRejected++;
+
+            } else if (theStatus) {
+                retval = ((theAfter == theTransition->mEnd) &&
+                          (theDelegate.mCalls == nl::Fsm::Delegate::Random::kHookMax) &&
+                          (theDelegate.mVeto == nl::Fsm::Delegate::Random::kHookMax));
+                theHandled++;
+
+            } else {
+                switch (theDelegate.mVeto) {
+
+                case nl::Fsm::Delegate::Random::kHookDidEnterState:
+                case nl::Fsm::Delegate::Random::kHookDidHandleEvent:
+                    retval = (theAfter == theTransition->mEnd);
+                    break;
+
+                case nl::Fsm::Delegate::Random::kHookMax:
+                    retval = false;
+                    break;
+
+                default:
+                    retval = (theAfter == theBefore);
+                    break;
+
+                }
+
+                theVetoed++;
+            }
+
+            if (!retval && inCampaign.mVerbose) {
+                fprintf(stderr,
+                        "%s: seed %lu: invariant violated at event %lu "
+                        "(event %u, state %u -> %u, status %d)\n",
+                        sProgram, inSeed, i, theEvent, theBefore, theAfter, theStatus);
+            }
+        }
+    }
+
+    AtomicAdd(inCampaign.mHandled, theHandled);
+    AtomicAdd(inCampaign.mRejected, theRejected);
+    AtomicAdd(inCampaign.mVetoed, theVetoed);
+
+    return (retval);
+}
+
+static void *Worker(void *inContext)
+{
+    Campaign &theCampaign = *static_cast<Campaign *>(inContext);
+    unsigned long theRun;
+
+    while ((theRun = __sync_fetch_and_add(&theCampaign.mNextRun, 1)) < theCampaign.mRuns) {
+        const unsigned long theSeed = theCampaign.mSeed + theRun;
+
+        if (!Run(theCampaign, theSeed))
+            RecordFailure(theCampaign, theSeed);
+    }
+
+    return (NULL);
+}
+
+static void *PipelineWorker(void *inContext)
+{
+    PipelineStage &theStage = *static_cast<PipelineStage *>(inContext);
+    unsigned long theTaken = 0;
+    size_t        theCount;
+
+#if defined(__linux__)
+    if (theStage.mProcessor >= 0) {
+        cpu_set_t theSet;
+
+        CPU_ZERO(&theSet);
+        CPU_SET(theStage.mProcessor, &theSet);
+
+        pthread_setaffinity_np(pthread_self(), sizeof (theSet), &theSet);
+    }
+#endif // defined(__linux__)
+
+    while (theTaken < theStage.mExpected) {
+        theCount = theStage.mPipeline->RunStage(theStage.mStage, theStage.mExpected - theTaken);
+
+        if (theCount == 0)
+            sched_yield();
+
+        theTaken += theCount;
+    }
+
+    return (NULL);
+}
+
+/**
+ *
+ *  @brief
+ *    This function runs the pipeline phase, pushing the specified
+ *    number of events through a chain of machines, each in its own
+ *    thread, each emitting one output event for every second input
+ *    event.
+ *
+ *  @return  \c true if exactly the expected output events emerged;
+ *           otherwise, \c false.
+ *
+ */
+static bool RunPipeline(unsigned long inEvents)
+{
+    static const nl::Fsm::Transition sTransitions[] = {
+        { 0, 0, 1 },
+        { 1, 0, 0 }
+    };
+    static const nl::Fsm::Event sOutputs[] = {
+        nl::Fsm::Transition::kNoEvent,
+        0
+    };
+    const nl::Fsm::State            theInitial(0);
+    nl::Fsm::Machine                theMachines[kPipelineStages];
+    nl::Fsm::Driver                 theDrivers[kPipelineStages];
+    nl::Fsm::Driver *               theStages[kPipelineStages];
+    nl::Fsm::Pipeline::Queue        theQueues[kPipelineStages + 1];
+    static nl::Fsm::Event           sEvents[(kPipelineStages + 1) * kPipelineQueueSize];
+    PipelineStage                   theContexts[kPipelineStages];
+    pthread_t                       theThreads[kPipelineStages];
+    const long                      theProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    const unsigned long             theExpected = inEvents >> kPipelineStages;
+    unsigned long                   thePushed = 0;
+    unsigned long                   thePopped = 0;
+    unsigned long                   theWrong = 0;
+    nl::Fsm::Event                  theOutput;
+    bool                            theProgress;
+    double                          theStart;
+    double                          theElapsed;
+    int                             status;
+
+    for (size_t i = 0; i < kPipelineStages; i++) {
+        theMachines[i].SetTransitions(sTransitions, 2, theInitial);
+        theMachines[i].SetOutputs(sOutputs, 2);
+
+        theDrivers[i].SetMachine(theMachines[i]);
+        theDrivers[i].SetDelegate(nl::Fsm::Delegate::kConstantAlways);
+
+        theStages[i] = &theDrivers[i];
+    }
+
+    nl::Fsm::Pipeline thePipeline(theStages, kPipelineStages);
+
+    if (!thePipeline.SetQueues(theQueues, kPipelineStages + 1, sEvents, sizeof (sEvents) / sizeof (sEvents[0]))) {
+        fprintf(stderr, "%s: failed to set pipeline queues\n", sProgram);
+        return (false);
+    }
+
+    theStart = Now();
+
+    // Stage 0 is fed by this thread, which also drains the last
+    // queue, so pin the stages from the next processor on.
+
+    for (size_t i = 0; i < kPipelineStages; i++) {
+        theContexts[i].mPipeline  = &thePipeline;
+        theContexts[i].mStage     = i;
+        theContexts[i].mExpected  = inEvents >> i;
+        theContexts[i].mProcessor = (theProcessors > 1) ? static_cast<long>((i + 1) % theProcessors) : -1;
+
+        status = pthread_create(&theThreads[i], NULL, PipelineWorker, &theContexts[i]);
+
+        // Stages already started would wait forever on the missing
+        // one, so give up altogether.
+
+        if (status != 0) {
+            fprintf(stderr, "%s: failed to create pipeline thread: %s\n", sProgram, strerror(status));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    while (((thePushed < inEvents) || (thePopped < theExpected))) {
+        theProgress = false;
+
+        if ((thePushed < inEvents) && thePipeline.Push(0)) {
+            thePushed++;
+            theProgress = true;
+        }
+
+        if (thePipeline.Pop(theOutput)) {
+            if (theOutput != 0)
+                theWrong++;
+
+            thePopped++;
+            theProgress = true;
+        }
+
+        if (!theProgress)
+            sched_yield();
+    }
+
+    for (size_t i = 0; i < kPipelineStages; i++)
+        pthread_join(theThreads[i], NULL);
+
+    theElapsed = Now() - theStart;
+
+    // Nothing more should emerge than was expected.
+
+    while (thePipeline.Pop(theOutput))
+        thePopped++;
+
+    printf("%s: %lu events through %u pipeline stages in %.3f s, %.0f events/s\n",
+           sProgram, inEvents, kPipelineStages, theElapsed,
+           (theElapsed > 0) ? (inEvents / theElapsed) : 0.0);
+
+    if ((thePopped != theExpected) || (theWrong != 0)) {
+        printf("%s: pipeline emitted %lu events (%lu wrong), expected %lu\n",
+               sProgram, thePopped, theWrong, theExpected);
+
+        return (false);
+    }
+
+    return (true);
+}
+
+static void Usage(FILE *inStream)
+{
+    fprintf(inStream,
+            "Usage: %s [ -h ] [ -q ] [ -r <runs> ] [ -e <events> ] [ -t <threads> ] [ -s <seed> ]\n"
+            "\n"
+            "  -h            Display this help and exit.\n"
+            "  -q            Do not log individual invariant violations.\n"
+            "  -r <runs>     Number of machine/driver runs (default %u).\n"
+            "  -e <events>   Number of events fired per run (default %u).\n"
+            "  -t <threads>  Number of worker threads (default %u).\n"
+            "  -s <seed>     Seed of the first run (default %u). To replay a\n"
+            "                failing run, pass its reported seed with '-r 1'.\n",
+            sProgram, kDefaultRuns, kDefaultEvents, kDefaultThreads, kDefaultSeed);
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t     theThreads[kMaxThreads];
+    unsigned long theThreadCount = kDefaultThreads;
+    Campaign      theCampaign;
+    double        theStart;
+    double        theElapsed;
+    unsigned long theTotal;
+    int           theOption;
+    int           status = 0;
+
+    memset(&theCampaign, 0, sizeof (theCampaign));
+
+    theCampaign.mRuns    = kDefaultRuns;
+    theCampaign.mEvents  = kDefaultEvents;
+    theCampaign.mSeed    = kDefaultSeed;
+    theCampaign.mVerbose = true;
+
+    while ((theOption = getopt(argc, argv, "he:qr:s:t:")) != -1) {
+        switch (theOption) {
+
+        case 'h':
+            Usage(stdout);
+            return (EXIT_SUCCESS);
+
+        case 'e':
+            theCampaign.mEvents = strtoul(optarg, NULL, 0);
+            break;
+
+        case 'q':
+            theCampaign.mVerbose = false;
+            break;
+
+        case 'r':
+            theCampaign.mRuns = strtoul(optarg, NULL, 0);
+            break;
+
+        case 's':
+            theCampaign.mSeed = strtoul(optarg, NULL, 0);
+            break;
+
+        case 't':
+            theThreadCount = strtoul(optarg, NULL, 0);
+            break;
+
+        default:
+            Usage(stderr);
+            return (EXIT_FAILURE);
+
+        }
+    }
+
+    if ((theThreadCount == 0) || (theThreadCount > kMaxThreads)) {
+        fprintf(stderr, "%s: thread count must be in the range [1, %u]\n", sProgram, kMaxThreads);
+        return (EXIT_FAILURE);
+    }
+
+    theCampaign.mFirstFailingSeed = ~0UL;
+
+    theStart = Now();
+
+    for (unsigned long i = 0; i < theThreadCount; i++) {
+        status = pthread_create(&theThreads[i], NULL, Worker, &theCampaign);
+
+        if (status != 0) {
+            fprintf(stderr, "%s: failed to create thread: %s\n", sProgram, strerror(status));
+            theThreadCount = i;
+            break;
+        }
+    }
+
+    for (unsigned long i = 0; i < theThreadCount; i++)
+        pthread_join(theThreads[i], NULL);
+
+    theElapsed = Now() - theStart;
+    theTotal   = theCampaign.mHandled + theCampaign.mRejected + theCampaign.mVetoed;
+
+    printf("%s: %lu runs x %lu events on %lu threads in %.3f s\n",
+           sProgram, theCampaign.mRuns, theCampaign.mEvents, theThreadCount, theElapsed);
+    printf("%s: %lu events (%lu handled, %lu rejected, %lu vetoed), %.0f events/s\n",
+           sProgram, theTotal, theCampaign.mHandled, theCampaign.mRejected, theCampaign.mVetoed,
+           (theElapsed > 0) ? (theTotal / theElapsed) : 0.0);
+
+    if (theCampaign.mFailures != 0) {
+        printf("%s: %lu failing runs; replay the first with '-s %lu -r 1'\n",
+               sProgram, theCampaign.mFailures, theCampaign.mFirstFailingSeed);
+
+        status = EXIT_FAILURE;
+    }
+
+    if (!RunPipeline(theCampaign.mEvents * kPipelineScale))
+        status = EXIT_FAILURE;
+
+    return ((status == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -57,6 +57,14 @@
 #include <limits.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
 
 #include <nestlabs/fsm/nlfsm.hpp>
 
@@ -383,6 +391,223 @@ static void TestMachine(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == stateB);
 }
 
+static void TestLookups(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition duplicates[] = {
+        { kStateA, kEventStay,    kStateA },
+        { kStateA, kEventForward, kStateB },
+        { kStateA, kEventStay,    kStateC },
+        { kStateB, kEventStay,    kStateB },
+        { kStateA, kEventForward, kStateD }
+    };
+    nl::Fsm::Machine::Offset dense[kStateLast + 1][kEventLast + 1];
+    nl::Fsm::Machine::SortedEntry sorted[ARRAY_SIZE(duplicates)];
+    nl::Fsm::Machine::SortedEntry eytzinger[ARRAY_SIZE(duplicates) + 1];
+    nl::Fsm::Machine::Offset hash[ARRAY_SIZE(duplicates) + 4];
+
+    GetTransitions(first, size);
+
+    nl::Fsm::Machine machine1(first, size, stateA);
+    nl::Fsm::Machine machine2(first, size, stateA);
+    nl::Fsm::Machine machine3(first, size, stateA);
+    nl::Fsm::Machine machine4(first, size, stateA);
+    nl::Fsm::Machine machine5(first, size, stateA);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetLookup() == nl::Fsm::Machine::kLookupLinear);
+
+    // Test index construction
+
+    NL_TEST_ASSERT(inSuite, machine2.GetDenseIndexSize() == ((kStateC + 1) * (kEventLast + 1)));
+    NL_TEST_ASSERT(inSuite, machine2.SetDenseLookup(&dense[0][0], 1) == false);
+    NL_TEST_ASSERT(inSuite, machine2.GetLookup() == nl::Fsm::Machine::kLookupLinear);
+    NL_TEST_ASSERT(inSuite, machine2.SetDenseLookup(&dense[0][0], ARRAY_SIZE(dense) * ARRAY_SIZE(dense[0])) == true);
+    NL_TEST_ASSERT(inSuite, machine2.GetLookup() == nl::Fsm::Machine::kLookupDense);
+
+    nl::Fsm::Machine::SortedEntry sortedAll[15];
+
+    NL_TEST_ASSERT(inSuite, machine3.GetSortedIndexSize() == size);
+    NL_TEST_ASSERT(inSuite, machine3.SetSortedLookup(sortedAll, ARRAY_SIZE(sortedAll)) == true);
+    NL_TEST_ASSERT(inSuite, machine3.GetLookup() == nl::Fsm::Machine::kLookupSorted);
+
+    nl::Fsm::Machine::SortedEntry eytzingerAll[16];
+    nl::Fsm::Machine::SortedEntry scratch[15];
+
+    NL_TEST_ASSERT(inSuite, machine4.GetEytzingerIndexSize() == (size + 1));
+    NL_TEST_ASSERT(inSuite, machine4.SetEytzingerLookup(eytzingerAll, size, scratch, ARRAY_SIZE(scratch)) == false);
+    NL_TEST_ASSERT(inSuite, machine4.SetEytzingerLookup(eytzingerAll, ARRAY_SIZE(eytzingerAll), scratch, size - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine4.GetLookup() == nl::Fsm::Machine::kLookupLinear);
+    NL_TEST_ASSERT(inSuite, machine4.SetEytzingerLookup(eytzingerAll, ARRAY_SIZE(eytzingerAll), scratch, ARRAY_SIZE(scratch)) == true);
+    NL_TEST_ASSERT(inSuite, machine4.GetLookup() == nl::Fsm::Machine::kLookupEytzinger);
+
+    nl::Fsm::Machine::Offset hashAll[23];
+
+    NL_TEST_ASSERT(inSuite, machine5.GetHashIndexSize() == ARRAY_SIZE(hashAll));
+    NL_TEST_ASSERT(inSuite, machine5.SetHashLookup(hashAll, size, scratch, ARRAY_SIZE(scratch)) == false);
+    NL_TEST_ASSERT(inSuite, machine5.GetLookup() == nl::Fsm::Machine::kLookupLinear);
+    NL_TEST_ASSERT(inSuite, machine5.SetHashLookup(hashAll, ARRAY_SIZE(hashAll), scratch, ARRAY_SIZE(scratch)) == true);
+    NL_TEST_ASSERT(inSuite, machine5.GetLookup() == nl::Fsm::Machine::kLookupHash);
+
+    // Test that all strategies find the same transitions.
+
+    for (int state = kStateFirst; state <= kStateLast + 1; state++) {
+        for (int event = kEventFirst; event <= kEventLast + 1; event++) {
+            const nl::Fsm::Transition *transition = machine1.FindTransition(state, event);
+
+            NL_TEST_ASSERT(inSuite, machine2.FindTransition(state, event) == transition);
+            NL_TEST_ASSERT(inSuite, machine3.FindTransition(state, event) == transition);
+            NL_TEST_ASSERT(inSuite, machine4.FindTransition(state, event) == transition);
+            NL_TEST_ASSERT(inSuite, machine5.FindTransition(state, event) == transition);
+        }
+    }
+
+    // Test that all strategies preserve first-match semantics for
+    // duplicate state and event pairs.
+
+    machine1.SetTransitions(duplicates, ARRAY_SIZE(duplicates), stateA);
+    machine2.SetTransitions(duplicates, ARRAY_SIZE(duplicates), stateA);
+    machine3.SetTransitions(duplicates, ARRAY_SIZE(duplicates), stateA);
+    machine4.SetTransitions(duplicates, ARRAY_SIZE(duplicates), stateA);
+    machine5.SetTransitions(duplicates, ARRAY_SIZE(duplicates), stateA);
+
+    NL_TEST_ASSERT(inSuite, machine2.GetLookup() == nl::Fsm::Machine::kLookupLinear);
+    NL_TEST_ASSERT(inSuite, machine2.SetDenseLookup(&dense[0][0], ARRAY_SIZE(dense) * ARRAY_SIZE(dense[0])) == true);
+    NL_TEST_ASSERT(inSuite, machine3.SetSortedLookup(sorted, ARRAY_SIZE(sorted)) == true);
+    NL_TEST_ASSERT(inSuite, machine4.SetEytzingerLookup(eytzinger, ARRAY_SIZE(eytzinger), sorted, ARRAY_SIZE(sorted)) == true);
+    NL_TEST_ASSERT(inSuite, machine5.SetHashLookup(hash, ARRAY_SIZE(hash), sorted, ARRAY_SIZE(sorted)) == true);
+
+    nl::Fsm::Machine * const machines[] = { &machine1, &machine2, &machine3, &machine4, &machine5 };
+
+    for (size_t i = 0; i < ARRAY_SIZE(machines); i++) {
+        nl::Fsm::Machine &machine = *machines[i];
+
+        NL_TEST_ASSERT(inSuite, machine.FindTransition(kStateA, kEventStay) == &duplicates[0]);
+        NL_TEST_ASSERT(inSuite, machine.FindTransition(kStateA, kEventForward) == &duplicates[1]);
+        NL_TEST_ASSERT(inSuite, machine.FindTransition(kStateB, kEventStay) == &duplicates[3]);
+        NL_TEST_ASSERT(inSuite, machine.FindTransition(kStateB, kEventForward) == NULL);
+        NL_TEST_ASSERT(inSuite, machine.FindTransition(kStateD, kEventStay) == NULL);
+    }
+
+    machine3.SetLinearLookup();
+
+    NL_TEST_ASSERT(inSuite, machine3.GetLookup() == nl::Fsm::Machine::kLookupLinear);
+    NL_TEST_ASSERT(inSuite, machine3.FindTransition(kStateA, kEventStay) == &duplicates[0]);
+}
+
+static void TestWideMachine(nlTestSuite *inSuite, void *inContext)
+{
+    typedef nl::Fsm::BasicMachine<uint16_t, uint16_t>      Machine;
+    typedef nl::Fsm::BasicDriver<uint16_t, uint16_t>       Driver;
+    typedef nl::Fsm::Delegate::BasicAlways<uint16_t, uint16_t> Always;
+
+    enum {
+        kStates = 1000,
+        kEvents = 300
+    };
+
+    // A ring of 1000 states, each advancing on its own event and
+    // resetting to the first state on a common, wide event.
+
+    static Machine::Transition transitions[2 * kStates];
+    static Machine::SortedEntry sorted[2 * kStates];
+    static Machine::SortedEntry eytzinger[(2 * kStates) + 1];
+    static Machine::Offset hash[3 * kStates];
+    Always always;
+    size_t i;
+
+    for (i = 0; i < kStates; i++) {
+        transitions[(2 * i) + 0].mStart = static_cast<uint16_t>(i);
+        transitions[(2 * i) + 0].mEvent = static_cast<uint16_t>(i % (kEvents - 1));
+        transitions[(2 * i) + 0].mEnd   = static_cast<uint16_t>((i + 1) % kStates);
+        transitions[(2 * i) + 1].mStart = static_cast<uint16_t>(i);
+        transitions[(2 * i) + 1].mEvent = kEvents - 1;
+        transitions[(2 * i) + 1].mEnd   = 0;
+    }
+
+    Machine machine1(transitions, ARRAY_SIZE(transitions), 0);
+    Machine machine2(transitions, ARRAY_SIZE(transitions), 0);
+    Machine machine3(transitions, ARRAY_SIZE(transitions), 0);
+    Machine machine4(transitions, ARRAY_SIZE(transitions), 0);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetDenseIndexSize() == (kStates * kEvents));
+    NL_TEST_ASSERT(inSuite, machine3.SetEytzingerLookup(eytzinger, ARRAY_SIZE(eytzinger), sorted, ARRAY_SIZE(sorted)) == true);
+    NL_TEST_ASSERT(inSuite, machine4.GetHashIndexSize() == ARRAY_SIZE(hash));
+    NL_TEST_ASSERT(inSuite, machine4.SetHashLookup(hash, ARRAY_SIZE(hash), sorted, ARRAY_SIZE(sorted)) == true);
+    NL_TEST_ASSERT(inSuite, machine2.SetSortedLookup(sorted, ARRAY_SIZE(sorted)) == true);
+
+    for (i = 0; i < kStates; i++) {
+        const uint16_t event = static_cast<uint16_t>(i % (kEvents - 1));
+
+        NL_TEST_ASSERT(inSuite, machine1.FindTransition(i, event) == &transitions[2 * i]);
+        NL_TEST_ASSERT(inSuite, machine2.FindTransition(i, event) == &transitions[2 * i]);
+        NL_TEST_ASSERT(inSuite, machine2.FindTransition(i, kEvents - 1) == &transitions[(2 * i) + 1]);
+        NL_TEST_ASSERT(inSuite, machine2.FindTransition(i, kEvents) == NULL);
+        NL_TEST_ASSERT(inSuite, machine3.FindTransition(i, event) == &transitions[2 * i]);
+        NL_TEST_ASSERT(inSuite, machine3.FindTransition(i, kEvents - 1) == &transitions[(2 * i) + 1]);
+        NL_TEST_ASSERT(inSuite, machine3.FindTransition(i, kEvents) == NULL);
+        NL_TEST_ASSERT(inSuite, machine4.FindTransition(i, event) == &transitions[2 * i]);
+        NL_TEST_ASSERT(inSuite, machine4.FindTransition(i, kEvents - 1) == &transitions[(2 * i) + 1]);
+        NL_TEST_ASSERT(inSuite, machine4.FindTransition(i, kEvents) == NULL);
+    }
+
+    // Drive the machine all the way around the ring and back.
+
+    Driver driver(machine2, &always);
+
+    for (i = 0; i < kStates; i++) {
+        NL_TEST_ASSERT(inSuite, driver.HandleEvent(static_cast<uint16_t>(i % (kEvents - 1))) == true);
+    }
+
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == 0);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(0) == true);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == 1);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEvents - 1) == true);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == 0);
+}
+
+static void TestHashSizes(nlTestSuite *inSuite, void *inContext)
+{
+    enum {
+        kEvents = 16,
+        kSizes  = 256
+    };
+
+    // Build the perfect hash index of every prefix of a grid of states
+    // by 16 events, such that buckets of several keys are placed late
+    // into a nearly full index, and check every lookup.
+
+    nl::Fsm::Transition transitions[kSizes];
+    nl::Fsm::Machine::SortedEntry scratch[kSizes];
+    nl::Fsm::Machine::Offset hash[2 * kSizes];
+    nl::Fsm::Machine machine;
+    size_t i, n;
+
+    for (i = 0; i < kSizes; i++) {
+        transitions[i].mStart = static_cast<nl::Fsm::State>(i / kEvents);
+        transitions[i].mEvent = static_cast<nl::Fsm::Event>(i % kEvents);
+        transitions[i].mEnd   = static_cast<nl::Fsm::State>((i / kEvents) + 1);
+    }
+
+    for (n = 1; n <= kSizes; n++) {
+        bool found = true;
+
+        machine.SetTransitions(transitions, n, transitions[0].mStart);
+
+        NL_TEST_ASSERT(inSuite, machine.GetHashIndexSize() <= ARRAY_SIZE(hash));
+        NL_TEST_ASSERT(inSuite, machine.SetHashLookup(hash, ARRAY_SIZE(hash), scratch, ARRAY_SIZE(scratch)) == true);
+        NL_TEST_ASSERT(inSuite, machine.GetLookup() == nl::Fsm::Machine::kLookupHash);
+
+        for (i = 0; i < n; i++)
+            found = (machine.FindTransition(transitions[i].mStart, transitions[i].mEvent) == &transitions[i]) && found;
+
+        NL_TEST_ASSERT(inSuite, found);
+        NL_TEST_ASSERT(inSuite, machine.FindTransition(kSizes / kEvents, 0) == NULL);
+    }
+}
+
 static void TestDelegate(nlTestSuite *inSuite, nl::Fsm::Delegate::Base &inDelegate, bool (nl::Fsm::Delegate::Base::*inMethod)(const nl::Fsm::Event &inEvent,
                                                                                                                               const nl::Fsm::State &inState), size_t inIterations, bool inExpect)
 {
@@ -460,6 +685,60 @@ static void TestDelegates(nlTestSuite *inSuite, void *inContext)
     TestDelegate(inSuite, random1, 100, false);
 }
 
+static void TestRandomDelegate(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Event eventStay(kEventStay);
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition transitionA_Stay = {stateA, eventStay, stateA};
+    nl::Fsm::Delegate::Random random1(0x235A);
+    nl::Fsm::Delegate::Random random2(0x235A);
+    nl::Fsm::Delegate::Random random3(0x235A);
+    nl::Fsm::Delegate::Random random4(0x5A23);
+    size_t differences = 0;
+    size_t i;
+
+    // Test that identically-seeded instances produce identical
+    // sequences, independent of other instances being constructed
+    // or used in between.
+
+    for (i = 0; i < 1000; i++) {
+        const bool status1 = random1.WillHandleEvent(eventStay, stateA);
+
+        random4.WillHandleEvent(eventStay, stateA);
+
+        NL_TEST_ASSERT(inSuite, status1 == random2.WillHandleEvent(eventStay, stateA));
+    }
+
+    // Test that differently-seeded instances diverge.
+
+    random3.Seed(0x5A23);
+
+    for (i = 0; i < 1000; i++) {
+        if (random1.DidHandleEvent(eventStay, stateA) != random3.DidHandleEvent(eventStay, stateA))
+            differences++;
+    }
+
+    NL_TEST_ASSERT(inSuite, differences != 0);
+
+    // Test per-method veto probabilities.
+
+    random1.SetVetoProbability(0.0);
+    random1.SetVetoProbability(nl::Fsm::Delegate::Random::kHookWillEnterState, 1.0);
+
+    NL_TEST_ASSERT(inSuite, random1.GetVetoProbability(nl::Fsm::Delegate::Random::kHookWillExitState) == 0.0);
+    NL_TEST_ASSERT(inSuite, random1.GetVetoProbability(nl::Fsm::Delegate::Random::kHookWillEnterState) == 1.0);
+
+    for (i = 0; i < 1000; i++) {
+        NL_TEST_ASSERT(inSuite, random1.WillExitState(eventStay, transitionA_Stay) == true);
+        NL_TEST_ASSERT(inSuite, random1.WillEnterState(eventStay, transitionA_Stay) == false);
+    }
+
+    random1.SetVetoProbability(nl::Fsm::Delegate::Random::kHookWillEnterState, 0.5);
+
+    TestDelegate(inSuite, random1, &nl::Fsm::Delegate::Base::WillEnterState, 100, true);
+    TestDelegate(inSuite, random1, &nl::Fsm::Delegate::Base::WillEnterState, 100, false);
+}
+
 static void TestDriver(nlTestSuite *inSuite, void *inContext)
 {
     const nl::Fsm::Transition * first = 0;
@@ -531,13 +810,2824 @@ static void TestDriver(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateD);
 }
 
+static void TestConstantDriver(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    nl::Fsm::Delegate::Always always;
+
+    GetTransitions(first, size);
+
+    nl::Fsm::Machine machine1(first, size, stateA);
+    nl::Fsm::Machine machine2(first, size, stateA);
+
+    // Test construction
+
+    nl::Fsm::Driver driver1(machine1, nl::Fsm::Delegate::kConstantAlways);
+    nl::Fsm::Driver driver2(machine1, nl::Fsm::Delegate::kConstantNever);
+    nl::Fsm::Driver driver3(machine2, &always);
+
+    NL_TEST_ASSERT(inSuite, driver1.GetDelegate() == NULL);
+    NL_TEST_ASSERT(inSuite, driver2.GetDelegate() == NULL);
+
+    // Test that a constant-result driver tracks an equivalent
+    // delegate-driven one event for event.
+
+    const nl::Fsm::Event events[] = {
+        kEventStay, kEventForward, kEventBackward, kEventSkip,
+        kEventForward, kEventForward, kEventError, kEventStay
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(events); i++) {
+        const nl::Fsm::State before = machine1.GetCurrentState();
+
+        NL_TEST_ASSERT(inSuite, driver2.HandleEvent(events[i]) == false);
+        NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == before);
+
+        NL_TEST_ASSERT(inSuite, driver1.HandleEvent(events[i]) == driver3.HandleEvent(events[i]));
+        NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == machine2.GetCurrentState());
+    }
+
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateD);
+
+    // Test switching between delegate objects and tags.
+
+    driver1.SetDelegate(&always);
+
+    NL_TEST_ASSERT(inSuite, driver1.GetDelegate() == &always);
+
+    driver1.SetDelegate(nl::Fsm::Delegate::kConstantNever);
+
+    NL_TEST_ASSERT(inSuite, driver1.GetDelegate() == NULL);
+
+    machine1.SetCurrentState(stateA);
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == false);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+}
+
+class CountingDelegate : public nl::Fsm::Delegate::Always
+{
+public:
+    CountingDelegate(void) :
+        mCalls(0),
+        mExits(0),
+        mTransitions(0),
+        mEntries(0)
+    {
+        return;
+    }
+
+    virtual bool WillHandleEvent(const nl::Fsm::Event &inEvent,
+                                 const nl::Fsm::State &inState)
+    {
+        mCalls++;
+
+        return (nl::Fsm::Delegate::Always::WillHandleEvent(inEvent, inState));
+    }
+
+    virtual bool WillExitState(const nl::Fsm::Event &inEvent,
+                               const nl::Fsm::Transition &inTransition)
+    {
+        mExits++;
+
+        return (nl::Fsm::Delegate::Always::WillExitState(inEvent, inTransition));
+    }
+
+    virtual bool WillTransition(const nl::Fsm::Event &inEvent,
+                                const nl::Fsm::Transition &inTransition)
+    {
+        mTransitions++;
+
+        return (nl::Fsm::Delegate::Always::WillTransition(inEvent, inTransition));
+    }
+
+    virtual bool DidEnterState(const nl::Fsm::Event &inEvent,
+                               const nl::Fsm::Transition &inTransition)
+    {
+        mEntries++;
+
+        return (nl::Fsm::Delegate::Always::DidEnterState(inEvent, inTransition));
+    }
+
+    size_t mCalls;
+    size_t mExits;
+    size_t mTransitions;
+    size_t mEntries;
+};
+
+static void TestInternalTransitions(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    nl::Fsm::Machine::Mask flags[1];
+    CountingDelegate delegate;
+
+    GetTransitions(first, size);
+
+    nl::Fsm::Machine machine1(first, size, stateA);
+    nl::Fsm::Driver driver(machine1, &delegate);
+
+    // Test that self-loops are external by default.
+
+    NL_TEST_ASSERT(inSuite, machine1.GetSelfLoopPolicy() == nl::Fsm::Machine::kSelfLoopExternal);
+    NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(first[0]) == false);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mTransitions == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 1);
+
+    // Test that an internal self-loop makes only the transition.
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopInternal);
+
+    NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(first[0]) == true);
+    NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(first[1]) == false);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mTransitions == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 2);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    // Test that flags make individual self-loops internal and are
+    // ignored on transitions to another state.
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopExternal);
+
+    flags[0] = (1U << 5) | (1U << 6);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetInternalTransitionsSize() == ARRAY_SIZE(flags));
+    NL_TEST_ASSERT(inSuite, machine1.SetInternalTransitions(NULL, ARRAY_SIZE(flags)) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetInternalTransitions(flags, 0) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetInternalTransitions(flags, ARRAY_SIZE(flags)) == true);
+
+    NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(first[0]) == false);
+    NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(first[5]) == true);
+    NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(first[6]) == false);
+
+    {
+        const nl::Fsm::Transition copy = first[5];
+
+        NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(copy) == false);
+    }
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mTransitions == 4);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 2);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 3);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 3);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateC);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 4);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 4);
+
+    // Test that resetting the table discards the flags but keeps the
+    // policy.
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopInternal);
+    machine1.SetTransitions(first, size, stateA);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetSelfLoopPolicy() == nl::Fsm::Machine::kSelfLoopInternal);
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopExternal);
+
+    NL_TEST_ASSERT(inSuite, machine1.IsInternalTransition(first[5]) == false);
+}
+
+struct ActionContext
+{
+    const CountingDelegate * mDelegate;
+    size_t                   mCalls;
+    size_t                   mTransitions;
+};
+
+static bool CountingAction(const nl::Fsm::Event &inEvent,
+                           const nl::Fsm::Transition &inTransition,
+                           void *inContext)
+{
+    ActionContext * context = static_cast<ActionContext *>(inContext);
+
+    context->mCalls++;
+
+    if (context->mDelegate != NULL)
+        context->mTransitions = context->mDelegate->mTransitions;
+
+    return (true);
+}
+
+static bool VetoingAction(const nl::Fsm::Event &inEvent,
+                          const nl::Fsm::Transition &inTransition,
+                          void *inContext)
+{
+    ActionContext * context = static_cast<ActionContext *>(inContext);
+
+    context->mCalls++;
+
+    return (false);
+}
+
+static void TestActions(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    nl::Fsm::Machine::Action actions[15];
+    ActionContext context1 = { NULL, 0, 0 };
+    ActionContext context2 = { NULL, 0, 0 };
+    CountingDelegate delegate;
+
+    GetTransitions(first, size);
+
+    memset(actions, 0, sizeof(actions));
+
+    actions[1].mFunction = CountingAction;
+    actions[1].mContext  = &context1;
+    actions[6].mFunction = VetoingAction;
+    actions[6].mContext  = &context2;
+    actions[7].mFunction = CountingAction;
+    actions[7].mContext  = &context1;
+
+    nl::Fsm::Machine machine1(first, size, stateA);
+    nl::Fsm::Driver driver1(machine1, nl::Fsm::Delegate::kConstantAlways);
+    nl::Fsm::Driver driver2(machine1, &delegate);
+
+    // Test that actions must cover the whole table.
+
+    NL_TEST_ASSERT(inSuite, machine1.HasActions() == false);
+    NL_TEST_ASSERT(inSuite, machine1.GetAction(first[1]) == NULL);
+    NL_TEST_ASSERT(inSuite, machine1.SetActions(NULL, ARRAY_SIZE(actions)) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetActions(actions, size - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetActions(actions, ARRAY_SIZE(actions)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.HasActions() == true);
+
+    // Test that only table transitions with a function have an
+    // action.
+
+    NL_TEST_ASSERT(inSuite, machine1.GetAction(first[0]) == NULL);
+    NL_TEST_ASSERT(inSuite, machine1.GetAction(first[1]) == &actions[1]);
+
+    {
+        const nl::Fsm::Transition copy = first[1];
+
+        NL_TEST_ASSERT(inSuite, machine1.GetAction(copy) == NULL);
+    }
+
+    // Test that a constant-result driver calls the action, with its
+    // context, and only the action.
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, context1.mCalls == 0);
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, context1.mCalls == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    // Test that an action returning false vetoes the transition.
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == false);
+    NL_TEST_ASSERT(inSuite, context2.mCalls == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventForward) == false);
+    NL_TEST_ASSERT(inSuite, context2.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mTransitions == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 0);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    // Test that a delegate-driven driver calls the action after the
+    // delegate's WillTransition method.
+
+    context1.mDelegate = &delegate;
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, context1.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, context1.mTransitions == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+
+    // Test that resetting the table discards the actions.
+
+    machine1.SetTransitions(first, size, stateA);
+
+    NL_TEST_ASSERT(inSuite, machine1.HasActions() == false);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, context1.mCalls == 2);
+
+    // Test that actions may be cleared.
+
+    NL_TEST_ASSERT(inSuite, machine1.SetActions(actions, ARRAY_SIZE(actions)) == true);
+
+    machine1.ClearActions();
+
+    NL_TEST_ASSERT(inSuite, machine1.HasActions() == false);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, context2.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateC);
+}
+
+static void TestStateHandlers(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    nl::Fsm::Machine::Action onEnter[4];
+    nl::Fsm::Machine::Action onExit[4];
+    ActionContext entries = { NULL, 0, 0 };
+    ActionContext exits = { NULL, 0, 0 };
+    ActionContext vetoes = { NULL, 0, 0 };
+    CountingDelegate delegate;
+
+    GetTransitions(first, size);
+
+    memset(onEnter, 0, sizeof(onEnter));
+    memset(onExit, 0, sizeof(onExit));
+
+    onEnter[kStateB].mFunction = CountingAction;
+    onEnter[kStateB].mContext  = &entries;
+    onEnter[kStateD].mFunction = VetoingAction;
+    onEnter[kStateD].mContext  = &vetoes;
+    onExit[kStateA].mFunction  = CountingAction;
+    onExit[kStateA].mContext   = &exits;
+
+    nl::Fsm::Machine machine1(first, size, stateA);
+    nl::Fsm::Driver driver1(machine1, nl::Fsm::Delegate::kConstantAlways);
+    nl::Fsm::Driver driver2(machine1, &delegate);
+
+    // Test that handlers must cover every state.
+
+    NL_TEST_ASSERT(inSuite, machine1.GetStateHandlersSize() == ARRAY_SIZE(onEnter));
+    NL_TEST_ASSERT(inSuite, machine1.HasStateHandlers() == false);
+    NL_TEST_ASSERT(inSuite, machine1.GetExitHandler(kStateA) == NULL);
+    NL_TEST_ASSERT(inSuite, machine1.SetStateHandlers(NULL, NULL, ARRAY_SIZE(onEnter)) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetStateHandlers(onEnter, onExit, ARRAY_SIZE(onEnter) - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetStateHandlers(onEnter, onExit, ARRAY_SIZE(onEnter)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.HasStateHandlers() == true);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetEnterHandler(kStateA) == NULL);
+    NL_TEST_ASSERT(inSuite, machine1.GetEnterHandler(kStateB) == &onEnter[kStateB]);
+    NL_TEST_ASSERT(inSuite, machine1.GetExitHandler(kStateA) == &onExit[kStateA]);
+    NL_TEST_ASSERT(inSuite, machine1.GetExitHandler(kStateLast + 1) == NULL);
+
+    // Test that a constant-result driver calls the handlers of the
+    // states exited and entered.
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, exits.mCalls == 1);
+    NL_TEST_ASSERT(inSuite, entries.mCalls == 0);
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, exits.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, entries.mCalls == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    // Test that internal transitions call no handlers.
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopInternal);
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, entries.mCalls == 1);
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, exits.mCalls == 2);
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopExternal);
+
+    // Test that a delegate-driven driver calls the handlers between
+    // the delegate's methods.
+
+    entries.mDelegate = &delegate;
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, exits.mCalls == 3);
+    NL_TEST_ASSERT(inSuite, entries.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, entries.mTransitions == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 1);
+
+    // Test that a handler returning false aborts the event, after the
+    // state is entered.
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventError) == false);
+    NL_TEST_ASSERT(inSuite, vetoes.mCalls == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateD);
+
+    // Test that resetting the table discards the handlers.
+
+    machine1.SetTransitions(first, size, stateA);
+
+    NL_TEST_ASSERT(inSuite, machine1.HasStateHandlers() == false);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, exits.mCalls == 3);
+
+    // Test that either kind of handler may be omitted and that the
+    // handlers may be cleared.
+
+    NL_TEST_ASSERT(inSuite, machine1.SetStateHandlers(NULL, onExit, ARRAY_SIZE(onExit)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.GetEnterHandler(kStateB) == NULL);
+    NL_TEST_ASSERT(inSuite, machine1.GetExitHandler(kStateA) == &onExit[kStateA]);
+
+    machine1.ClearStateHandlers();
+
+    NL_TEST_ASSERT(inSuite, machine1.HasStateHandlers() == false);
+    NL_TEST_ASSERT(inSuite, machine1.GetExitHandler(kStateA) == NULL);
+}
+
+static bool FlagGuard(const nl::Fsm::Event &inEvent,
+                      const nl::Fsm::Transition &inTransition,
+                      void *inContext)
+{
+    return (*static_cast<const bool *>(inContext));
+}
+
+struct ToggleContext
+{
+    bool   mFlag;
+    size_t mCalls;
+};
+
+static bool ToggleGuard(const nl::Fsm::Event &inEvent,
+                        const nl::Fsm::Transition &inTransition,
+                        void *inContext)
+{
+    ToggleContext *theContext = static_cast<ToggleContext *>(inContext);
+    const bool     theFlag    = theContext->mFlag;
+
+    theContext->mFlag = !theContext->mFlag;
+    theContext->mCalls++;
+
+    return (theFlag);
+}
+
+static void TestGuards(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::State stateB(kStateB);
+
+    // A, Forward has three adjacent candidates, the last unguarded;
+    // B, Forward has only a guarded one; and the last A, Forward
+    // transition is not adjacent to the others, so is never taken.
+
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateA, kEventForward,  kStateC },
+        { kStateA, kEventForward,  kStateD },
+        { kStateA, kEventStay,     kStateA },
+        { kStateB, kEventBackward, kStateA },
+        { kStateB, kEventForward,  kStateC },
+        { kStateC, kEventBackward, kStateA },
+        { kStateA, kEventForward,  kStateA }
+    };
+    bool flag1 = false;
+    bool flag2 = false;
+    nl::Fsm::Machine::Guard guards[ARRAY_SIZE(transitions)];
+    nl::Fsm::Machine::SortedEntry sorted[ARRAY_SIZE(transitions)];
+    nl::Fsm::Event classes[kEventLast + 1];
+    nl::Fsm::Machine::Offset index[16];
+    nl::Fsm::Validator::Word workspace[64];
+    nl::Fsm::Validator::Word guarded[1];
+    nl::Fsm::Validator::Report report;
+    nl::Fsm::State next;
+    CountingDelegate delegate;
+
+    memset(guards, 0, sizeof(guards));
+
+    guards[0].mFunction = FlagGuard;
+    guards[0].mContext  = &flag1;
+    guards[1].mFunction = FlagGuard;
+    guards[1].mContext  = &flag2;
+    guards[5].mFunction = FlagGuard;
+    guards[5].mContext  = &flag1;
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Driver driver(machine1, &delegate);
+
+    // Test that without guards only the first candidate is found.
+
+    NL_TEST_ASSERT(inSuite, machine1.HasGuards() == false);
+    NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateA, kEventForward) == &transitions[0]);
+
+    NL_TEST_ASSERT(inSuite, machine1.SetGuards(NULL, ARRAY_SIZE(guards)) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetGuards(guards, ARRAY_SIZE(guards) - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetGuards(guards, ARRAY_SIZE(guards)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.HasGuards() == true);
+
+    // Test that the first candidate whose guard holds is found, with
+    // any lookup strategy.
+
+    for (size_t i = 0; i < 2; i++) {
+        flag1 = false;
+        flag2 = false;
+
+        NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventForward) == &transitions[0]);
+        NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateA, kEventForward) == &transitions[2]);
+        NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateB, kEventForward) == NULL);
+        NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateA, kEventStay) == &transitions[3]);
+
+        flag2 = true;
+
+        NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateA, kEventForward) == &transitions[1]);
+
+        flag1 = true;
+
+        NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateA, kEventForward) == &transitions[0]);
+        NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateB, kEventForward) == &transitions[5]);
+
+        NL_TEST_ASSERT(inSuite, machine1.SetSortedLookup(sorted, ARRAY_SIZE(sorted)) == true);
+    }
+
+    // Test that the next state honors the guards, even with event
+    // classes.
+
+    NL_TEST_ASSERT(inSuite, machine1.SetEventClasses(classes, ARRAY_SIZE(classes), index, ARRAY_SIZE(index)) == true);
+
+    flag1 = false;
+    flag2 = true;
+
+    NL_TEST_ASSERT(inSuite, machine1.FindNextState(kStateA, kEventForward, next) == true);
+    NL_TEST_ASSERT(inSuite, next == kStateC);
+    NL_TEST_ASSERT(inSuite, machine1.FindNextState(kStateB, kEventForward, next) == false);
+
+    // Test that a driver evaluates the guards before any delegate
+    // method.
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateC);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateC);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 3);
+
+    machine1.SetCurrentState(stateB);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == false);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 3);
+    NL_TEST_ASSERT(inSuite, delegate.mExits == 3);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    // Test that resetting the table discards the guards.
+
+    machine1.SetTransitions(transitions, ARRAY_SIZE(transitions), stateA);
+
+    NL_TEST_ASSERT(inSuite, machine1.HasGuards() == false);
+    NL_TEST_ASSERT(inSuite, machine1.FindEnabledTransition(kStateB, kEventForward) == &transitions[5]);
+
+    // Test that a validator told of the guards reports only the
+    // candidate that is not adjacent as a duplicate.
+
+    nl::Fsm::Validator validator(workspace, ARRAY_SIZE(workspace));
+
+    NL_TEST_ASSERT(inSuite, validator.Validate(transitions, ARRAY_SIZE(transitions), kStateA, NULL, report) == true);
+    NL_TEST_ASSERT(inSuite, report.mDuplicates == 3);
+
+    guarded[0] = (1U << 0) | (1U << 1) | (1U << 5);
+
+    NL_TEST_ASSERT(inSuite, validator.SetGuardedTransitions(NULL, ARRAY_SIZE(guarded)) == false);
+    NL_TEST_ASSERT(inSuite, validator.SetGuardedTransitions(guarded, ARRAY_SIZE(guarded)) == true);
+    NL_TEST_ASSERT(inSuite, validator.Validate(transitions, ARRAY_SIZE(transitions), kStateA, NULL, report) == true);
+    NL_TEST_ASSERT(inSuite, report.mDuplicates == 1);
+    NL_TEST_ASSERT(inSuite, report.mUnreachable == 0);
+    NL_TEST_ASSERT(inSuite, report.mDead == 1);
+
+    validator.ClearGuardedTransitions();
+
+    NL_TEST_ASSERT(inSuite, validator.Validate(transitions, ARRAY_SIZE(transitions), kStateA, NULL, report) == true);
+    NL_TEST_ASSERT(inSuite, report.mDuplicates == 3);
+
+    // Test that a constant true driver evaluates the guards of a
+    // guarded internal self-loop only once, and stays in the state
+    // without a change of epoch if the self-loop is taken.
+
+    {
+        const nl::Fsm::Transition loops[] = {
+            { kStateA, kEventStay,     kStateA },
+            { kStateA, kEventStay,     kStateC }
+        };
+        const nl::Fsm::Machine::Mask internal[1] = { 1U << 0 };
+        ToggleContext toggle = { true, 0 };
+        nl::Fsm::Machine::Guard toggles[ARRAY_SIZE(loops)];
+        nl::Fsm::Machine::Epoch epoch;
+
+        memset(toggles, 0, sizeof(toggles));
+
+        toggles[0].mFunction = ToggleGuard;
+        toggles[0].mContext  = &toggle;
+
+        nl::Fsm::Machine machine2(loops, ARRAY_SIZE(loops), stateA);
+        nl::Fsm::Driver driver2(machine2, nl::Fsm::Delegate::kConstantAlways);
+
+        NL_TEST_ASSERT(inSuite, machine2.SetInternalTransitions(internal, ARRAY_SIZE(internal)) == true);
+        NL_TEST_ASSERT(inSuite, machine2.SetGuards(toggles, ARRAY_SIZE(toggles)) == true);
+
+        epoch = machine2.GetStateEpoch();
+
+        NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventStay) == true);
+        NL_TEST_ASSERT(inSuite, toggle.mCalls == 1);
+        NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateA);
+        NL_TEST_ASSERT(inSuite, machine2.GetStateEpoch() == epoch);
+
+        NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventStay) == true);
+        NL_TEST_ASSERT(inSuite, toggle.mCalls == 2);
+        NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateC);
+    }
+}
+
+struct Trace
+{
+    char   mBuffer[32];
+    size_t mLength;
+};
+
+struct TraceStep
+{
+    Trace * mTrace;
+    char    mSign;
+    char    mName;
+};
+
+static bool TracingHandler(const nl::Fsm::Event &inEvent,
+                           const nl::Fsm::Transition &inTransition,
+                           void *inContext)
+{
+    const TraceStep * step = static_cast<const TraceStep *>(inContext);
+    Trace * trace = step->mTrace;
+
+    if ((trace->mLength + 2) < sizeof (trace->mBuffer)) {
+        trace->mBuffer[trace->mLength++] = step->mSign;
+        trace->mBuffer[trace->mLength++] = step->mName;
+        trace->mBuffer[trace->mLength]   = '\0';
+    }
+
+    return (true);
+}
+
+static bool IsTrace(Trace &ioTrace, const char *inExpected)
+{
+    const bool retval = (strcmp(ioTrace.mBuffer, inExpected) == 0);
+
+    ioTrace.mLength    = 0;
+    ioTrace.mBuffer[0] = '\0';
+
+    return (retval);
+}
+
+static void TestHierarchy(nlTestSuite *inSuite, void *inContext)
+{
+    // R contains A and B; A contains A1 and A2; and B contains B1.
+
+    enum {
+        kStateR  = 0,
+        kStateA_ = 1,
+        kStateB_ = 2,
+        kStateA1 = 3,
+        kStateA2 = 4,
+        kStateB1 = 5,
+        kStates  = 6
+    };
+
+    static const char kNames[kStates] = { 'R', 'A', 'B', '1', '2', '3' };
+
+    const nl::Fsm::State parents[kStates] = {
+        kStateR, kStateR, kStateR, kStateA_, kStateA_, kStateB_
+    };
+    const nl::Fsm::State cyclic[kStates] = {
+        kStateR, kStateA1, kStateR, kStateA_, kStateA_, kStateB_
+    };
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA1, kEventForward,  kStateA2 },
+        { kStateA_, kEventSkip,     kStateB1 },
+        { kStateR,  kEventError,    kStateA1 },
+        { kStateB1, kEventStay,     kStateB1 },
+        { kStateB1, kEventBackward, kStateB_ }
+    };
+    const nl::Fsm::State stateA1(kStateA1);
+    nl::Fsm::Machine::Action onEnter[kStates];
+    nl::Fsm::Machine::Action onExit[kStates];
+    TraceStep entries[kStates];
+    TraceStep exits[kStates];
+    nl::Fsm::Hierarchy::Word workspace[32];
+    Trace trace;
+
+    trace.mLength    = 0;
+    trace.mBuffer[0] = '\0';
+
+    for (size_t i = 0; i < kStates; i++) {
+        entries[i].mTrace      = &trace;
+        entries[i].mSign       = '+';
+        entries[i].mName       = kNames[i];
+        exits[i].mTrace        = &trace;
+        exits[i].mSign         = '-';
+        exits[i].mName         = kNames[i];
+        onEnter[i].mFunction   = TracingHandler;
+        onEnter[i].mContext    = &entries[i];
+        onExit[i].mFunction    = TracingHandler;
+        onExit[i].mContext     = &exits[i];
+    }
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA1);
+
+    NL_TEST_ASSERT(inSuite, machine1.SetStateHandlers(onEnter, onExit, kStates) == true);
+
+    // Test that the parents must form a hierarchy covering the table.
+
+    nl::Fsm::Hierarchy hierarchy1(machine1, cyclic, kStates);
+    nl::Fsm::Hierarchy hierarchy2(machine1, parents, kStateA2);
+    nl::Fsm::Hierarchy hierarchy3(machine1, parents, kStates);
+
+    NL_TEST_ASSERT(inSuite, hierarchy1.GetWorkspaceSize() == 0);
+    NL_TEST_ASSERT(inSuite, hierarchy1.SetWorkspace(workspace, ARRAY_SIZE(workspace)) == false);
+    NL_TEST_ASSERT(inSuite, hierarchy2.GetWorkspaceSize() == 0);
+
+    // Depths; two words per transition; and entry paths of one, two,
+    // three, one and one states.
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.GetWorkspaceSize() == (kStates + (2 * ARRAY_SIZE(transitions)) + 8));
+    NL_TEST_ASSERT(inSuite, hierarchy3.SetWorkspace(workspace, hierarchy3.GetWorkspaceSize() - 1) == false);
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventForward) == false);
+    NL_TEST_ASSERT(inSuite, hierarchy3.SetWorkspace(workspace, ARRAY_SIZE(workspace)) == true);
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.GetDepth(kStateR) == 0);
+    NL_TEST_ASSERT(inSuite, hierarchy3.GetDepth(kStateB1) == 2);
+    NL_TEST_ASSERT(inSuite, hierarchy3.IsAncestor(kStateA_, kStateA2) == true);
+    NL_TEST_ASSERT(inSuite, hierarchy3.IsAncestor(kStateA2, kStateA2) == true);
+    NL_TEST_ASSERT(inSuite, hierarchy3.IsAncestor(kStateB_, kStateA2) == false);
+
+    // Test that events bubble up to the nearest ancestor with a
+    // transition.
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.FindTransition(kStateA2, kEventSkip) == &transitions[1]);
+    NL_TEST_ASSERT(inSuite, hierarchy3.FindTransition(kStateB1, kEventError) == &transitions[2]);
+    NL_TEST_ASSERT(inSuite, hierarchy3.FindTransition(kStateA2, kEventStay) == NULL);
+
+    // Test that transitions exit and enter the states between their
+    // states and the nearest ancestor properly containing both.
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, IsTrace(trace, "-1+2"));
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA2);
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, IsTrace(trace, "-2-A+B+3"));
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB1);
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, IsTrace(trace, "-3+3"));
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, IsTrace(trace, "-3-B+B"));
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB_);
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventError) == true);
+    NL_TEST_ASSERT(inSuite, IsTrace(trace, "-B-R+R+A+1"));
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA1);
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventStay) == false);
+    NL_TEST_ASSERT(inSuite, IsTrace(trace, ""));
+
+    // Test that internal transitions neither exit nor enter.
+
+    machine1.SetCurrentState(kStateB1);
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopInternal);
+
+    NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, IsTrace(trace, ""));
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB1);
+
+    // Test that the delegate's hooks are called around each walk, and
+    // that its veto aborts the event before any handler.
+
+    {
+        CountingDelegate counting;
+        nl::Fsm::Delegate::Never never;
+
+        machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopExternal);
+
+        hierarchy3.SetDelegate(&counting);
+
+        NL_TEST_ASSERT(inSuite, hierarchy3.GetDelegate() == &counting);
+        NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventBackward) == true);
+        NL_TEST_ASSERT(inSuite, IsTrace(trace, "-3-B+B"));
+        NL_TEST_ASSERT(inSuite, counting.mCalls == 1);
+        NL_TEST_ASSERT(inSuite, counting.mExits == 1);
+        NL_TEST_ASSERT(inSuite, counting.mTransitions == 1);
+        NL_TEST_ASSERT(inSuite, counting.mEntries == 1);
+
+        hierarchy3.SetDelegate(&never);
+
+        NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventError) == false);
+        NL_TEST_ASSERT(inSuite, IsTrace(trace, ""));
+        NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB_);
+
+        hierarchy3.SetDelegate(NULL);
+    }
+
+    // Test that an event deferred by an ancestor is queued and then
+    // recalled once a transition leaves it, and that a transition out
+    // of a nearer state takes precedence over an ancestor's deferral.
+
+    {
+        nl::Fsm::Machine::Mask bitmap[8];
+        nl::Fsm::Event queue[2];
+
+        NL_TEST_ASSERT(inSuite, machine1.SetDeferredEvents(bitmap, ARRAY_SIZE(bitmap)) == true);
+        NL_TEST_ASSERT(inSuite, machine1.SetDeferralQueue(queue, ARRAY_SIZE(queue)) == true);
+        NL_TEST_ASSERT(inSuite, machine1.SetEventDeferred(kStateB_, kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, machine1.SetEventDeferred(kStateB_, kEventStay) == true);
+
+        machine1.SetCurrentState(kStateB1);
+
+        NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventStay) == true);
+        NL_TEST_ASSERT(inSuite, IsTrace(trace, "-3+3"));
+        NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, IsTrace(trace, ""));
+        NL_TEST_ASSERT(inSuite, machine1.GetDeferredEventCount() == 1);
+
+        NL_TEST_ASSERT(inSuite, hierarchy3.HandleEvent(kEventError) == true);
+        NL_TEST_ASSERT(inSuite, IsTrace(trace, "-3-B-R+R+A+1-1+2"));
+        NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA2);
+        NL_TEST_ASSERT(inSuite, machine1.GetDeferredEventCount() == 0);
+    }
+}
+
+static void TestComposite(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition toggles[] = {
+        { kStateA, kEventStay,  kStateB },
+        { kStateB, kEventStay,  kStateA }
+    };
+    const nl::Fsm::Transition errors[] = {
+        { kStateA, kEventError, kStateD }
+    };
+    nl::Fsm::Composite::Mask bitmap[3];
+    CountingDelegate delegate;
+    size_t handled;
+
+    GetTransitions(first, size);
+
+    nl::Fsm::Machine machine1(first, size, stateA);
+    nl::Fsm::Machine machine2(toggles, ARRAY_SIZE(toggles), stateA);
+    nl::Fsm::Machine machine3(errors, ARRAY_SIZE(errors), stateA);
+    nl::Fsm::Machine * regions[] = { &machine1, &machine2, &machine3 };
+    nl::Fsm::Driver driver(machine1, &delegate);
+
+    nl::Fsm::Composite composite(regions, ARRAY_SIZE(regions), driver);
+
+    NL_TEST_ASSERT(inSuite, composite.GetRegionCount() == ARRAY_SIZE(regions));
+    NL_TEST_ASSERT(inSuite, composite.GetRegion(1) == &machine2);
+    NL_TEST_ASSERT(inSuite, composite.GetRegion(ARRAY_SIZE(regions)) == NULL);
+
+    // Test that, without a bitmap, every region sees every event.
+
+    NL_TEST_ASSERT(inSuite, composite.IsEventAccepted(2, kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, composite.HandleEvent(kEventStay, handled) == true);
+    NL_TEST_ASSERT(inSuite, handled == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateB);
+    NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateA);
+
+    // Test that a bitmap skips regions that never handle an event.
+
+    NL_TEST_ASSERT(inSuite, composite.GetAcceptedEventsSize() == ARRAY_SIZE(bitmap));
+    NL_TEST_ASSERT(inSuite, composite.SetAcceptedEvents(NULL, ARRAY_SIZE(bitmap)) == false);
+    NL_TEST_ASSERT(inSuite, composite.SetAcceptedEvents(bitmap, ARRAY_SIZE(bitmap) - 1) == false);
+    NL_TEST_ASSERT(inSuite, composite.SetAcceptedEvents(bitmap, ARRAY_SIZE(bitmap)) == true);
+
+    NL_TEST_ASSERT(inSuite, composite.IsEventAccepted(0, kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, composite.IsEventAccepted(1, kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, composite.IsEventAccepted(2, kEventStay) == false);
+    NL_TEST_ASSERT(inSuite, composite.IsEventAccepted(2, kEventError) == true);
+    NL_TEST_ASSERT(inSuite, composite.IsEventAccepted(3, kEventError) == false);
+
+    NL_TEST_ASSERT(inSuite, composite.HandleEvent(kEventStay, handled) == true);
+    NL_TEST_ASSERT(inSuite, handled == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 4);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateA);
+
+    NL_TEST_ASSERT(inSuite, composite.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 5);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    NL_TEST_ASSERT(inSuite, composite.HandleEvent(kEventError, handled) == true);
+    NL_TEST_ASSERT(inSuite, handled == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 7);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateD);
+    NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateD);
+
+    // Test that an event no region handles fails without reaching the
+    // driver.
+
+    NL_TEST_ASSERT(inSuite, composite.HandleEvent(kEventLast + 1, handled) == false);
+    NL_TEST_ASSERT(inSuite, handled == 0);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 7);
+
+    NL_TEST_ASSERT(inSuite, composite.HandleEvent(kEventError, handled) == false);
+    NL_TEST_ASSERT(inSuite, handled == 0);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 7);
+
+    composite.ClearAcceptedEvents();
+
+    NL_TEST_ASSERT(inSuite, composite.IsEventAccepted(2, kEventStay) == true);
+}
+
+static void TestExpander(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::State any = nl::Fsm::Transition::kAnyState;
+    const nl::Fsm::Event anyEvent = nl::Fsm::Transition::kAnyEvent;
+
+    // The test table, with the error transition out of every state
+    // written once.
+
+    const nl::Fsm::Transition compact[] = {
+        { kStateA, kEventStay,     kStateA },
+        { kStateA, kEventForward,  kStateB },
+        { kStateA, kEventBackward, kStateC },
+        { kStateA, kEventSkip,     kStateC },
+        { kStateB, kEventStay,     kStateB },
+        { kStateB, kEventForward,  kStateC },
+        { kStateB, kEventBackward, kStateA },
+        { kStateB, kEventSkip,     kStateA },
+        { kStateC, kEventStay,     kStateC },
+        { kStateC, kEventForward,  kStateA },
+        { kStateC, kEventBackward, kStateB },
+        { kStateC, kEventSkip,     kStateB },
+        { any,     kEventError,    kStateD }
+    };
+
+    // Each level of specificity, and a shadowed wildcard duplicate.
+
+    const nl::Fsm::Transition specific[] = {
+        { kStateA, anyEvent,       kStateD },
+        { any,     kEventForward,  kStateC },
+        { any,     anyEvent,       kStateA },
+        { kStateB, kEventForward,  kStateB },
+        { any,     kEventForward,  kStateD },
+        { kStateC, kEventStay,     kStateC }
+    };
+    const nl::Fsm::Transition expected[] = {
+        { kStateA, kEventForward,  kStateD },
+        { kStateA, kEventStay,     kStateD },
+        { kStateC, kEventForward,  kStateC },
+        { kStateD, kEventForward,  kStateC },
+        { kStateB, kEventStay,     kStateA },
+        { kStateD, kEventStay,     kStateA },
+        { kStateB, kEventForward,  kStateB },
+        { kStateC, kEventStay,     kStateC }
+    };
+    const nl::Fsm::Transition invalid[] = {
+        { kStateA, kEventStay,     any }
+    };
+    nl::Fsm::Expander::Word workspace[4 * ARRAY_SIZE(compact)];
+    nl::Fsm::Transition expanded[24];
+    size_t count;
+
+    GetTransitions(first, size);
+
+    nl::Fsm::Expander expander1;
+    nl::Fsm::Expander expander2(workspace, ARRAY_SIZE(workspace));
+
+    // Test sizing and construction
+
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Expander::GetWorkspaceSize(ARRAY_SIZE(compact)) == ARRAY_SIZE(workspace));
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Expander::IsWildcard(compact[0]) == false);
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Expander::IsWildcard(compact[12]) == true);
+    NL_TEST_ASSERT(inSuite, expander1.GetExpandedCount(compact, ARRAY_SIZE(compact), count) == false);
+
+    expander1.SetWorkspace(workspace, ARRAY_SIZE(workspace) - 1);
+
+    NL_TEST_ASSERT(inSuite, expander1.GetExpandedCount(compact, ARRAY_SIZE(compact), count) == false);
+
+    // Test that a wildcard state matches every state in the table,
+    // including those with no transitions of their own, and that the
+    // expansion behaves as the explicit table.
+
+    NL_TEST_ASSERT(inSuite, expander2.GetExpandedCount(compact, ARRAY_SIZE(compact), count) == true);
+    NL_TEST_ASSERT(inSuite, count == (size + 1));
+
+    count = size;
+
+    NL_TEST_ASSERT(inSuite, expander2.Expand(compact, ARRAY_SIZE(compact), expanded, count) == false);
+
+    count = ARRAY_SIZE(expanded);
+
+    NL_TEST_ASSERT(inSuite, expander2.Expand(expanded, 0, expanded, count) == false);
+    NL_TEST_ASSERT(inSuite, expander2.Expand(compact, ARRAY_SIZE(compact), expanded, count) == true);
+    NL_TEST_ASSERT(inSuite, count == (size + 1));
+
+    {
+        nl::Fsm::Machine machine1(first, size, stateA);
+        nl::Fsm::Machine machine2(expanded, count, stateA);
+
+        for (nl::Fsm::State state = kStateA; state <= kStateC; state++) {
+            for (nl::Fsm::Event event = kEventFirst; event <= kEventLast; event++) {
+                const nl::Fsm::Transition * transition1 = machine1.FindTransition(state, event);
+                const nl::Fsm::Transition * transition2 = machine2.FindTransition(state, event);
+
+                NL_TEST_ASSERT(inSuite, (transition1 != NULL) && (transition2 != NULL));
+                NL_TEST_ASSERT(inSuite, *transition1 == *transition2);
+            }
+        }
+
+        NL_TEST_ASSERT(inSuite, machine2.FindTransition(kStateD, kEventError) != NULL);
+        NL_TEST_ASSERT(inSuite, machine2.FindTransition(kStateD, kEventStay) == NULL);
+    }
+
+    // Test that the most specific transition wins.
+
+    count = ARRAY_SIZE(expanded);
+
+    NL_TEST_ASSERT(inSuite, expander2.Expand(specific, ARRAY_SIZE(specific), expanded, count) == true);
+    NL_TEST_ASSERT(inSuite, count == ARRAY_SIZE(expected));
+
+    for (size_t i = 0; i < ARRAY_SIZE(expected); i++)
+        NL_TEST_ASSERT(inSuite, expanded[i] == expected[i]);
+
+    // Test that a wildcard ending state is rejected.
+
+    NL_TEST_ASSERT(inSuite, expander2.GetExpandedCount(invalid, ARRAY_SIZE(invalid), count) == false);
+}
+
+static void TestDeferral(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateA, kEventSkip,     kStateC },
+        { kStateB, kEventBackward, kStateA },
+        { kStateC, kEventSkip,     kStateA },
+        { kStateC, kEventStay,     kStateD }
+    };
+    nl::Fsm::Machine::Mask bitmap[8];
+    nl::Fsm::Event queue[2];
+    CountingDelegate delegate;
+
+    nl::Fsm::Machine machine(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Driver driver(machine, nl::Fsm::Delegate::kConstantAlways);
+
+    // Test that nothing is deferred without a bitmap or queue.
+
+    NL_TEST_ASSERT(inSuite, machine.IsEventDeferred(kStateB, kEventSkip) == false);
+    NL_TEST_ASSERT(inSuite, machine.SetEventDeferred(kStateB, kEventSkip) == false);
+    NL_TEST_ASSERT(inSuite, machine.PushDeferredEvent(kEventSkip) == false);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 0);
+
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventsSize() > 0);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventsSize() <= ARRAY_SIZE(bitmap));
+    NL_TEST_ASSERT(inSuite, machine.SetDeferredEvents(NULL, ARRAY_SIZE(bitmap)) == false);
+    NL_TEST_ASSERT(inSuite, machine.SetDeferredEvents(bitmap, machine.GetDeferredEventsSize() - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine.SetDeferredEvents(bitmap, ARRAY_SIZE(bitmap)) == true);
+    NL_TEST_ASSERT(inSuite, machine.SetDeferralQueue(NULL, ARRAY_SIZE(queue)) == false);
+    NL_TEST_ASSERT(inSuite, machine.SetDeferralQueue(queue, 0) == false);
+    NL_TEST_ASSERT(inSuite, machine.SetDeferralQueue(queue, ARRAY_SIZE(queue)) == true);
+
+    NL_TEST_ASSERT(inSuite, machine.SetEventDeferred(kStateB, kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, machine.SetEventDeferred(kStateB, kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, machine.SetEventDeferred(kStateC, kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, machine.SetEventDeferred(kStateLast + 1, kEventStay) == false);
+
+    NL_TEST_ASSERT(inSuite, machine.IsEventDeferred(kStateB, kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, machine.IsEventDeferred(kStateA, kEventSkip) == false);
+    NL_TEST_ASSERT(inSuite, machine.IsEventDeferred(kStateLast + 1, kEventSkip) == false);
+
+    // Test that a deferred event is queued and recalled, and handled,
+    // after the next change of state.
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, machine.GetCurrentState() == kStateB);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, machine.GetCurrentState() == kStateB);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 1);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventError) == false);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 1);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, machine.GetCurrentState() == kStateC);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 0);
+
+    // Test that a full queue rejects a deferred event.
+
+    machine.SetCurrentState(kStateB);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventSkip) == false);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 2);
+
+    // Test that an event still deferred after a change of state is
+    // queued again, and recalled after the next change of state, in
+    // which it is dropped if not handled.
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, machine.GetCurrentState() == kStateC);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 1);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, machine.GetCurrentState() == kStateA);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 0);
+
+    // Test that the delegate sees recalled events as it does any
+    // other.
+
+    driver.SetDelegate(&delegate);
+    machine.SetCurrentState(kStateA);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 1);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 3);
+    NL_TEST_ASSERT(inSuite, machine.GetCurrentState() == kStateC);
+
+    // Test that setting the transitions clears the bitmap and queue.
+
+    machine.SetCurrentState(kStateB);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 1);
+
+    machine.SetTransitions(transitions, ARRAY_SIZE(transitions), stateA);
+
+    NL_TEST_ASSERT(inSuite, machine.IsEventDeferred(kStateB, kEventSkip) == false);
+    NL_TEST_ASSERT(inSuite, machine.GetDeferredEventCount() == 0);
+    NL_TEST_ASSERT(inSuite, machine.PushDeferredEvent(kEventSkip) == false);
+}
+
+struct TimeoutContext
+{
+    nl::Fsm::TimerWheel * mWheel;
+    nl::Fsm::Machine *    mMachine;
+    bool                  mTransition;
+};
+
+static bool ArmingAction(const nl::Fsm::Event &inEvent,
+                         const nl::Fsm::Transition &inTransition,
+                         void *inContext)
+{
+    TimeoutContext * context = static_cast<TimeoutContext *>(inContext);
+
+    if (context->mTransition)
+        return (context->mWheel->Arm(*context->mMachine, inTransition, kEventError, 2));
+
+    return (context->mWheel->Arm(*context->mMachine, kEventError, 2));
+}
+
+static void TestTimerWheel(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateA, kEventStay,     kStateA },
+        { kStateA, kEventError,    kStateD },
+        { kStateB, kEventBackward, kStateA },
+        { kStateB, kEventError,    kStateD }
+    };
+    nl::Fsm::TimerWheel::Timer timers[3];
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Machine machine2(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Driver driver(machine1, nl::Fsm::Delegate::kConstantAlways);
+
+    nl::Fsm::TimerWheel wheel(driver);
+
+    // Test that nothing is armed without timer storage.
+
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine1, kEventError, 1) == false);
+    NL_TEST_ASSERT(inSuite, wheel.SetTimers(NULL, ARRAY_SIZE(timers)) == false);
+    NL_TEST_ASSERT(inSuite, wheel.SetTimers(timers, 0) == false);
+    NL_TEST_ASSERT(inSuite, wheel.SetTimers(timers, ARRAY_SIZE(timers)) == true);
+
+    // Test that timers fire, in order of expiry, at the specified
+    // machine after the specified delay, and that storage runs out.
+
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine1, kEventError, 5) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine2, kEventForward, 3) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine2, kEventBackward, 0) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine2, kEventError, 9) == false);
+    NL_TEST_ASSERT(inSuite, wheel.GetPendingCount() == 3);
+
+    NL_TEST_ASSERT(inSuite, wheel.Advance(2) == 1);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateA);
+
+    NL_TEST_ASSERT(inSuite, wheel.Advance(1) == 1);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateB);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+
+    NL_TEST_ASSERT(inSuite, wheel.Advance(2) == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateD);
+    NL_TEST_ASSERT(inSuite, wheel.GetPendingCount() == 0);
+    NL_TEST_ASSERT(inSuite, wheel.GetNow() == 5);
+
+    // Test that leaving the arming state, even to return to it,
+    // cancels a timer, but an internal self-loop does not.
+
+    machine1.SetCurrentState(kStateA);
+    driver.SetMachine(machine1);
+
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine1, kEventError, 10) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventBackward) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Advance(10) == 0);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+    NL_TEST_ASSERT(inSuite, wheel.GetPendingCount() == 0);
+
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine1, kEventError, 10) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Advance(10) == 0);
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopInternal);
+
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine1, kEventError, 10) == true);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Advance(10) == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateD);
+
+    // Test that long delays cascade down through every level and fire
+    // on time, across a wrap of the tick.
+
+    machine1.SetCurrentState(kStateA);
+    machine2.SetCurrentState(kStateA);
+
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine1, kEventError, 70000) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine2, kEventError, (1 << 24) + 300) == true);
+
+    NL_TEST_ASSERT(inSuite, wheel.Advance(69999) == 0);
+    NL_TEST_ASSERT(inSuite, wheel.Advance(1) == 1);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateD);
+
+    NL_TEST_ASSERT(inSuite, wheel.Advance((1 << 24) + 299 - 70000) == 0);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateA);
+    NL_TEST_ASSERT(inSuite, wheel.Advance(1) == 1);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateD);
+
+    NL_TEST_ASSERT(inSuite, wheel.Advance(UINT32_MAX - wheel.GetNow() - 1) == 0);
+
+    machine1.SetCurrentState(kStateA);
+    machine2.SetCurrentState(kStateA);
+
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine1, kEventError, 1) == true);
+    NL_TEST_ASSERT(inSuite, wheel.Arm(machine2, kEventError, 600) == true);
+
+    NL_TEST_ASSERT(inSuite, wheel.Advance(1) == 1);
+    NL_TEST_ASSERT(inSuite, wheel.GetNow() == UINT32_MAX);
+    NL_TEST_ASSERT(inSuite, wheel.Advance(598) == 0);
+    NL_TEST_ASSERT(inSuite, wheel.Advance(1) == 1);
+    NL_TEST_ASSERT(inSuite, wheel.GetNow() == 598);
+    NL_TEST_ASSERT(inSuite, wheel.GetPendingCount() == 0);
+
+    // Test that a timer armed from a transition's action without the
+    // transition belongs to the state being left, but one armed with
+    // it belongs to the state being entered, and is cancelled once
+    // that state is left.
+
+    {
+        nl::Fsm::Machine machine3(transitions, ARRAY_SIZE(transitions), stateA);
+        nl::Fsm::Driver driver3(machine3, nl::Fsm::Delegate::kConstantAlways);
+        TimeoutContext context = { &wheel, &machine3, false };
+        nl::Fsm::Machine::Action actions[ARRAY_SIZE(transitions)];
+
+        memset(actions, 0, sizeof(actions));
+
+        actions[0].mFunction = ArmingAction;
+        actions[0].mContext  = &context;
+
+        NL_TEST_ASSERT(inSuite, machine3.SetActions(actions, ARRAY_SIZE(actions)) == true);
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, wheel.GetPendingCount() == 1);
+        NL_TEST_ASSERT(inSuite, wheel.Advance(2) == 0);
+        NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateB);
+
+        context.mTransition = true;
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventBackward) == true);
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, wheel.Advance(2) == 1);
+        NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateD);
+
+        machine3.SetCurrentState(kStateA);
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventBackward) == true);
+        NL_TEST_ASSERT(inSuite, wheel.Advance(2) == 0);
+        NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateA);
+        NL_TEST_ASSERT(inSuite, wheel.GetPendingCount() == 0);
+    }
+}
+
+static void TestEventLoop(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateA, kEventStay,     kStateA },
+        { kStateA, kEventError,    kStateD },
+        { kStateB, kEventBackward, kStateA }
+    };
+    const nl::Fsm::Event batch[] = {
+        kEventForward, kEventForward, kEventBackward, kEventStay, kEventForward
+    };
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Machine machine2(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Machine machine3(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Driver driver(machine1, nl::Fsm::Delegate::kConstantAlways);
+
+    // Test that a batch is handled in order, each event in the
+    // then-current state, past any event that fails.
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvents(batch, ARRAY_SIZE(batch)) == 4);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvents(batch, 0) == 0);
+
+    driver.SetDelegate(nl::Fsm::Delegate::kConstantNever);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvents(batch, ARRAY_SIZE(batch)) == 0);
+
+    driver.SetDelegate(nl::Fsm::Delegate::kConstantAlways);
+
+#if defined(__linux__)
+    {
+        nl::Fsm::EventLoop::Source sources[3];
+        nl::Fsm::Event buffer[2];
+        struct itimerspec expiry = { { 0, 0 }, { 0, 1000 } };
+        const uint64_t count = 3;
+        int pipes[2];
+        int counter;
+        int timer;
+        size_t handled;
+        size_t total;
+        size_t source;
+        int i;
+
+        machine1.SetCurrentState(kStateA);
+
+        nl::Fsm::EventLoop loop(driver);
+
+        NL_TEST_ASSERT(inSuite, pipe(pipes) == 0);
+        counter = eventfd(0, EFD_CLOEXEC);
+        NL_TEST_ASSERT(inSuite, counter >= 0);
+        timer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        NL_TEST_ASSERT(inSuite, timer >= 0);
+
+        // Test that nothing is added or polled until the loop is open
+        // with storage.
+
+        NL_TEST_ASSERT(inSuite, loop.Poll(0, handled) == false);
+        NL_TEST_ASSERT(inSuite, loop.AddStream(pipes[0], machine1, source) == false);
+        NL_TEST_ASSERT(inSuite, loop.Open() == true);
+        NL_TEST_ASSERT(inSuite, loop.Open() == false);
+        NL_TEST_ASSERT(inSuite, loop.AddStream(pipes[0], machine1, source) == false);
+        NL_TEST_ASSERT(inSuite, loop.SetSources(sources, ARRAY_SIZE(sources)) == true);
+        NL_TEST_ASSERT(inSuite, loop.SetBuffer(buffer, 0) == false);
+        NL_TEST_ASSERT(inSuite, loop.SetBuffer(buffer, ARRAY_SIZE(buffer)) == true);
+
+        NL_TEST_ASSERT(inSuite, loop.AddStream(-1, machine1, source) == false);
+        NL_TEST_ASSERT(inSuite, loop.AddStream(pipes[0], machine1, source) == true);
+        NL_TEST_ASSERT(inSuite, source == 0);
+        NL_TEST_ASSERT(inSuite, loop.AddCounter(counter, machine2, kEventStay, source) == true);
+        NL_TEST_ASSERT(inSuite, source == 1);
+        NL_TEST_ASSERT(inSuite, loop.AddCounter(timer, machine3, kEventError, source) == true);
+        NL_TEST_ASSERT(inSuite, source == 2);
+        NL_TEST_ASSERT(inSuite, loop.AddCounter(timer, machine3, kEventError, source) == false);
+        NL_TEST_ASSERT(inSuite, loop.GetSourceCount() == 3);
+        NL_TEST_ASSERT(inSuite, loop.SetSources(sources, ARRAY_SIZE(sources)) == false);
+
+        NL_TEST_ASSERT(inSuite, loop.Poll(0, handled) == true);
+        NL_TEST_ASSERT(inSuite, handled == 0);
+
+        // Test that a stream is drained in batches of the buffer size
+        // and a counter handles its event as many times as counted.
+
+        NL_TEST_ASSERT(inSuite, write(pipes[1], batch, ARRAY_SIZE(batch)) == ARRAY_SIZE(batch));
+        NL_TEST_ASSERT(inSuite, write(counter, &count, sizeof (count)) == sizeof (count));
+
+        NL_TEST_ASSERT(inSuite, loop.Poll(1000, handled) == true);
+        NL_TEST_ASSERT(inSuite, handled == 7);
+        NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+        NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateA);
+
+        // Test that a timer expiry is handled.
+
+        NL_TEST_ASSERT(inSuite, timerfd_settime(timer, 0, &expiry, NULL) == 0);
+
+        for (i = 0, total = 0; (i < 100) && (total == 0); i++) {
+            NL_TEST_ASSERT(inSuite, loop.Poll(10, handled) == true);
+            total += handled;
+        }
+
+        NL_TEST_ASSERT(inSuite, total == 1);
+        NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateD);
+
+        // Test that events written before a hang up are handled and the
+        // stream then removed.
+
+        NL_TEST_ASSERT(inSuite, write(pipes[1], batch + 2, 1) == 1);
+        close(pipes[1]);
+
+        NL_TEST_ASSERT(inSuite, loop.Poll(1000, handled) == true);
+        NL_TEST_ASSERT(inSuite, handled == 1);
+        NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+        NL_TEST_ASSERT(inSuite, loop.Remove(0) == false);
+        NL_TEST_ASSERT(inSuite, loop.Remove(1) == true);
+        NL_TEST_ASSERT(inSuite, loop.Remove(3) == false);
+
+        NL_TEST_ASSERT(inSuite, write(counter, &count, sizeof (count)) == sizeof (count));
+        NL_TEST_ASSERT(inSuite, loop.Poll(0, handled) == true);
+        NL_TEST_ASSERT(inSuite, handled == 0);
+
+        // Test that the storage of removed sources is reused.
+
+        NL_TEST_ASSERT(inSuite, loop.GetSourceCount() == 1);
+        NL_TEST_ASSERT(inSuite, loop.AddCounter(counter, machine2, kEventStay, source) == true);
+        NL_TEST_ASSERT(inSuite, source == 0);
+        NL_TEST_ASSERT(inSuite, loop.AddCounter(counter, machine2, kEventStay, source) == false);
+
+        NL_TEST_ASSERT(inSuite, loop.Poll(0, handled) == true);
+        NL_TEST_ASSERT(inSuite, handled == 3);
+        NL_TEST_ASSERT(inSuite, loop.GetSourceCount() == 2);
+
+        loop.Close();
+
+        close(pipes[0]);
+        close(counter);
+        close(timer);
+    }
+
+    {
+        typedef nl::Fsm::BasicTransition<uint16_t, uint16_t> WideTransition;
+        typedef nl::Fsm::BasicMachine<uint16_t, uint16_t>    WideMachine;
+        typedef nl::Fsm::BasicDriver<uint16_t, uint16_t>     WideDriver;
+        typedef nl::Fsm::BasicEventLoop<uint16_t, uint16_t>  WideLoop;
+
+        const WideTransition wide[] = {
+            { 0, 0x1234, 1 },
+            { 1, 0x5678, 0 }
+        };
+        const uint16_t events[] = { 0x1234, 0x5678 };
+        const uint8_t * const bytes = reinterpret_cast<const uint8_t *>(events);
+        const uint16_t state0(0);
+        WideLoop::Source sources[1];
+        uint16_t buffer[4];
+        size_t handled;
+        size_t source;
+        int pipes[2];
+
+        WideMachine machine4(wide, ARRAY_SIZE(wide), state0);
+        WideDriver driver4(machine4, nl::Fsm::Delegate::kConstantAlways);
+        WideLoop loop(driver4);
+
+        NL_TEST_ASSERT(inSuite, pipe(pipes) == 0);
+        NL_TEST_ASSERT(inSuite, loop.Open() == true);
+        NL_TEST_ASSERT(inSuite, loop.SetSources(sources, ARRAY_SIZE(sources)) == true);
+        NL_TEST_ASSERT(inSuite, loop.SetBuffer(buffer, ARRAY_SIZE(buffer)) == true);
+        NL_TEST_ASSERT(inSuite, loop.AddStream(pipes[0], machine4, source) == true);
+
+        // Test that the bytes of a wide event split across reads are
+        // carried over, keeping later events aligned.
+
+        NL_TEST_ASSERT(inSuite, write(pipes[1], bytes, 1) == 1);
+        NL_TEST_ASSERT(inSuite, loop.Poll(1000, handled) == true);
+        NL_TEST_ASSERT(inSuite, handled == 0);
+
+        NL_TEST_ASSERT(inSuite, write(pipes[1], bytes + 1, 3) == 3);
+        NL_TEST_ASSERT(inSuite, loop.Poll(1000, handled) == true);
+        NL_TEST_ASSERT(inSuite, handled == 2);
+        NL_TEST_ASSERT(inSuite, machine4.GetCurrentState() == 0);
+
+        loop.Close();
+
+        close(pipes[0]);
+        close(pipes[1]);
+    }
+#endif // defined(__linux__)
+}
+
+class PendingDelegate : public nl::Fsm::Delegate::Async
+{
+public:
+    PendingDelegate(void) :
+        mEnterResult(nl::Fsm::Delegate::kResultContinue),
+        mCalls(0),
+        mEntries(0),
+        mHandled(0)
+    {
+        return;
+    }
+
+    virtual nl::Fsm::Delegate::Result WillHandleEvent(const nl::Fsm::Event &inEvent,
+                                                      const nl::Fsm::State &inState)
+    {
+        mCalls++;
+
+        return (nl::Fsm::Delegate::kResultContinue);
+    }
+
+    virtual nl::Fsm::Delegate::Result WillEnterState(const nl::Fsm::Event &inEvent,
+                                                     const nl::Fsm::Transition &inTransition)
+    {
+        mEntries++;
+
+        return (mEnterResult);
+    }
+
+    virtual nl::Fsm::Delegate::Result DidHandleEvent(const nl::Fsm::Event &inEvent,
+                                                     const nl::Fsm::State &inState)
+    {
+        mHandled++;
+
+        return (nl::Fsm::Delegate::kResultContinue);
+    }
+
+    nl::Fsm::Delegate::Result mEnterResult;
+    size_t mCalls;
+    size_t mEntries;
+    size_t mHandled;
+};
+
+static void TestAsyncDriver(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateA, kEventStay,     kStateA },
+        { kStateB, kEventBackward, kStateA }
+    };
+    nl::Fsm::Event queue[2];
+    PendingDelegate delegate;
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Machine machine2(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::AsyncDriver driver1(machine1, &delegate);
+    nl::Fsm::AsyncDriver driver2(machine2, &delegate);
+
+    // Test that, without a pending delegate method, events are handled
+    // as by the synchronous driver.
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventBackward) == nl::Fsm::AsyncDriver::kStatusFailed);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusHandled);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+    NL_TEST_ASSERT(inSuite, driver1.IsSuspended() == false);
+    NL_TEST_ASSERT(inSuite, driver1.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusFailed);
+
+    // Test that a pending delegate method suspends the event before
+    // the state is entered, leaving other machines free to run, and
+    // that later events fail without a queue.
+
+    delegate.mEnterResult = nl::Fsm::Delegate::kResultPending;
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventBackward) == nl::Fsm::AsyncDriver::kStatusSuspended);
+    NL_TEST_ASSERT(inSuite, driver1.IsSuspended() == true);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusFailed);
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusSuspended);
+
+    NL_TEST_ASSERT(inSuite, driver1.Resume(nl::Fsm::Delegate::kResultPending) == nl::Fsm::AsyncDriver::kStatusSuspended);
+    NL_TEST_ASSERT(inSuite, driver1.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusHandled);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+    NL_TEST_ASSERT(inSuite, driver1.IsSuspended() == false);
+
+    NL_TEST_ASSERT(inSuite, driver2.Resume(nl::Fsm::Delegate::kResultVeto) == nl::Fsm::AsyncDriver::kStatusFailed);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateA);
+
+    // Test that events arriving during suspension queue behind the
+    // in-flight event and are handled, in order, once it completes,
+    // themselves suspending as needed.
+
+    NL_TEST_ASSERT(inSuite, driver1.SetQueue(NULL, ARRAY_SIZE(queue)) == false);
+    NL_TEST_ASSERT(inSuite, driver1.SetQueue(queue, ARRAY_SIZE(queue)) == true);
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusSuspended);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventBackward) == nl::Fsm::AsyncDriver::kStatusQueued);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventStay) == nl::Fsm::AsyncDriver::kStatusQueued);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventStay) == nl::Fsm::AsyncDriver::kStatusFailed);
+    NL_TEST_ASSERT(inSuite, driver1.GetQueuedCount() == 2);
+
+    delegate.mCalls   = 0;
+    delegate.mHandled = 0;
+
+    NL_TEST_ASSERT(inSuite, driver1.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusHandled);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+    NL_TEST_ASSERT(inSuite, driver1.IsSuspended() == true);
+    NL_TEST_ASSERT(inSuite, driver1.GetQueuedCount() == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 1);
+    NL_TEST_ASSERT(inSuite, delegate.mHandled == 1);
+
+    NL_TEST_ASSERT(inSuite, driver1.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusHandled);
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateA);
+    NL_TEST_ASSERT(inSuite, driver1.IsSuspended() == true);
+    NL_TEST_ASSERT(inSuite, driver1.GetQueuedCount() == 0);
+
+    NL_TEST_ASSERT(inSuite, driver1.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusHandled);
+    NL_TEST_ASSERT(inSuite, driver1.IsSuspended() == false);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 2);
+    NL_TEST_ASSERT(inSuite, delegate.mHandled == 3);
+
+    // Test that an internal transition never enters its state, so
+    // never suspends there.
+
+    machine1.SetSelfLoopPolicy(nl::Fsm::Machine::kSelfLoopInternal);
+
+    delegate.mEntries = 0;
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventStay) == nl::Fsm::AsyncDriver::kStatusHandled);
+    NL_TEST_ASSERT(inSuite, delegate.mEntries == 0);
+
+    // Test that a deferred event is pushed onto the machine's deferral
+    // queue and recalled once an event changes the state, suspending
+    // like any other event.
+
+    {
+        nl::Fsm::Machine::Mask bitmap[8];
+        nl::Fsm::Event deferred[1];
+
+        nl::Fsm::Machine machine3(transitions, ARRAY_SIZE(transitions), stateA);
+        nl::Fsm::AsyncDriver driver3(machine3, &delegate);
+
+        NL_TEST_ASSERT(inSuite, machine3.SetDeferredEvents(bitmap, ARRAY_SIZE(bitmap)) == true);
+        NL_TEST_ASSERT(inSuite, machine3.SetDeferralQueue(deferred, ARRAY_SIZE(deferred)) == true);
+        NL_TEST_ASSERT(inSuite, machine3.SetEventDeferred(kStateA, kEventBackward) == true);
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventBackward) == nl::Fsm::AsyncDriver::kStatusQueued);
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventBackward) == nl::Fsm::AsyncDriver::kStatusFailed);
+        NL_TEST_ASSERT(inSuite, machine3.GetDeferredEventCount() == 1);
+        NL_TEST_ASSERT(inSuite, driver3.IsSuspended() == false);
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusSuspended);
+        NL_TEST_ASSERT(inSuite, driver3.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusHandled);
+        NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateB);
+        NL_TEST_ASSERT(inSuite, machine3.GetDeferredEventCount() == 0);
+        NL_TEST_ASSERT(inSuite, driver3.IsSuspended() == true);
+
+        NL_TEST_ASSERT(inSuite, driver3.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusHandled);
+        NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateA);
+        NL_TEST_ASSERT(inSuite, driver3.IsSuspended() == false);
+    }
+}
+
+struct OutputContext
+{
+    nl::Fsm::Event mLast;
+    size_t         mCount;
+    bool           mAccept;
+};
+
+static bool CountOutput(const nl::Fsm::Event &inOutput, void *inContext)
+{
+    OutputContext *theContext = static_cast<OutputContext *>(inContext);
+
+    theContext->mLast = inOutput;
+    theContext->mCount++;
+
+    return (theContext->mAccept);
+}
+
+static void TestPipeline(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition transitions1[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateB, kEventForward,  kStateA }
+    };
+    const nl::Fsm::Event outputs1[] = {
+        nl::Fsm::Transition::kNoEvent,
+        kEventSkip
+    };
+    const nl::Fsm::Transition transitions2[] = {
+        { kStateA, kEventSkip,     kStateA }
+    };
+    const nl::Fsm::Event outputs2[] = {
+        kEventStay
+    };
+    const nl::Fsm::Transition other = { kStateA, kEventSkip, kStateA };
+    nl::Fsm::Pipeline::Queue queues[3];
+    nl::Fsm::Event events[12];
+    nl::Fsm::Event theOutput;
+    OutputContext context = { 0, 0, true };
+    CountingDelegate delegate;
+    size_t i;
+
+    nl::Fsm::Machine machine1(transitions1, ARRAY_SIZE(transitions1), stateA);
+    nl::Fsm::Machine machine2(transitions2, ARRAY_SIZE(transitions2), stateA);
+    nl::Fsm::Driver driver1(machine1, nl::Fsm::Delegate::kConstantAlways);
+    nl::Fsm::Driver driver2(machine2, &delegate);
+    nl::Fsm::Driver * const stages[] = { &driver1, &driver2 };
+    nl::Fsm::Pipeline pipeline(stages, ARRAY_SIZE(stages));
+
+    // Test that outputs are only found for transitions in the table
+    // with an output.
+
+    NL_TEST_ASSERT(inSuite, machine1.HasOutputs() == false);
+    NL_TEST_ASSERT(inSuite, machine1.GetOutput(transitions1[1], theOutput) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetOutputs(NULL, ARRAY_SIZE(outputs1)) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetOutputs(outputs1, ARRAY_SIZE(outputs1) - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetOutputs(outputs1, ARRAY_SIZE(outputs1)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.HasOutputs() == true);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetOutput(transitions1[0], theOutput) == false);
+    NL_TEST_ASSERT(inSuite, machine1.GetOutput(other, theOutput) == false);
+    NL_TEST_ASSERT(inSuite, machine1.GetOutput(transitions1[1], theOutput) == true);
+    NL_TEST_ASSERT(inSuite, theOutput == kEventSkip);
+
+    // Test that the driver passes each output to its sink, whatever
+    // the delegate, and fails if the sink does not accept it.
+
+    driver1.SetOutputSink(CountOutput, &context);
+
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, context.mCount == 0);
+    NL_TEST_ASSERT(inSuite, driver1.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, context.mCount == 1);
+    NL_TEST_ASSERT(inSuite, context.mLast == kEventSkip);
+
+    NL_TEST_ASSERT(inSuite, machine2.SetOutputs(outputs2, ARRAY_SIZE(outputs2)) == true);
+
+    driver2.SetOutputSink(CountOutput, &context);
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, context.mCount == 2);
+    NL_TEST_ASSERT(inSuite, context.mLast == kEventStay);
+
+    context.mAccept = false;
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventSkip) == false);
+    NL_TEST_ASSERT(inSuite, context.mCount == 3);
+
+    driver2.SetOutputSink(NULL, NULL);
+
+    NL_TEST_ASSERT(inSuite, driver2.HandleEvent(kEventSkip) == true);
+    NL_TEST_ASSERT(inSuite, context.mCount == 3);
+
+    // Test that the asynchronous driver and the hierarchy pass outputs
+    // on too, the former only once the event completes.
+
+    {
+        const nl::Fsm::State parents[] = { kStateA, kStateB };
+        nl::Fsm::Hierarchy::Word workspace[16];
+        PendingDelegate pending;
+
+        nl::Fsm::Machine machine3(transitions1, ARRAY_SIZE(transitions1), stateA);
+        nl::Fsm::AsyncDriver driver3(machine3, &pending);
+        nl::Fsm::Hierarchy hierarchy(machine3, parents, ARRAY_SIZE(parents));
+
+        NL_TEST_ASSERT(inSuite, machine3.SetOutputs(outputs1, ARRAY_SIZE(outputs1)) == true);
+
+        driver3.SetOutputSink(CountOutput, &context);
+
+        context.mCount  = 0;
+        context.mAccept = true;
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusHandled);
+        NL_TEST_ASSERT(inSuite, context.mCount == 0);
+
+        pending.mEnterResult = nl::Fsm::Delegate::kResultPending;
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusSuspended);
+        NL_TEST_ASSERT(inSuite, context.mCount == 0);
+        NL_TEST_ASSERT(inSuite, driver3.Resume(nl::Fsm::Delegate::kResultContinue) == nl::Fsm::AsyncDriver::kStatusHandled);
+        NL_TEST_ASSERT(inSuite, context.mCount == 1);
+        NL_TEST_ASSERT(inSuite, context.mLast == kEventSkip);
+
+        pending.mEnterResult = nl::Fsm::Delegate::kResultContinue;
+        context.mAccept      = false;
+
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusHandled);
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventForward) == nl::Fsm::AsyncDriver::kStatusFailed);
+        NL_TEST_ASSERT(inSuite, context.mCount == 2);
+
+        NL_TEST_ASSERT(inSuite, hierarchy.SetWorkspace(workspace, ARRAY_SIZE(workspace)) == true);
+
+        hierarchy.SetOutputSink(CountOutput, &context);
+
+        context.mAccept = true;
+
+        NL_TEST_ASSERT(inSuite, hierarchy.HandleEvent(kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, context.mCount == 2);
+        NL_TEST_ASSERT(inSuite, hierarchy.HandleEvent(kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, context.mCount == 3);
+        NL_TEST_ASSERT(inSuite, context.mLast == kEventSkip);
+    }
+
+    // Test that the pipeline needs a queue for each stage and one
+    // more, each with room for at least one event.
+
+    NL_TEST_ASSERT(inSuite, pipeline.GetStageCount() == 2);
+    NL_TEST_ASSERT(inSuite, pipeline.SetQueues(queues, ARRAY_SIZE(queues) - 1, events, ARRAY_SIZE(events)) == false);
+    NL_TEST_ASSERT(inSuite, pipeline.SetQueues(queues, ARRAY_SIZE(queues), events, 5) == false);
+    NL_TEST_ASSERT(inSuite, pipeline.SetQueues(queues, ARRAY_SIZE(queues), events, ARRAY_SIZE(events)) == true);
+
+    // Test that events flow through each stage in turn, the first
+    // stage emitting every second event and the second stage
+    // translating each.
+
+    for (i = 0; i < 3; i++) {
+        NL_TEST_ASSERT(inSuite, pipeline.Push(kEventForward) == true);
+    }
+
+    NL_TEST_ASSERT(inSuite, pipeline.Push(kEventForward) == false);
+    NL_TEST_ASSERT(inSuite, pipeline.Pop(theOutput) == false);
+
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 2) == 2);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 2) == 1);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 2) == 0);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(1, 8) == 1);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(2, 8) == 0);
+
+    NL_TEST_ASSERT(inSuite, pipeline.Pop(theOutput) == true);
+    NL_TEST_ASSERT(inSuite, theOutput == kEventStay);
+    NL_TEST_ASSERT(inSuite, pipeline.Pop(theOutput) == false);
+
+    // Test that a stage holds back while its output queue is full.
+
+    for (i = 0; i < 3; i++) {
+        NL_TEST_ASSERT(inSuite, pipeline.Push(kEventForward) == true);
+    }
+
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 8) == 3);
+
+    for (i = 0; i < 3; i++) {
+        NL_TEST_ASSERT(inSuite, pipeline.Push(kEventForward) == true);
+    }
+
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 8) == 2);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 8) == 0);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(1, 8) == 3);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 8) == 1);
+
+    NL_TEST_ASSERT(inSuite, pipeline.Push(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(0, 8) == 1);
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(1, 8) == 0);
+
+    for (i = 0; i < 3; i++) {
+        NL_TEST_ASSERT(inSuite, pipeline.Pop(theOutput) == true);
+        NL_TEST_ASSERT(inSuite, theOutput == kEventStay);
+    }
+
+    NL_TEST_ASSERT(inSuite, pipeline.RunStage(1, 8) == 1);
+    NL_TEST_ASSERT(inSuite, pipeline.Pop(theOutput) == true);
+    NL_TEST_ASSERT(inSuite, pipeline.Pop(theOutput) == false);
+
+    // Test that a stage whose machine has deferred an event only takes
+    // another while its output queue has room for the outputs of both,
+    // since the second may recall the first.
+
+    {
+        const nl::Fsm::Transition transitions3[] = {
+            { kStateA, kEventStay,     kStateA },
+            { kStateA, kEventForward,  kStateB },
+            { kStateB, kEventSkip,     kStateB }
+        };
+        const nl::Fsm::Event outputs3[] = {
+            kEventStay,
+            kEventForward,
+            kEventSkip
+        };
+        nl::Fsm::Machine::Mask bitmap[8];
+        nl::Fsm::Event queue[2];
+
+        nl::Fsm::Machine machine3(transitions3, ARRAY_SIZE(transitions3), stateA);
+        nl::Fsm::Driver driver3(machine3, nl::Fsm::Delegate::kConstantAlways);
+        nl::Fsm::Driver * const stages3[] = { &driver3 };
+        nl::Fsm::Pipeline pipeline3(stages3, ARRAY_SIZE(stages3));
+
+        NL_TEST_ASSERT(inSuite, machine3.SetOutputs(outputs3, ARRAY_SIZE(outputs3)) == true);
+        NL_TEST_ASSERT(inSuite, machine3.SetDeferredEvents(bitmap, ARRAY_SIZE(bitmap)) == true);
+        NL_TEST_ASSERT(inSuite, machine3.SetDeferralQueue(queue, ARRAY_SIZE(queue)) == true);
+        NL_TEST_ASSERT(inSuite, machine3.SetEventDeferred(kStateA, kEventSkip) == true);
+        NL_TEST_ASSERT(inSuite, pipeline3.SetQueues(queues, 2, events, 6) == true);
+
+        NL_TEST_ASSERT(inSuite, pipeline3.Push(kEventSkip) == true);
+        NL_TEST_ASSERT(inSuite, pipeline3.RunStage(0, 8) == 1);
+        NL_TEST_ASSERT(inSuite, machine3.GetDeferredEventCount() == 1);
+
+        NL_TEST_ASSERT(inSuite, pipeline3.Push(kEventStay) == true);
+        NL_TEST_ASSERT(inSuite, pipeline3.RunStage(0, 8) == 1);
+        NL_TEST_ASSERT(inSuite, pipeline3.Push(kEventForward) == true);
+        NL_TEST_ASSERT(inSuite, pipeline3.RunStage(0, 8) == 0);
+
+        NL_TEST_ASSERT(inSuite, pipeline3.Pop(theOutput) == true);
+        NL_TEST_ASSERT(inSuite, theOutput == kEventStay);
+        NL_TEST_ASSERT(inSuite, pipeline3.RunStage(0, 8) == 1);
+        NL_TEST_ASSERT(inSuite, machine3.GetDeferredEventCount() == 0);
+
+        NL_TEST_ASSERT(inSuite, pipeline3.Pop(theOutput) == true);
+        NL_TEST_ASSERT(inSuite, theOutput == kEventForward);
+        NL_TEST_ASSERT(inSuite, pipeline3.Pop(theOutput) == true);
+        NL_TEST_ASSERT(inSuite, theOutput == kEventSkip);
+        NL_TEST_ASSERT(inSuite, pipeline3.Pop(theOutput) == false);
+    }
+}
+
+static void TestRunner(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(0);
+    const nl::Fsm::Event input[] = { 'a', 'b', 'x', 'a', 'b', 'a', 'b', 0xFF, 'a', 'b' };
+    nl::Fsm::Transition transitions[3 * 0xFF];
+    nl::Fsm::State table[3 * 0xFF];
+    nl::Fsm::Runner::Mask accepting[1] = { 1 << 2 };
+    nl::Fsm::Runner::Count counts[3] = { 0, 0, 0 };
+    size_t positions[2];
+    size_t scanned;
+    size_t theCount = 0;
+
+    // Recognize "ab" anywhere in a byte stream, with no transitions
+    // for 0xFF, which leaves the state unchanged.
+
+    for (size_t theState = 0; theState < 3; theState++) {
+        for (size_t theEvent = 0; theEvent < 0xFF; theEvent++) {
+            transitions[theCount].mStart = static_cast<nl::Fsm::State>(theState);
+            transitions[theCount].mEvent = static_cast<nl::Fsm::Event>(theEvent);
+            transitions[theCount].mEnd   = (theEvent == 'a') ? 1 : (((theEvent == 'b') && (theState == 1)) ? 2 : 0);
+            theCount++;
+        }
+    }
+
+    nl::Fsm::Machine machine(transitions, theCount, stateA);
+    nl::Fsm::Runner runner(machine);
+
+    // Test that the table is compiled with a row for each state and
+    // a column for each event with a transition.
+
+    NL_TEST_ASSERT(inSuite, runner.GetTableSize() == ARRAY_SIZE(table));
+    NL_TEST_ASSERT(inSuite, runner.GetStateCount() == 0);
+    NL_TEST_ASSERT(inSuite, runner.SetAccepting(accepting, ARRAY_SIZE(accepting)) == false);
+    NL_TEST_ASSERT(inSuite, runner.Compile(NULL, ARRAY_SIZE(table)) == false);
+    NL_TEST_ASSERT(inSuite, runner.Compile(table, ARRAY_SIZE(table) - 1) == false);
+    NL_TEST_ASSERT(inSuite, runner.Compile(table, ARRAY_SIZE(table)) == true);
+    NL_TEST_ASSERT(inSuite, runner.GetStateCount() == 3);
+    NL_TEST_ASSERT(inSuite, runner.GetAcceptingSize() == 1);
+
+    // Test that compiling reads the table directly, rather than
+    // through lookups counted in the machine's profile.
+
+    {
+        nl::Fsm::Machine::Count profile[ARRAY_SIZE(transitions)];
+        size_t theHits = 0;
+
+        memset(profile, 0, sizeof (profile));
+
+        NL_TEST_ASSERT(inSuite, machine.SetProfile(profile, ARRAY_SIZE(profile)) == true);
+        NL_TEST_ASSERT(inSuite, runner.Compile(table, ARRAY_SIZE(table)) == true);
+
+        for (size_t i = 0; i < theCount; i++)
+            theHits += profile[i];
+
+        NL_TEST_ASSERT(inSuite, theHits == 0);
+        NL_TEST_ASSERT(inSuite, table[(1 * 0xFF) + 'b'] == 2);
+        NL_TEST_ASSERT(inSuite, table[(2 * 0xFF) + 'b'] == 0);
+
+        machine.ClearProfile();
+    }
+
+    // Test that a run reaches the same state as the machine would,
+    // without changing the machine's state.
+
+    NL_TEST_ASSERT(inSuite, runner.Run(input, 2) == 2);
+    NL_TEST_ASSERT(inSuite, runner.Run(&input[2], 6) == 2);
+    NL_TEST_ASSERT(inSuite, runner.Run(&input[8], 1) == 1);
+    NL_TEST_ASSERT(inSuite, runner.GetPosition() == 9);
+    NL_TEST_ASSERT(inSuite, machine.GetCurrentState() == 0);
+
+    // Test that a scan reports each entry to the accepting states,
+    // stopping when out of room and resuming where it stopped, with
+    // positions in the stream.
+
+    NL_TEST_ASSERT(inSuite, runner.SetAccepting(NULL, ARRAY_SIZE(accepting)) == false);
+    NL_TEST_ASSERT(inSuite, runner.SetAccepting(accepting, 0) == false);
+    NL_TEST_ASSERT(inSuite, runner.SetAccepting(accepting, ARRAY_SIZE(accepting)) == true);
+
+    runner.Reset();
+
+    NL_TEST_ASSERT(inSuite, runner.GetPosition() == 0);
+    NL_TEST_ASSERT(inSuite, runner.Scan(input, ARRAY_SIZE(input), positions, ARRAY_SIZE(positions), scanned) == 2);
+    NL_TEST_ASSERT(inSuite, scanned == 6);
+    NL_TEST_ASSERT(inSuite, positions[0] == 1);
+    NL_TEST_ASSERT(inSuite, positions[1] == 4);
+
+    NL_TEST_ASSERT(inSuite, runner.Scan(&input[scanned], ARRAY_SIZE(input) - scanned, positions, ARRAY_SIZE(positions), scanned) == 2);
+    NL_TEST_ASSERT(inSuite, scanned == 4);
+    NL_TEST_ASSERT(inSuite, positions[0] == 6);
+    NL_TEST_ASSERT(inSuite, positions[1] == 9);
+    NL_TEST_ASSERT(inSuite, runner.GetPosition() == ARRAY_SIZE(input));
+
+    runner.ClearAccepting();
+
+    NL_TEST_ASSERT(inSuite, runner.Scan(input, ARRAY_SIZE(input), positions, ARRAY_SIZE(positions), scanned) == 0);
+    NL_TEST_ASSERT(inSuite, scanned == ARRAY_SIZE(input));
+
+    // Test that a tally counts the events after which each state was
+    // current.
+
+    runner.Reset();
+
+    NL_TEST_ASSERT(inSuite, runner.Tally(input, 4, counts, ARRAY_SIZE(counts) - 1) == false);
+    NL_TEST_ASSERT(inSuite, runner.Tally(input, 4, counts, ARRAY_SIZE(counts)) == true);
+    NL_TEST_ASSERT(inSuite, counts[0] == 1);
+    NL_TEST_ASSERT(inSuite, counts[1] == 2);
+    NL_TEST_ASSERT(inSuite, counts[2] == 1);
+
+#if defined(__linux__)
+    {
+        char thePath[] = "/tmp/nlfsm-test-XXXXXX";
+        nl::Fsm::MappedFile file;
+        int theDescriptor;
+
+        // Test that a mapped file may be run over in place, and that
+        // an empty file maps to no data.
+
+        theDescriptor = mkstemp(thePath);
+        NL_TEST_ASSERT(inSuite, theDescriptor >= 0);
+
+        NL_TEST_ASSERT(inSuite, file.Open(thePath) == true);
+        NL_TEST_ASSERT(inSuite, file.GetData() == NULL);
+        NL_TEST_ASSERT(inSuite, file.GetSize() == 0);
+
+        NL_TEST_ASSERT(inSuite, write(theDescriptor, input, sizeof (input)) == static_cast<ssize_t>(sizeof (input)));
+        close(theDescriptor);
+
+        NL_TEST_ASSERT(inSuite, file.Open(thePath) == true);
+        NL_TEST_ASSERT(inSuite, file.GetSize() == sizeof (input));
+
+        runner.Reset();
+
+        NL_TEST_ASSERT(inSuite, runner.Run(static_cast<const nl::Fsm::Event *>(file.GetData()), file.GetSize()) == 2);
+
+        file.Close();
+
+        NL_TEST_ASSERT(inSuite, file.GetData() == NULL);
+
+        unlink(thePath);
+
+        NL_TEST_ASSERT(inSuite, file.Open(thePath) == false);
+    }
+#endif // defined(__linux__)
+}
+
+static void TestAcceptedEvents(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateB, kEventForward,  kStateC },
+        { kStateB, kEventBackward, kStateA },
+        { kStateC, kEventError,    kStateA },
+        { kStateC, 40,             kStateA }
+    };
+    nl::Fsm::Machine::Mask bitmap[(kStateC + 1) * 2];
+    const nl::Fsm::Machine::Mask * row;
+    size_t words;
+    CountingDelegate delegate;
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Machine machine2(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Driver driver(machine2, &delegate);
+
+    // Test bitmap construction
+
+    NL_TEST_ASSERT(inSuite, machine2.GetAcceptedEventsSize() == ARRAY_SIZE(bitmap));
+    NL_TEST_ASSERT(inSuite, machine2.GetAcceptedEvents(stateA, words) == NULL);
+    NL_TEST_ASSERT(inSuite, words == 0);
+    NL_TEST_ASSERT(inSuite, machine2.SetAcceptedEvents(bitmap, ARRAY_SIZE(bitmap) - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine2.SetAcceptedEvents(bitmap, ARRAY_SIZE(bitmap)) == true);
+
+    row = machine2.GetAcceptedEvents(kStateC, words);
+
+    NL_TEST_ASSERT(inSuite, row == &bitmap[kStateC * 2]);
+    NL_TEST_ASSERT(inSuite, words == 2);
+    NL_TEST_ASSERT(inSuite, row[0] == (1U << kEventError));
+    NL_TEST_ASSERT(inSuite, row[1] == (1U << (40 - 32)));
+    NL_TEST_ASSERT(inSuite, machine2.GetAcceptedEvents(kStateD, words) == NULL);
+
+    // Test that the bitmap agrees with lookups, with and without it.
+
+    for (int state = kStateFirst; state <= kStateLast + 1; state++) {
+        for (int event = kEventFirst; event <= 64; event++) {
+            const bool accepted = (machine1.FindTransition(state, event) != NULL);
+
+            NL_TEST_ASSERT(inSuite, machine1.IsEventAccepted(state, event) == accepted);
+            NL_TEST_ASSERT(inSuite, machine2.IsEventAccepted(state, event) == accepted);
+            NL_TEST_ASSERT(inSuite, (machine2.FindTransition(state, event) != NULL) == accepted);
+        }
+    }
+
+    // Test that the driver rejects unaccepted events before any
+    // delegate call.
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == false);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 0);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventForward) == true);
+    NL_TEST_ASSERT(inSuite, delegate.mCalls == 1);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateB);
+
+    // Test that resetting the table discards the bitmap.
+
+    machine2.SetTransitions(transitions, ARRAY_SIZE(transitions), stateA);
+
+    NL_TEST_ASSERT(inSuite, machine2.GetAcceptedEvents(stateA, words) == NULL);
+
+    machine2.SetAcceptedEvents(bitmap, ARRAY_SIZE(bitmap));
+    machine2.ClearAcceptedEvents();
+
+    NL_TEST_ASSERT(inSuite, machine2.GetAcceptedEvents(stateA, words) == NULL);
+    NL_TEST_ASSERT(inSuite, machine2.IsEventAccepted(kStateC, 40) == true);
+}
+
+static void TestEventClasses(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    nl::Fsm::Event classes[kEventLast + 1];
+    nl::Fsm::Machine::Offset index[(kStateLast + 1) * (kEventLast + 1)];
+    nl::Fsm::State next;
+
+    // Skip and error always lead to the same states as one another,
+    // including through the first of the duplicate skip transitions.
+
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward,  kStateB },
+        { kStateA, kEventSkip,     kStateC },
+        { kStateA, kEventError,    kStateC },
+        { kStateA, kEventBackward, kStateA },
+        { kStateB, kEventForward,  kStateC },
+        { kStateB, kEventSkip,     kStateA },
+        { kStateB, kEventError,    kStateA },
+        { kStateB, kEventStay,     kStateB },
+        { kStateB, kEventSkip,     kStateC },
+        { kStateC, kEventForward,  kStateA },
+        { kStateC, kEventStay,     kStateA }
+    };
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Machine machine2(transitions, ARRAY_SIZE(transitions), stateA);
+
+    // Test class construction
+
+    NL_TEST_ASSERT(inSuite, machine2.GetEventClassMapSize() == ARRAY_SIZE(classes));
+    NL_TEST_ASSERT(inSuite, machine2.GetEventClassCount() == 0);
+    NL_TEST_ASSERT(inSuite, machine2.SetEventClasses(classes, ARRAY_SIZE(classes), index, machine2.GetDenseIndexSize() - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine2.SetEventClasses(classes, ARRAY_SIZE(classes), index, ARRAY_SIZE(index)) == true);
+
+    NL_TEST_ASSERT(inSuite, machine2.GetEventClassCount() == 4);
+    NL_TEST_ASSERT(inSuite, classes[kEventForward] == 0);
+    NL_TEST_ASSERT(inSuite, classes[kEventStay] == 1);
+    NL_TEST_ASSERT(inSuite, classes[kEventBackward] == 2);
+    NL_TEST_ASSERT(inSuite, classes[kEventSkip] == 3);
+    NL_TEST_ASSERT(inSuite, classes[kEventError] == 3);
+    NL_TEST_ASSERT(inSuite, machine2.GetNextStateIndexSize() == ((kStateC + 1) * 4));
+    NL_TEST_ASSERT(inSuite, machine2.GetNextStateIndexSize() < machine2.GetDenseIndexSize());
+
+    // Test that the next-state index agrees with transition lookups.
+
+    for (int state = kStateFirst; state <= kStateLast + 1; state++) {
+        for (int event = kEventFirst; event <= kEventLast + 1; event++) {
+            const nl::Fsm::Transition *transition = machine1.FindTransition(state, event);
+
+            NL_TEST_ASSERT(inSuite, machine1.FindNextState(state, event, next) == (transition != NULL));
+            NL_TEST_ASSERT(inSuite, machine2.FindNextState(state, event, next) == (transition != NULL));
+
+            if (transition != NULL)
+                NL_TEST_ASSERT(inSuite, next == transition->mEnd);
+
+            NL_TEST_ASSERT(inSuite, machine2.FindTransition(state, event) == transition);
+        }
+    }
+
+    // Test that a constant-result driver follows the classes.
+
+    nl::Fsm::Driver driver(machine2, nl::Fsm::Delegate::kConstantAlways);
+
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventError) == true);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateC);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventError) == false);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateC);
+    NL_TEST_ASSERT(inSuite, driver.HandleEvent(kEventStay) == true);
+    NL_TEST_ASSERT(inSuite, machine2.GetCurrentState() == kStateA);
+
+    // Test that a profile counts the arc actually taken rather than
+    // that of the first event of its class.
+
+    const nl::Fsm::Transition alike[] = {
+        { kStateA, kEventForward, kStateB },
+        { kStateA, kEventStay,    kStateB },
+        { kStateB, kEventForward, kStateA },
+        { kStateB, kEventStay,    kStateA }
+    };
+    nl::Fsm::Machine::Count counts[ARRAY_SIZE(alike)] = { 0 };
+
+    nl::Fsm::Machine machine3(alike, ARRAY_SIZE(alike), stateA);
+    nl::Fsm::Driver driver3(machine3, nl::Fsm::Delegate::kConstantAlways);
+
+    NL_TEST_ASSERT(inSuite, machine3.SetEventClasses(classes, ARRAY_SIZE(classes), index, ARRAY_SIZE(index)) == true);
+    NL_TEST_ASSERT(inSuite, classes[kEventForward] == classes[kEventStay]);
+    NL_TEST_ASSERT(inSuite, machine3.SetProfile(counts, ARRAY_SIZE(counts)) == true);
+
+    for (int i = 0; i < 10; i++) {
+        NL_TEST_ASSERT(inSuite, driver3.HandleEvent(kEventStay) == true);
+    }
+
+    NL_TEST_ASSERT(inSuite, machine3.GetCurrentState() == kStateA);
+    NL_TEST_ASSERT(inSuite, counts[0] == 0);
+    NL_TEST_ASSERT(inSuite, counts[1] == 5);
+    NL_TEST_ASSERT(inSuite, counts[2] == 0);
+    NL_TEST_ASSERT(inSuite, counts[3] == 5);
+
+    // Test that the standard table, in which only backward and skip
+    // behave alike, has one class fewer than events, and that
+    // resetting the table discards the classes.
+
+    GetTransitions(first, size);
+
+    machine2.SetTransitions(first, size, stateA);
+
+    NL_TEST_ASSERT(inSuite, machine2.GetEventClassCount() == 0);
+    NL_TEST_ASSERT(inSuite, machine2.SetEventClasses(classes, ARRAY_SIZE(classes), index, ARRAY_SIZE(index)) == true);
+    NL_TEST_ASSERT(inSuite, machine2.GetEventClassCount() == kEventLast);
+    NL_TEST_ASSERT(inSuite, classes[kEventSkip] == classes[kEventBackward]);
+    NL_TEST_ASSERT(inSuite, classes[kEventError] == (kEventLast - 1));
+
+    machine2.ClearEventClasses();
+
+    NL_TEST_ASSERT(inSuite, machine2.GetEventClassCount() == 0);
+    NL_TEST_ASSERT(inSuite, machine2.GetNextStateIndexSize() == 0);
+}
+
+static void TestMinimizer(nlTestSuite *inSuite, void *inContext)
+{
+    enum {
+        kStateE = kStateD + 1
+    };
+
+    // B and C are equivalent, as are D and E.
+
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward, kStateB },
+        { kStateA, kEventSkip,    kStateC },
+        { kStateB, kEventForward, kStateD },
+        { kStateC, kEventForward, kStateE },
+        { kStateC, kEventForward, kStateA },
+        { kStateD, kEventForward, kStateA },
+        { kStateE, kEventForward, kStateA }
+    };
+    nl::Fsm::Minimizer::Word workspace[256];
+    nl::Fsm::Minimizer::Word partition[kStateE + 1] = { 0, 0, 1, 0, 0 };
+    nl::Fsm::Transition minimized[ARRAY_SIZE(transitions)];
+    nl::Fsm::State map[kStateE + 1];
+    size_t count;
+
+    nl::Fsm::Minimizer minimizer1;
+    nl::Fsm::Minimizer minimizer2(workspace, ARRAY_SIZE(workspace));
+
+    // Test sizing and construction
+
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Minimizer::GetStateCount(transitions, ARRAY_SIZE(transitions), kStateA) == ARRAY_SIZE(map));
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Minimizer::GetWorkspaceSize(transitions, ARRAY_SIZE(transitions), kStateA) <= ARRAY_SIZE(workspace));
+
+    count = ARRAY_SIZE(minimized);
+
+    NL_TEST_ASSERT(inSuite, minimizer1.Minimize(transitions, ARRAY_SIZE(transitions), kStateA, NULL, minimized, count, map, ARRAY_SIZE(map)) == false);
+    NL_TEST_ASSERT(inSuite, minimizer2.Minimize(transitions, ARRAY_SIZE(transitions), kStateA, NULL, minimized, count, map, ARRAY_SIZE(map) - 1) == false);
+
+    minimizer1.SetWorkspace(workspace, 1);
+
+    NL_TEST_ASSERT(inSuite, minimizer1.Minimize(transitions, ARRAY_SIZE(transitions), kStateA, NULL, minimized, count, map, ARRAY_SIZE(map)) == false);
+
+    // Test that equivalent states merge into the lowest of them.
+
+    NL_TEST_ASSERT(inSuite, minimizer2.Minimize(transitions, ARRAY_SIZE(transitions), kStateA, NULL, minimized, count, map, ARRAY_SIZE(map)) == true);
+    NL_TEST_ASSERT(inSuite, count == 4);
+    NL_TEST_ASSERT(inSuite, map[kStateA] == kStateA);
+    NL_TEST_ASSERT(inSuite, map[kStateB] == kStateB);
+    NL_TEST_ASSERT(inSuite, map[kStateC] == kStateB);
+    NL_TEST_ASSERT(inSuite, map[kStateD] == kStateD);
+    NL_TEST_ASSERT(inSuite, map[kStateE] == kStateD);
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), kStateA);
+    nl::Fsm::Machine machine2(minimized, count, kStateA);
+
+    NL_TEST_ASSERT(inSuite, machine2.FindTransition(kStateA, kEventSkip)->mEnd == kStateB);
+    NL_TEST_ASSERT(inSuite, machine2.FindTransition(kStateB, kEventForward)->mEnd == kStateD);
+    NL_TEST_ASSERT(inSuite, machine2.FindTransition(kStateD, kEventForward)->mEnd == kStateA);
+
+    // Test that the minimized machine tracks the original, through
+    // the state map, for every state and event.
+
+    for (int state = kStateFirst; state <= kStateE; state++) {
+        for (int event = kEventFirst; event <= kEventLast; event++) {
+            const nl::Fsm::Transition *original  = machine1.FindTransition(state, event);
+            const nl::Fsm::Transition *reduced   = machine2.FindTransition(map[state], event);
+
+            NL_TEST_ASSERT(inSuite, (original == NULL) == (reduced == NULL));
+
+            if ((original != NULL) && (reduced != NULL))
+                NL_TEST_ASSERT(inSuite, map[original->mEnd] == reduced->mEnd);
+        }
+    }
+
+    // Test that an initial partition keeps states apart.
+
+    count = ARRAY_SIZE(minimized);
+
+    NL_TEST_ASSERT(inSuite, minimizer2.Minimize(transitions, ARRAY_SIZE(transitions), kStateA, partition, minimized, count, map, ARRAY_SIZE(map)) == true);
+    NL_TEST_ASSERT(inSuite, count == 5);
+    NL_TEST_ASSERT(inSuite, map[kStateB] == kStateB);
+    NL_TEST_ASSERT(inSuite, map[kStateC] == kStateC);
+    NL_TEST_ASSERT(inSuite, map[kStateE] == kStateD);
+
+    // Test that the standard table, whose states A, B and C are
+    // rotations of one another, reduces to two states and that
+    // minimizing a minimal table leaves it unchanged.
+
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    nl::Fsm::Transition again[ARRAY_SIZE(minimized)];
+    size_t reduced;
+
+    GetTransitions(first, size);
+
+    count = 1;
+
+    NL_TEST_ASSERT(inSuite, minimizer2.Minimize(first, size, kStateA, NULL, minimized, count, map, ARRAY_SIZE(map)) == false);
+
+    count = ARRAY_SIZE(minimized);
+
+    NL_TEST_ASSERT(inSuite, minimizer2.Minimize(first, size, kStateA, NULL, minimized, count, map, ARRAY_SIZE(map)) == true);
+    NL_TEST_ASSERT(inSuite, count == (kEventLast + 1));
+    NL_TEST_ASSERT(inSuite, map[kStateB] == kStateA);
+    NL_TEST_ASSERT(inSuite, map[kStateC] == kStateA);
+    NL_TEST_ASSERT(inSuite, map[kStateD] == kStateD);
+
+    reduced = ARRAY_SIZE(again);
+
+    NL_TEST_ASSERT(inSuite, minimizer2.Minimize(minimized, count, kStateA, NULL, again, reduced, map, ARRAY_SIZE(map)) == true);
+    NL_TEST_ASSERT(inSuite, reduced == count);
+
+    for (size_t i = 0; i < reduced; i++)
+        NL_TEST_ASSERT(inSuite, again[i] == minimized[i]);
+}
+
+static void TestTransitionCache(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+    const nl::Fsm::State stateA(kStateA);
+    nl::Fsm::Machine::SortedEntry cache[3];
+    nl::Fsm::Machine::SortedEntry index[16];
+    nl::Fsm::Machine::Count counts[16] = { 0 };
+    unsigned int random = 1;
+
+    GetTransitions(first, size);
+
+    nl::Fsm::Machine machine1(first, size, stateA);
+    nl::Fsm::Machine machine2(first, size, stateA);
+
+    // Test cache construction
+
+    NL_TEST_ASSERT(inSuite, machine1.GetTransitionCacheSize() == 0);
+    NL_TEST_ASSERT(inSuite, machine1.SetTransitionCache(NULL, 1) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetTransitionCache(cache, 0) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetTransitionCache(cache, 1) == true);
+    NL_TEST_ASSERT(inSuite, machine1.GetTransitionCacheSize() == 1);
+
+    // Test that a repeated lookup is served from the cache, counted
+    // in the profile and unaffected by the lookup strategy.
+
+    NL_TEST_ASSERT(inSuite, machine1.SetProfile(counts, ARRAY_SIZE(counts)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventStay) == &first[0]);
+    NL_TEST_ASSERT(inSuite, cache[0].mOffset == 0);
+    NL_TEST_ASSERT(inSuite, cache[0].mKey == nl::Fsm::Transition::MakeKey(kStateA, kEventStay));
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventStay) == &first[0]);
+    NL_TEST_ASSERT(inSuite, counts[0] == 2);
+
+    NL_TEST_ASSERT(inSuite, machine1.SetSortedLookup(index, ARRAY_SIZE(index)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.GetTransitionCacheSize() == 1);
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventStay) == &first[0]);
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateD, kEventStay) == NULL);
+    NL_TEST_ASSERT(inSuite, cache[0].mKey == nl::Fsm::Transition::MakeKey(kStateD, kEventStay));
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateD, kEventStay) == NULL);
+
+    machine1.ClearProfile();
+
+    // Test that cached lookups agree with uncached ones for a
+    // pseudo-random mix of bursts and changes of state and event, for
+    // both a single and several entries.
+
+    for (size_t entries = 1; entries <= ARRAY_SIZE(cache); entries += 2) {
+        NL_TEST_ASSERT(inSuite, machine1.SetTransitionCache(cache, entries) == true);
+
+        for (int i = 0; i < 1000; i++) {
+            const int state = rand_r(&random) % (kStateLast + 1);
+            const int event = rand_r(&random) % (kEventLast + 1);
+            const int burst = 1 + (rand_r(&random) % 4);
+
+            for (int j = 0; j < burst; j++)
+                NL_TEST_ASSERT(inSuite, machine1.FindTransition(state, event) == machine2.FindTransition(state, event));
+        }
+    }
+
+    // Test that setting the transitions stops caching.
+
+    machine1.SetTransitions(first, size, stateA);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetTransitionCacheSize() == 0);
+
+    machine1.ClearTransitionCache();
+
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventStay) == &first[0]);
+}
+
+class RecordingObserver : public nl::Fsm::Validator::Observer
+{
+public:
+    RecordingObserver(void) :
+        mDuplicates(0),
+        mUnreachable(0),
+        mSinks(0)
+    {
+        return;
+    }
+
+    virtual void DuplicateTransition(const nl::Fsm::Transition &inFirst,
+                                     const nl::Fsm::Transition &inDuplicate)
+    {
+        mFirst     = inFirst;
+        mDuplicate = inDuplicate;
+        mDuplicates++;
+    }
+
+    virtual void UnreachableState(const nl::Fsm::State &inState)
+    {
+        mUnreachableStates[mUnreachable++ % ARRAY_SIZE(mUnreachableStates)] = inState;
+    }
+
+    virtual void SinkState(const nl::Fsm::State &inState)
+    {
+        mSink = inState;
+        mSinks++;
+    }
+
+    nl::Fsm::Transition mFirst;
+    nl::Fsm::Transition mDuplicate;
+    nl::Fsm::State      mUnreachableStates[4];
+    nl::Fsm::State      mSink;
+    size_t              mDuplicates;
+    size_t              mUnreachable;
+    size_t              mSinks;
+};
+
+static void TestValidator(nlTestSuite *inSuite, void *inContext)
+{
+    enum {
+        kStateE = kStateD + 1
+    };
+
+    // The second A, Forward transition is shadowed by the first, which
+    // leaves C reachable only through it; E is never reached; and D
+    // only ever stays.
+
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward, kStateB },
+        { kStateA, kEventForward, kStateC },
+        { kStateA, kEventSkip,    kStateA },
+        { kStateB, kEventForward, kStateD },
+        { kStateB, kEventStay,    kStateB },
+        { kStateC, kEventForward, kStateA },
+        { kStateD, kEventStay,    kStateD },
+        { kStateE, kEventForward, kStateA }
+    };
+    const nl::Fsm::Event outputs[] = {
+        kEventStay,
+        kEventSkip,
+        kEventError,
+        kEventBackward,
+        kEventForward,
+        kEventStay,
+        kEventError,
+        kEventSkip
+    };
+    nl::Fsm::Validator::Word workspace[64];
+    nl::Fsm::Transition pruned[ARRAY_SIZE(transitions)];
+    nl::Fsm::Event prunedOutputs[ARRAY_SIZE(transitions)];
+    size_t offsets[ARRAY_SIZE(transitions)];
+    nl::Fsm::Validator::Report report;
+    RecordingObserver observer;
+    size_t count;
+
+    nl::Fsm::Validator validator1;
+    nl::Fsm::Validator validator2(workspace, ARRAY_SIZE(workspace));
+
+    // Test sizing and construction
+
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Validator::GetStateCount(transitions, ARRAY_SIZE(transitions), kStateA) == (kStateE + 1));
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Validator::GetWorkspaceSize(transitions, ARRAY_SIZE(transitions), kStateA) <= ARRAY_SIZE(workspace));
+
+    NL_TEST_ASSERT(inSuite, validator1.Validate(transitions, ARRAY_SIZE(transitions), kStateA, NULL, report) == false);
+
+    validator1.SetWorkspace(workspace, 1);
+
+    NL_TEST_ASSERT(inSuite, validator1.Validate(transitions, ARRAY_SIZE(transitions), kStateA, NULL, report) == false);
+
+    // Test that each problem is reported.
+
+    NL_TEST_ASSERT(inSuite, validator2.Validate(transitions, ARRAY_SIZE(transitions), kStateA, &observer, report) == true);
+    NL_TEST_ASSERT(inSuite, report.mDuplicates == 1);
+    NL_TEST_ASSERT(inSuite, report.mUnreachable == 2);
+    NL_TEST_ASSERT(inSuite, report.mSinks == 1);
+    NL_TEST_ASSERT(inSuite, report.mDead == 3);
+
+    NL_TEST_ASSERT(inSuite, observer.mDuplicates == 1);
+    NL_TEST_ASSERT(inSuite, observer.mFirst == transitions[0]);
+    NL_TEST_ASSERT(inSuite, observer.mDuplicate == transitions[1]);
+    NL_TEST_ASSERT(inSuite, observer.mUnreachable == 2);
+    NL_TEST_ASSERT(inSuite, observer.mUnreachableStates[0] == kStateC);
+    NL_TEST_ASSERT(inSuite, observer.mUnreachableStates[1] == kStateE);
+    NL_TEST_ASSERT(inSuite, observer.mSinks == 1);
+    NL_TEST_ASSERT(inSuite, observer.mSink == kStateD);
+
+    // Test that pruning removes only the dead transitions, in order,
+    // reports where each kept transition came from, and that the
+    // pruned machine, with its outputs compacted to match, behaves
+    // identically from the initial state.
+
+    count = report.mDead;
+
+    NL_TEST_ASSERT(inSuite, validator2.Prune(transitions, ARRAY_SIZE(transitions), kStateA, pruned, NULL, count) == false);
+
+    count = ARRAY_SIZE(pruned);
+
+    NL_TEST_ASSERT(inSuite, validator2.Prune(transitions, ARRAY_SIZE(transitions), kStateA, pruned, offsets, count) == true);
+    NL_TEST_ASSERT(inSuite, count == (ARRAY_SIZE(transitions) - 3));
+    NL_TEST_ASSERT(inSuite, pruned[0] == transitions[0]);
+    NL_TEST_ASSERT(inSuite, pruned[1] == transitions[2]);
+    NL_TEST_ASSERT(inSuite, pruned[4] == transitions[6]);
+    NL_TEST_ASSERT(inSuite, offsets[0] == 0);
+    NL_TEST_ASSERT(inSuite, offsets[1] == 2);
+    NL_TEST_ASSERT(inSuite, offsets[4] == 6);
+
+    for (size_t i = 0; i < count; i++) {
+        NL_TEST_ASSERT(inSuite, pruned[i] == transitions[offsets[i]]);
+
+        prunedOutputs[i] = outputs[offsets[i]];
+    }
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), kStateA);
+    nl::Fsm::Machine machine2(pruned, count, kStateA);
+
+    NL_TEST_ASSERT(inSuite, machine1.SetOutputs(outputs, ARRAY_SIZE(outputs)) == true);
+    NL_TEST_ASSERT(inSuite, machine2.SetOutputs(prunedOutputs, count) == true);
+
+    for (int state = kStateA; state <= kStateD; state++) {
+        if (state == kStateC)
+            continue;
+
+        for (int event = kEventFirst; event <= kEventLast; event++) {
+            const nl::Fsm::Transition *original = machine1.FindTransition(state, event);
+            const nl::Fsm::Transition *smaller  = machine2.FindTransition(state, event);
+
+            NL_TEST_ASSERT(inSuite, (original == NULL) == (smaller == NULL));
+
+            if ((original != NULL) && (smaller != NULL)) {
+                nl::Fsm::Event originalOutput;
+                nl::Fsm::Event smallerOutput;
+
+                NL_TEST_ASSERT(inSuite, *original == *smaller);
+                NL_TEST_ASSERT(inSuite, machine1.GetOutput(*original, originalOutput) == true);
+                NL_TEST_ASSERT(inSuite, machine2.GetOutput(*smaller, smallerOutput) == true);
+                NL_TEST_ASSERT(inSuite, originalOutput == smallerOutput);
+            }
+        }
+    }
+
+    // Test that a pruned table validates cleanly, apart from its
+    // sink, and prunes in place to itself.
+
+    NL_TEST_ASSERT(inSuite, validator2.Validate(pruned, count, kStateA, NULL, report) == true);
+    NL_TEST_ASSERT(inSuite, report.mDuplicates == 0);
+    NL_TEST_ASSERT(inSuite, report.mUnreachable == 0);
+    NL_TEST_ASSERT(inSuite, report.mSinks == 1);
+    NL_TEST_ASSERT(inSuite, report.mDead == 0);
+
+    NL_TEST_ASSERT(inSuite, validator2.Prune(pruned, count, kStateA, pruned, offsets, count) == true);
+    NL_TEST_ASSERT(inSuite, offsets[count - 1] == (count - 1));
+    NL_TEST_ASSERT(inSuite, count == (ARRAY_SIZE(transitions) - 3));
+
+    // Test that the standard table has only its error state as a sink.
+
+    const nl::Fsm::Transition * first = 0;
+    size_t size = 0;
+
+    GetTransitions(first, size);
+
+    NL_TEST_ASSERT(inSuite, validator2.Validate(first, size, kStateA, NULL, report) == true);
+    NL_TEST_ASSERT(inSuite, report.mDuplicates == 0);
+    NL_TEST_ASSERT(inSuite, report.mUnreachable == 0);
+    NL_TEST_ASSERT(inSuite, report.mSinks == 1);
+    NL_TEST_ASSERT(inSuite, report.mDead == 0);
+}
+
+static void TestReorderer(nlTestSuite *inSuite, void *inContext)
+{
+    const nl::Fsm::State stateA(kStateA);
+
+    // The second A, Stay transition is shadowed by the first.
+
+    const nl::Fsm::Transition transitions[] = {
+        { kStateA, kEventForward, kStateB },
+        { kStateA, kEventStay,    kStateA },
+        { kStateB, kEventStay,    kStateB },
+        { kStateA, kEventStay,    kStateC },
+        { kStateB, kEventForward, kStateA }
+    };
+    nl::Fsm::Reorderer::Word workspace[2 * ARRAY_SIZE(transitions)];
+    nl::Fsm::Machine::Count counts[ARRAY_SIZE(transitions)] = { 0 };
+    nl::Fsm::Machine::Count reorderedCounts[ARRAY_SIZE(transitions)];
+    nl::Fsm::Transition reordered[ARRAY_SIZE(transitions)];
+    nl::Fsm::Transition installed[ARRAY_SIZE(transitions)];
+    nl::Fsm::Event classes[kEventLast + 1];
+    nl::Fsm::Machine::Offset index[(kStateB + 1) * (kEventLast + 1)];
+    nl::Fsm::State next;
+    char buffer[64];
+    size_t count;
+
+    nl::Fsm::Machine machine1(transitions, ARRAY_SIZE(transitions), stateA);
+    nl::Fsm::Reorderer reorderer1;
+    nl::Fsm::Reorderer reorderer2(workspace, ARRAY_SIZE(workspace));
+
+    // Test profiling
+
+    NL_TEST_ASSERT(inSuite, machine1.GetProfile() == NULL);
+    NL_TEST_ASSERT(inSuite, machine1.SetProfile(counts, ARRAY_SIZE(counts) - 1) == false);
+    NL_TEST_ASSERT(inSuite, machine1.SetProfile(counts, ARRAY_SIZE(counts)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.GetProfile() == counts);
+
+    for (int i = 0; i < 5; i++)
+        NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventStay) == &transitions[1]);
+
+    for (int i = 0; i < 3; i++)
+        NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateB, kEventForward) == &transitions[4]);
+
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventForward) == &transitions[0]);
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateC, kEventForward) == NULL);
+
+    NL_TEST_ASSERT(inSuite, counts[0] == 1);
+    NL_TEST_ASSERT(inSuite, counts[1] == 5);
+    NL_TEST_ASSERT(inSuite, counts[2] == 0);
+    NL_TEST_ASSERT(inSuite, counts[3] == 0);
+    NL_TEST_ASSERT(inSuite, counts[4] == 3);
+
+    // Test that next states found through event classes are counted.
+
+    NL_TEST_ASSERT(inSuite, machine1.SetEventClasses(classes, ARRAY_SIZE(classes), index, ARRAY_SIZE(index)) == true);
+    NL_TEST_ASSERT(inSuite, machine1.FindNextState(kStateB, kEventForward, next) == true);
+    NL_TEST_ASSERT(inSuite, next == kStateA);
+    NL_TEST_ASSERT(inSuite, counts[4] == 4);
+
+    machine1.ClearEventClasses();
+
+    // Test that reordering puts the hottest transitions first and
+    // keeps duplicates behind the transition shadowing them.
+
+    NL_TEST_ASSERT(inSuite, reorderer1.Reorder(transitions, ARRAY_SIZE(transitions), counts, reordered, NULL) == false);
+    NL_TEST_ASSERT(inSuite, reorderer2.Reorder(transitions, ARRAY_SIZE(transitions), counts, reordered, reorderedCounts) == true);
+
+    NL_TEST_ASSERT(inSuite, reordered[0] == transitions[1]);
+    NL_TEST_ASSERT(inSuite, reordered[1] == transitions[3]);
+    NL_TEST_ASSERT(inSuite, reordered[2] == transitions[4]);
+    NL_TEST_ASSERT(inSuite, reordered[3] == transitions[0]);
+    NL_TEST_ASSERT(inSuite, reordered[4] == transitions[2]);
+    NL_TEST_ASSERT(inSuite, reorderedCounts[0] == 5);
+    NL_TEST_ASSERT(inSuite, reorderedCounts[1] == 0);
+    NL_TEST_ASSERT(inSuite, reorderedCounts[2] == 4);
+
+    nl::Fsm::Machine machine2(reordered, ARRAY_SIZE(reordered), stateA);
+
+    machine1.ClearProfile();
+
+    for (int state = kStateFirst; state <= kStateLast; state++) {
+        for (int event = kEventFirst; event <= kEventLast; event++) {
+            const nl::Fsm::Transition *original  = machine1.FindTransition(state, event);
+            const nl::Fsm::Transition *hottest  = machine2.FindTransition(state, event);
+
+            NL_TEST_ASSERT(inSuite, (original == NULL) == (hottest == NULL));
+
+            if ((original != NULL) && (hottest != NULL))
+                NL_TEST_ASSERT(inSuite, *original == *hottest);
+        }
+    }
+
+    // Test live reordering, which keeps the current state and the
+    // profile, reordered alongside.
+
+    NL_TEST_ASSERT(inSuite, machine1.SetProfile(counts, ARRAY_SIZE(counts)) == true);
+
+    machine1.SetCurrentState(kStateB);
+
+    NL_TEST_ASSERT(inSuite, reorderer2.Reorder(machine2, installed, ARRAY_SIZE(installed)) == false);
+    NL_TEST_ASSERT(inSuite, reorderer2.Reorder(machine1, installed, ARRAY_SIZE(installed) - 1) == false);
+
+    // Test that a machine with anything indexed by transition offset
+    // or attached to a state is not reordered, rather than losing it.
+
+    {
+        const nl::Fsm::Event outputs[ARRAY_SIZE(installed)] = { kEventStay };
+        nl::Fsm::Event queue[1];
+
+        NL_TEST_ASSERT(inSuite, machine1.SetOutputs(outputs, ARRAY_SIZE(outputs)) == true);
+        NL_TEST_ASSERT(inSuite, reorderer2.Reorder(machine1, installed, ARRAY_SIZE(installed)) == false);
+        NL_TEST_ASSERT(inSuite, machine1.HasOutputs() == true);
+
+        machine1.ClearOutputs();
+
+        NL_TEST_ASSERT(inSuite, machine1.SetDeferralQueue(queue, ARRAY_SIZE(queue)) == true);
+        NL_TEST_ASSERT(inSuite, reorderer2.Reorder(machine1, installed, ARRAY_SIZE(installed)) == false);
+
+        machine1.ClearDeferralQueue();
+    }
+
+    NL_TEST_ASSERT(inSuite, reorderer2.Reorder(machine1, installed, ARRAY_SIZE(installed)) == true);
+
+    NL_TEST_ASSERT(inSuite, machine1.GetTransitions(count) == installed);
+    NL_TEST_ASSERT(inSuite, count == ARRAY_SIZE(installed));
+    NL_TEST_ASSERT(inSuite, machine1.GetCurrentState() == kStateB);
+    NL_TEST_ASSERT(inSuite, machine1.GetProfile() == counts);
+
+    for (size_t i = 0; i < count; i++) {
+        NL_TEST_ASSERT(inSuite, installed[i] == reordered[i]);
+        NL_TEST_ASSERT(inSuite, counts[i] == reorderedCounts[i]);
+    }
+
+    NL_TEST_ASSERT(inSuite, machine1.FindTransition(kStateA, kEventStay) == &installed[0]);
+    NL_TEST_ASSERT(inSuite, counts[0] == 6);
+
+    // Test formatting, sized with an empty buffer and truncated to a
+    // short one.
+
+    count = nl::Fsm::Reorderer::Format(installed, 1, counts, NULL, 0);
+
+    NL_TEST_ASSERT(inSuite, count == strlen("    { 0, 1, 0 }, /* 6 */\n"));
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Reorderer::Format(installed, 1, counts, buffer, sizeof (buffer)) == count);
+    NL_TEST_ASSERT(inSuite, strcmp(buffer, "    { 0, 1, 0 }, /* 6 */\n") == 0);
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Reorderer::Format(installed, 2, NULL, buffer, sizeof (buffer)) == (2 * strlen("    { 0, 1, 0 },\n")));
+    NL_TEST_ASSERT(inSuite, strcmp(buffer, "    { 0, 1, 0 },\n    { 0, 1, 2 },\n") == 0);
+    NL_TEST_ASSERT(inSuite, nl::Fsm::Reorderer::Format(installed, 2, NULL, buffer, 5) == (2 * strlen("    { 0, 1, 0 },\n")));
+    NL_TEST_ASSERT(inSuite, strcmp(buffer, "    ") == 0);
+}
+
 static const nlTest sTests[] = {
     NL_TEST_DEF("event",      TestEvent),
     NL_TEST_DEF("state",      TestState),
     NL_TEST_DEF("transition", TestTransition),
     NL_TEST_DEF("machine",    TestMachine),
+    NL_TEST_DEF("lookups",    TestLookups),
+    NL_TEST_DEF("wide",       TestWideMachine),
+    NL_TEST_DEF("hash sizes", TestHashSizes),
+    NL_TEST_DEF("accepted",   TestAcceptedEvents),
+    NL_TEST_DEF("classes",    TestEventClasses),
+    NL_TEST_DEF("cache",      TestTransitionCache),
+    NL_TEST_DEF("minimizer",  TestMinimizer),
+    NL_TEST_DEF("validator",  TestValidator),
+    NL_TEST_DEF("reorderer",  TestReorderer),
     NL_TEST_DEF("delegates",  TestDelegates),
+    NL_TEST_DEF("random",     TestRandomDelegate),
     NL_TEST_DEF("driver",     TestDriver),
+    NL_TEST_DEF("constant",   TestConstantDriver),
+    NL_TEST_DEF("internal",   TestInternalTransitions),
+    NL_TEST_DEF("actions",    TestActions),
+    NL_TEST_DEF("handlers",   TestStateHandlers),
+    NL_TEST_DEF("guards",     TestGuards),
+    NL_TEST_DEF("hierarchy",  TestHierarchy),
+    NL_TEST_DEF("composite",  TestComposite),
+    NL_TEST_DEF("expander",   TestExpander),
+    NL_TEST_DEF("deferral",   TestDeferral),
+    NL_TEST_DEF("timers",     TestTimerWheel),
+    NL_TEST_DEF("loop",       TestEventLoop),
+    NL_TEST_DEF("async",      TestAsyncDriver),
+    NL_TEST_DEF("pipeline",   TestPipeline),
+    NL_TEST_DEF("runner",     TestRunner),
     NL_TEST_SENTINEL()
 };
 